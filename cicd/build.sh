@@ -21,6 +21,7 @@ build_type=RelWithDebInfo
 #local_clang=n
 verbose=n
 build_tests=n
+db_profile=n
 
 usage() {
   echo "Compile contracts."
@@ -35,6 +36,7 @@ usage() {
   echo "                         default: $build_type"
   #echo "  --local-clang        : build and use a partucular version of Clang toolchain locally"
   echo "  --build-tests        : build tests"
+  echo "  --db-profile         : build profiled contracts for bench_test --run_test=db_profile"
   echo "  --verbose            : verbose build"
   echo
   echo "  -h, --help           : print this message"
@@ -43,6 +45,7 @@ usage() {
 OPTS="$( getopt -o "h" -l "\
 build-type:,\
 build-tests,\
+db-profile,\
 verbose,\
 help" -n "$PROGNAME" -- "$@" )"
 eval set -- "$OPTS"
@@ -51,6 +54,7 @@ while true; do
   (--build-type)   build_type="$2" ; shift 2 ; readonly build_type ;;
   #(--local-clang)  local_clang=y   ; shift   ; readonly local_clang ;;
   (--build-tests)  build_tests=y   ; shift   ; readonly build_tests ;;
+  (--db-profile)   db_profile=y    ; shift   ; readonly db_profile ;;
   (--verbose)      verbose=y       ; shift   ; readonly verbose ;;
   (-h|--help)      usage ; exit 0 ;;
   (--)             shift ; break ;;
@@ -66,6 +70,7 @@ log
 log "  build type  = $build_type"
 log "  node root   = $node_root"
 log "  build tests = $build_tests"
+log "  db profile  = $db_profile"
 log "  # of CPUs   = $ncores"
 #log "  cmake executable  = ${CMAKE_CMD:-"<not found>"}"
 
@@ -78,6 +83,7 @@ cmake_flags=(
 )
 [[ -z "$boost_root" ]]    || cmake_flags+=(-D BOOST_ROOT="$boost_root")
 [[ "$build_tests" == n ]] || cmake_flags+=(-D BUILD_TESTS=on)
+[[ "$db_profile" == n ]]  || cmake_flags+=(-D DB_PROFILE=on)
 
 make_flags=(-j "$ncores")
 [[ "$verbose" == n ]] || make_flags+=(VERBOSE=1)
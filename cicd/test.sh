@@ -0,0 +1,27 @@
+#!/bin/bash
+
+set -eu
+set -o pipefail
+
+. "${BASH_SOURCE[0]%/*}/utils.sh"
+
+readonly tests_dir="$PROGPATH"/../build/tests
+readonly out_dir="$(mktemp -d)"
+
+# smallest state sizes, only checks that benchmark fixtures set up and every measured action succeeds
+bench_args=(
+  --players=1,10 --games=1,2 --tokens=1,2 --samples=2 --out="$out_dir"/bench.json
+  --ram-players=10 --ram-games=2 --ram-tokens=2 --ram-out="$out_dir"/ram.json
+  --load-block-actions=100 --load-steps=1000 --load-players=10 --load-games=2 --load-tokens=2
+)
+
+log "Unit tests"
+"$tests_dir"/unit_test "$@"
+
+# db_profile runs separately on a profiled build, see `run profile`
+for bench in bench_test bench_test_validating; do
+  log "Benchmarks smoke run: $bench"
+  "$tests_dir"/$bench --run_test=bench,ram,load -- "${bench_args[@]}"
+done
+
+rm -rf "$out_dir"
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstdint>
+
+// Accounting rules of the casino contract: game developer margins, casino withdraw limits,
+// claim periods and bonus limits. Shared by the contract and off-chain services, so it has no eosio
+// dependencies, doesn't allocate and every function is constexpr. Amounts are raw asset amounts of
+// a single token; violations are reported as `status`, the contract turns them into eosio::check
+// failures with the same messages as before.
+namespace casino {
+namespace accounting {
+
+constexpr int64_t max_amount = (1LL << 62) - 1; // of eosio::asset
+constexpr int64_t percent_100 = 100;
+
+constexpr int64_t seconds_per_day = 24 * 3600;
+constexpr int64_t useconds_per_day = seconds_per_day * 1000'000ll;
+constexpr int64_t useconds_per_week = 7 * useconds_per_day;
+constexpr int64_t useconds_per_month = 30 * useconds_per_day;
+
+enum class status : uint8_t {
+    ok,
+    multiplication_overflow,
+    multiplication_underflow,
+    addition_overflow,
+    addition_underflow,
+    subtraction_overflow,
+    subtraction_underflow,
+    quantity_exceeds_max_transfer,
+    profits_exceed_balance,
+    claimed_within_week,
+    claimed_within_month,
+    lock_exceeds_bonus_balance,
+    subtract_exceeds_bonus_balance,
+    withdraw_exceeds_total_bonus,
+    convert_exceeds_total_allocated,
+};
+
+constexpr const char* message(status s) {
+    switch (s) {
+        case status::ok: return "";
+        case status::multiplication_overflow: return "multiplication overflow";
+        case status::multiplication_underflow: return "multiplication underflow";
+        case status::addition_overflow: return "addition overflow";
+        case status::addition_underflow: return "addition underflow";
+        case status::subtraction_overflow: return "subtraction overflow";
+        case status::subtraction_underflow: return "subtraction underflow";
+        case status::quantity_exceeds_max_transfer: return "quantity exceededs max transfer amount";
+        case status::profits_exceed_balance: return "developer profits exceed account balance";
+        case status::claimed_within_week: return "already claimed within past week";
+        case status::claimed_within_month: return "already claimed within past month";
+        case status::lock_exceeds_bonus_balance: return "lock amount cannot exceed player's bonus balance";
+        case status::subtract_exceeds_bonus_balance: return "subtract amount cannot exceed player's bonus balance";
+        case status::withdraw_exceeds_total_bonus: return "withdraw quantity cannot exceed total bonus";
+        case status::convert_exceeds_total_allocated: return "convert quantity cannot exceed total allocated";
+    }
+    return "unknown accounting status";
+}
+
+struct amount_result {
+    int64_t amount = 0;
+    status error = status::ok;
+
+    constexpr bool ok() const { return error == status::ok; }
+};
+
+// asset arithmetic with eosio::asset range checks
+constexpr amount_result add(int64_t a, int64_t b) {
+    const int64_t sum = a + b; // operands are within +-2^62
+    if (sum < -max_amount) return { sum, status::addition_underflow };
+    if (sum > max_amount) return { sum, status::addition_overflow };
+    return { sum };
+}
+
+constexpr amount_result sub(int64_t a, int64_t b) {
+    const int64_t difference = a - b;
+    if (difference < -max_amount) return { difference, status::subtraction_underflow };
+    if (difference > max_amount) return { difference, status::subtraction_overflow };
+    return { difference };
+}
+
+// winnings accrued for players but not sent yet aren't the casino's
+constexpr amount_result available_balance(int64_t balance, int64_t pending_payouts) {
+    return sub(balance, pending_payouts);
+}
+
+// game developer's part of `amount` for a margin in percents: quantity * margin / percent_100
+// in on_transfer and on_loss
+constexpr amount_result profit_share(int64_t amount, uint32_t margin) {
+    const __int128 product = static_cast<__int128>(amount) * margin;
+    if (product > max_amount) return { 0, status::multiplication_overflow };
+    if (product < -max_amount) return { 0, status::multiplication_underflow };
+    return { static_cast<int64_t>(product) / percent_100 };
+}
+
+// per token state the withdraw limit depends on
+struct withdraw_state {
+    int64_t balance = 0; // casino's token balance
+    int64_t allocated_bonus = 0; // total_allocated_bonus
+    int64_t profits = 0; // game_profits_sum
+    int64_t active_sessions = 0; // game_active_sessions_sum
+};
+
+struct withdraw_limit {
+    int64_t max_transfer = 0;
+    // balance doesn't cover active sessions and profits, then only a tenth of it once a week
+    bool weekly = false;
+    status error = status::ok;
+
+    constexpr bool ok() const { return error == status::ok; }
+};
+
+constexpr withdraw_limit max_withdraw(const withdraw_state& s) {
+    const auto account_balance = sub(s.balance, s.allocated_bonus);
+    if (!account_balance.ok()) return { 0, false, account_balance.error };
+    // in case game developers screwed it up
+    const int64_t profits = s.profits > 0 ? s.profits : 0;
+    const auto reserved = add(s.active_sessions, profits);
+    if (!reserved.ok()) return { 0, false, reserved.error };
+
+    if (account_balance.amount > reserved.amount) {
+        const auto without_active = sub(account_balance.amount, s.active_sessions);
+        if (!without_active.ok()) return { 0, false, without_active.error };
+        const auto max_transfer = sub(without_active.amount, profits);
+        if (!max_transfer.ok()) return { 0, false, max_transfer.error };
+        return { max_transfer.amount };
+    }
+    if (account_balance.amount <= profits) {
+        return { 0, true, status::profits_exceed_balance };
+    }
+    const auto above_profits = sub(account_balance.amount, profits);
+    if (!above_profits.ok()) return { 0, true, above_profits.error };
+    const int64_t tenth = account_balance.amount / 10;
+    return { tenth < above_profits.amount ? tenth : above_profits.amount, true };
+}
+
+// the rest of casino::withdraw checks in their order, times are microseconds since epoch;
+// `last_withdraw` matters for weekly limits only
+constexpr status check_withdraw(const withdraw_limit& limit, int64_t quantity, int64_t now, int64_t last_withdraw) {
+    if (!limit.ok()) return limit.error;
+    if (quantity > limit.max_transfer) return status::quantity_exceeds_max_transfer;
+    if (limit.weekly && now - last_withdraw <= useconds_per_week) return status::claimed_within_week;
+    return status::ok;
+}
+
+constexpr status check_claim(int64_t now, int64_t last_claim) {
+    return now - last_claim > useconds_per_month ? status::ok : status::claimed_within_month;
+}
+
+// bonus rules, `balance` is a player's bonus balance, `allocated` is the casino's total allocated bonus
+
+// a bet with bonus locks its amount, the player is assumed to lose it
+constexpr status check_lock_bonus(int64_t amount, int64_t balance) {
+    return amount <= balance ? status::ok : status::lock_exceeds_bonus_balance;
+}
+
+constexpr status check_subtract_bonus(int64_t amount, int64_t balance) {
+    return amount <= balance ? status::ok : status::subtract_exceeds_bonus_balance;
+}
+
+constexpr status check_withdraw_bonus(int64_t quantity, int64_t allocated) {
+    return quantity <= allocated ? status::ok : status::withdraw_exceeds_total_bonus;
+}
+
+// the whole bonus balance is converted to real tokens
+constexpr status check_convert_bonus(int64_t balance, int64_t allocated) {
+    return balance <= allocated ? status::ok : status::convert_exceeds_total_allocated;
+}
+
+} // namespace accounting
+} // namespace casino
@@ -5,39 +5,9 @@
 #include <eosio/asset.hpp>
 #include <eosio/binary_extension.hpp>
 #include <platform/platform.hpp>
+#include <casino/token.hpp>
+#include <casino/accounting.hpp>
 
-namespace token {
-    struct account {
-        eosio::asset balance;
-        uint64_t primary_key() const { return balance.symbol.code().raw(); }
-    };
-
-    typedef eosio::multi_index<"accounts"_n, account> accounts;
-
-    struct currency_stats {
-        eosio::asset    supply;
-        eosio::asset    max_supply;
-        eosio::name     issuer;
-        uint64_t primary_key() const { return supply.symbol.code().raw(); }
-    };
-
-    typedef eosio::multi_index<"stat"_n, currency_stats> stats;
-
-    eosio::asset get_balance(eosio::name platform, eosio::name account, eosio::symbol s) {
-        platform::token_table tokens(platform, platform.value);
-        auto it = tokens.require_find(s.code().raw(), "token is not in the list");
-        accounts accountstable(it->contract, account.value);
-        return accountstable.get(s.code().raw()).balance;
-    }
-
-    eosio::symbol get_symbol(eosio::name platform, const std::string& token) {
-        const auto sc = eosio::symbol_code(token);
-        platform::token_table tokens(platform, platform.value);
-        auto it = tokens.require_find(sc.raw(), "token is not in the list");
-        stats currencytable(it->contract, sc.raw());
-        return currencytable.get(sc.raw()).supply.symbol;
-    }
-} // namespace token
 
 namespace casino {
 
@@ -50,11 +20,13 @@ using eosio::check;
 using eosio::symbol;
 
 using game_params_type = std::vector<std::pair<uint16_t, uint64_t>>;
+using bonus_credits_type = std::vector<std::pair<name, int64_t>>; // players with bonus amounts, sorted by player
 
 struct [[eosio::table("game"), eosio::contract("casino")]] game_row {
     uint64_t game_id; // unique id of the game - global to casino and platform contracts
     game_params_type params; // game params is simply a vector of integer pairs
     bool paused;
+    eosio::binary_extension<bool> no_bonus; // bets with bonus are not allowed, absent in rows before migratenobon
 
     uint64_t primary_key() const { return game_id; }
 };
@@ -121,6 +93,7 @@ struct [[eosio::table("playerstats"), eosio::contract("casino")]] player_stats_r
 
 using player_stats_table = eosio::multi_index<"playerstats"_n, player_stats_row>;
 
+// legacy, moved to game_row::no_bonus by migratenobon
 struct [[eosio::table("gamesnobon"), eosio::contract("casino")]] games_no_bonus_row {
     uint64_t game_id;
 
@@ -129,15 +102,39 @@ struct [[eosio::table("gamesnobon"), eosio::contract("casino")]] games_no_bonus_
 
 using games_no_bonus_table = eosio::multi_index<"gamesnobon"_n, games_no_bonus_row>;
 
+// game_row::no_bonus, a game row written before the flag keeps its restriction in gamesnobon
+// until migratenobon sets the flag of every game
+static bool is_no_bonus(name casino_contract, const game_row& game) {
+    if (game.no_bonus.has_value()) {
+        return game.no_bonus.value_or(false);
+    }
+    games_no_bonus_table games_no_bonus(casino_contract, casino_contract.value);
+    return games_no_bonus.find(game.game_id) != games_no_bonus.end();
+}
+
 struct [[eosio::table("token"), eosio::contract("casino")]] token_row {
     std::string token_name;
     bool paused;
+    // per player accrual threshold: a player's winnings are accrued in pendingpay until their sum
+    // reaches it and are sent then; not netted per block, absent or zero sends them on every onloss
+    eosio::binary_extension<int64_t> payout_threshold;
+    eosio::binary_extension<int64_t> pending_payouts; // sum of the token's pendingpay rows
 
     uint64_t primary_key() const { return platform::get_token_pk(token_name); }
 };
 
 using token_table = eosio::multi_index<"token"_n, token_row>;
 
+// player winnings not sent yet, scope is the token's symbol raw value
+struct [[eosio::table("pendingpay"), eosio::contract("casino")]] pending_payout_row {
+    name player;
+    int64_t amount;
+
+    uint64_t primary_key() const { return player.value; }
+};
+
+using pending_payout_table = eosio::multi_index<"pendingpay"_n, pending_payout_row>;
+
 struct [[eosio::table("gametokens"), eosio::contract("casino")]] game_tokens_row {
     uint64_t game_id;
     std::map<uint64_t, int64_t> balance; // game's balance aka not clamed profits
@@ -173,6 +170,25 @@ struct [[eosio::table("playertokens"), eosio::contract("casino")]] player_tokens
 
 using player_tokens_table = eosio::multi_index<"playertokens"_n, player_tokens_row>;
 
+// players of one token ordered by volume and net profit, scope is the token's symbol raw value;
+// top players are a reverse range read of an index
+struct [[eosio::table("leaderboard"), eosio::contract("casino")]] leaderboard_row {
+    name player;
+    int64_t volume; // volume_real
+    int64_t profit; // profit_real + profit_bonus, net profit of the player
+
+    uint64_t primary_key() const { return player.value; }
+    uint64_t by_volume() const { return static_cast<uint64_t>(volume) ^ (1ULL << 63); }
+    uint64_t by_profit() const { return static_cast<uint64_t>(profit) ^ (1ULL << 63); }
+};
+
+using leaderboard_table = eosio::multi_index<
+                            "leaderboard"_n,
+                            leaderboard_row,
+                            eosio::indexed_by<"volume"_n, eosio::const_mem_fun<leaderboard_row, uint64_t, &leaderboard_row::by_volume>>,
+                            eosio::indexed_by<"profit"_n, eosio::const_mem_fun<leaderboard_row, uint64_t, &leaderboard_row::by_profit>>
+                          >;
+
 struct [[eosio::table("gameparams"), eosio::contract("casino")]] game_params_row {
     uint64_t game_id;
 
@@ -183,6 +199,56 @@ struct [[eosio::table("gameparams"), eosio::contract("casino")]] game_params_row
 
 using game_params_table = eosio::multi_index<"gameparams"_n, game_params_row>;
 
+// params of a game for one token as a dense array indexed by param id, scope is the game id;
+// a copy of gameparams games read on every bet
+struct [[eosio::table("gameparamtk"), eosio::contract("casino")]] game_param_token_row {
+    uint64_t token; // platform::get_token_pk of the token
+    std::vector<uint64_t> values; // size is the game's params_cnt in the platform
+
+    uint64_t primary_key() const { return token; }
+};
+
+using game_param_token_table = eosio::multi_index<"gameparamtk"_n, game_param_token_row>;
+
+// params ids have to be less than `params_cnt` without duplicates, ids not in the list are zero;
+// legacy params written before the rule are truncated instead: ids out of the count are dropped
+// and the last of duplicates wins
+inline std::vector<uint64_t> to_dense_params(const game_params_type& params, uint16_t params_cnt, bool legacy = false) {
+    std::vector<uint64_t> values(params_cnt);
+    std::vector<bool> seen(params_cnt);
+    for (const auto& [idx, value]: params) {
+        if (legacy && idx >= params_cnt) {
+            continue;
+        }
+        check(idx < params_cnt, "param id exceeds game's params count");
+        check(legacy || !seen[idx], "duplicate param id");
+        seen[idx] = true;
+        values[idx] = value;
+    }
+    return values;
+}
+
+// activity of a game in one token during one day, scope is the game id; rows older than
+// `casino::daily_stats_days` are pruned as new days are added
+struct [[eosio::table("dailystats"), eosio::contract("casino")]] daily_stats_row {
+    uint64_t id;
+    uint64_t symbol_raw;
+    uint32_t day = 0; // days since epoch
+    int64_t volume = 0; // player deposits
+    int64_t payouts = 0; // player payouts
+    uint32_t sessions = 0; // closed sessions
+    int64_t margin = 0; // game developer profit, transfers minus losses
+
+    uint64_t primary_key() const { return id; }
+    platform::uint128_t by_token_day() const { return platform::uint128_t(symbol_raw) << 64 | day; }
+};
+
+using daily_stats_table = eosio::multi_index<
+                            "dailystats"_n,
+                            daily_stats_row,
+                            eosio::indexed_by<"tokenday"_n, eosio::const_mem_fun<daily_stats_row, platform::uint128_t, &daily_stats_row::by_token_day>>
+                          >;
+
 class [[eosio::contract("casino")]] casino: public eosio::contract {
 public:
     using eosio::contract::contract;
@@ -266,6 +332,16 @@ public:
     [[eosio::action("newplayer.t")]]
     void greet_new_player_token(name player_account, const std::string& token); // called by platform on user sign up
 
+    // bulk variants for promotions, players are sorted by name without duplicates
+    [[eosio::action("sendbon.b")]]
+    void send_bonus_bulk(symbol symbol, const bonus_credits_type& credits);
+
+    [[eosio::action("convertbon.b")]]
+    void convert_bonus_bulk(const std::vector<name>& accounts, symbol symbol, const std::string& memo);
+
+    [[eosio::action("newplayer.b")]]
+    void greet_new_players(const std::vector<name>& players, const std::string& token);
+
     [[eosio::action("setgreetbon")]]
     void set_greeting_bonus(asset amount);
     // games no bonus methods
@@ -286,25 +362,49 @@ public:
     [[eosio::action("pausetoken")]]
     void pause_token(std::string token_name, bool pause);
 
+    [[eosio::action("setpaythr")]]
+    void set_payout_threshold(std::string token_name, int64_t threshold);
+
+    [[eosio::action("settle")]]
+    void settle_payouts(symbol symbol, uint32_t count); // permissionless, sends up to `count` pending payouts of the token
+
     [[eosio::action("migratetoken")]]
     void migrate_token();
 
     [[eosio::action("setgameparam2")]]
     void set_game_param_token(uint64_t game_id, std::string token, game_params_type params);
 
+    [[eosio::action("migratenobon")]]
+    void migrate_no_bonus(uint64_t from, uint32_t count); // sets no_bonus flags of `count` games since `from` from gamesnobon
+
+    [[eosio::action("migrateboard")]]
+    void migrate_leaderboard(name from, uint32_t count); // fills leaderboard rows of players since `from`
+
+    [[eosio::action("synclisting")]]
+    void sync_listing(uint64_t from, uint32_t count); // registers `count` listed games since `from` with the platform
+
+    [[eosio::action("migrateparam")]]
+    void migrate_game_params(uint64_t from, uint32_t count); // fills gameparamtk rows of `count` games since `from`, see below
+
     // ==========================
     // constants
-    static constexpr int64_t seconds_per_day = 24 * 3600;
-    static constexpr int64_t useconds_per_day = seconds_per_day * 1000'000ll;
-    static constexpr int64_t useconds_per_week = 7 * useconds_per_day;
-    static constexpr int64_t useconds_per_month = 30 * useconds_per_day;
+    static constexpr int64_t seconds_per_day = accounting::seconds_per_day;
+    static constexpr int64_t useconds_per_day = accounting::useconds_per_day;
+    static constexpr int64_t useconds_per_week = accounting::useconds_per_week;
+    static constexpr int64_t useconds_per_month = accounting::useconds_per_month;
 
     static constexpr symbol core_symbol = symbol(eosio::symbol_code("BET"), 4);
     static const asset zero_asset;
 
-    static const int percent_100 = 100;
+    static constexpr int64_t percent_100 = accounting::percent_100;
 
     static constexpr name platform_game_permission = "gameaction"_n;
+
+    static constexpr uint32_t daily_stats_days = 32; // kept per game and token
+    static constexpr uint32_t max_pruned_days = 2; // per added day, so pruning catches up with gaps
+
+    static constexpr uint32_t max_bulk_players = 500; // per sendbon.b, convertbon.b and newplayer.b
+    static constexpr uint32_t max_settle_count = 100; // inline transfers per settle
 private:
     version_singleton version;
     game_table games;
@@ -335,6 +435,17 @@ private:
 
     uint32_t get_profit_margin(uint64_t game_id) const;
 
+    // game developer's part of the quantity
+    asset get_profit_share(uint64_t game_id, asset quantity) const {
+        const auto share = accounting::profit_share(quantity.amount, get_profit_margin(game_id));
+        check_accounting(share.error);
+        return asset(share.amount, quantity.symbol);
+    }
+
+    static void check_accounting(accounting::status status) {
+        check(status == accounting::status::ok, accounting::message(status));
+    }
+
     asset get_balance(uint64_t game_id, const std::string& token_str) const {
         const auto itr = game_tokens.require_find(game_id, "game not found");
         verify_token(token_str);
@@ -380,10 +491,6 @@ private:
         gtokens.game_profits_sum[symbol_raw] -= quantity.amount;
     }
 
-    bool is_active_game(uint64_t game_id) const {
-        return !games.require_find(game_id, "game not found")->paused;
-    }
-
     time_point get_last_claim_time(uint64_t game_id) const {
         const auto itr = game_state.require_find(game_id, "game not found");
         return itr->last_claim_time;
@@ -398,20 +505,72 @@ private:
 
     void transfer(name to, asset quantity, std::string memo) {
         verify_asset(quantity);
+        send_transfer(get_token_contract(quantity.symbol), to, quantity, memo);
+    }
+
+    // keeps the platform's listing of the casino's games, a casino not added to the platform or
+    // added more than once has none
+    void send_listing(name action, uint64_t game_id) {
+        platform::casino_table casinos(get_platform(), get_platform().value);
+        const auto by_address = casinos.get_index<"address"_n>();
+        auto itr = by_address.find(_self.value);
+        if (itr == by_address.end() || (++itr != by_address.end() && itr->contract == _self)) {
+            return;
+        }
+        eosio::action(
+            eosio::permission_level{_self, "active"_n},
+            get_platform(),
+            action,
+            std::make_tuple(_self, game_id)
+        ).send();
+    }
+
+    name get_token_contract(symbol symbol) const {
         platform::token_table tokens(get_platform(), get_platform().value);
-        auto it = tokens.require_find(quantity.symbol.code().raw(), "token is not in the list");
+        return tokens.require_find(symbol.code().raw(), "token is not in the list")->contract;
+    }
 
+    // the asset is verified by the caller
+    void send_transfer(name token_contract, name to, asset quantity, const std::string& memo) {
         eosio::action(
             eosio::permission_level{_self, "active"_n},
-            it->contract,
+            token_contract,
             "transfer"_n,
             std::make_tuple(_self, to, quantity, memo)
         ).send();
     }
 
-    void verify_game(uint64_t game_id);
+    void pay_winnings(name player_account, asset quantity); // sends or accrues them by the token's payout threshold
+    void add_pending_payouts(symbol symbol, int64_t amount);
+
+    game_table::const_iterator verify_game(uint64_t game_id); // returns the casino's game row
     uint64_t get_game_id(name game_account);
-    void verify_from_game_account(name game_account);
+    game_table::const_iterator verify_from_game_account(name game_account); // returns the casino's game row
+
+    template <typename F>
+    void update_daily_stats(uint64_t game_id, uint64_t symbol_raw, F&& update) {
+        const auto day = static_cast<uint32_t>(current_time_point().sec_since_epoch() / seconds_per_day);
+        const auto token_day = [&](uint32_t d) { return platform::uint128_t(symbol_raw) << 64 | d; };
+
+        daily_stats_table daily_stats(_self, game_id);
+        auto by_token_day = daily_stats.get_index<"tokenday"_n>();
+        const auto itr = by_token_day.find(token_day(day));
+        if (itr != by_token_day.end()) {
+            by_token_day.modify(itr, _self, update);
+            return;
+        }
+
+        daily_stats.emplace(_self, [&](auto& row) {
+            row = daily_stats_row { daily_stats.available_primary_key(), symbol_raw, day };
+            update(row);
+        });
+        uint32_t pruned = 0;
+        for (auto it = by_token_day.lower_bound(token_day(0));
+             it != by_token_day.end() && it->symbol_raw == symbol_raw && it->day + daily_stats_days <= day && pruned < max_pruned_days;
+             ++pruned) {
+            it = by_token_day.erase(it);
+        }
+    }
 
     void session_update_volume(uint64_t game_id, asset quantity) {
         verify_asset(quantity);
@@ -466,6 +625,9 @@ private:
             row.active_sessions_sum[symbol_raw] -= quantity.amount;
         });
         gtokens.game_active_sessions_sum[symbol_raw] -= quantity.amount;
+        update_daily_stats(game_id, symbol_raw, [](auto& stats) {
+            stats.sessions++;
+        });
     }
 
     void reward_game_developer(uint64_t game_id) {
@@ -520,11 +682,59 @@ private:
         return gstate.platform;
     }
 
+    void update_leaderboard(const player_tokens_row& player, uint64_t symbol_raw) {
+        const auto amount = [&](const std::map<uint64_t, int64_t>& amounts) {
+            const auto itr = amounts.find(symbol_raw);
+            return itr == amounts.end() ? 0 : itr->second;
+        };
+        const auto volume = amount(player.volume_real);
+        const auto profit = amount(player.profit_real) + amount(player.profit_bonus);
+
+        leaderboard_table leaderboard(_self, symbol_raw);
+        const auto itr = leaderboard.find(player.player.value);
+        if (itr == leaderboard.end()) {
+            leaderboard.emplace(_self, [&](auto& row) {
+                row.player = player.player;
+                row.volume = volume;
+                row.profit = profit;
+            });
+        } else if (itr->volume != volume || itr->profit != profit) {
+            leaderboard.modify(itr, _self, [&](auto& row) {
+                row.volume = volume;
+                row.profit = profit;
+            });
+        }
+    }
+
+    void set_dense_params(uint64_t game_id, uint64_t token_raw, const game_params_type& params) {
+        const auto params_cnt = platform::read::get_game(get_platform(), game_id).params_cnt;
+        write_dense_params(game_id, token_raw, to_dense_params(params, params_cnt));
+    }
+
+    void write_dense_params(uint64_t game_id, uint64_t token_raw, std::vector<uint64_t> values) {
+        game_param_token_table dense(_self, game_id);
+        const auto itr = dense.find(token_raw);
+        if (itr == dense.end()) {
+            dense.emplace(_self, [&](auto& row) {
+                row.token = token_raw;
+                row.values = std::move(values);
+            });
+        } else {
+            dense.modify(itr, _self, [&](auto& row) {
+                row.values = std::move(values);
+            });
+        }
+    }
+
     void check_from_platform_game() const { eosio::require_auth({get_platform(), platform_game_permission}); }
 
     void create_or_update_bonus_balance(name player, asset amount) {
         verify_asset(amount);
+        credit_bonus(player, amount);
+    }
 
+    // the asset is verified by the caller
+    void credit_bonus(name player, asset amount) {
         if (amount.symbol == core_symbol) {
             const auto itr = bonus_balance.find(player.value);
             if (itr == bonus_balance.end()) {
@@ -540,10 +750,25 @@ private:
         }
         
         const auto symbol_raw = amount.symbol.raw();
-        const auto itr_tokens = get_or_create_player_tokens(player);
-        player_tokens.modify(itr_tokens, _self, [&](auto& row) {
-            row.bonus_balance[symbol_raw] += amount.amount;
-        });
+        const auto itr_tokens = player_tokens.find(player.value);
+        if (itr_tokens == player_tokens.end()) {
+            player_tokens.emplace(_self, [&](auto& row) {
+                row.player = player;
+                row.bonus_balance[symbol_raw] = amount.amount;
+            });
+        } else {
+            player_tokens.modify(itr_tokens, _self, [&](auto& row) {
+                row.bonus_balance[symbol_raw] += amount.amount;
+            });
+        }
+    }
+
+    void check_bulk_players(const std::vector<name>& players) const {
+        check(!players.empty(), "no players");
+        check(players.size() <= max_bulk_players, "too many players");
+        for (size_t i = 1; i < players.size(); ++i) {
+            check(players[i - 1] < players[i], "players should be sorted without duplicates");
+        }
     }
 
     token_table::const_iterator get_token_itr(const std::string& token_name) const {
@@ -563,9 +788,44 @@ private:
     }
 };
 
-const asset casino::zero_asset = asset(0, casino::core_symbol);
+inline const asset casino::zero_asset = asset(0, casino::core_symbol);
 
 namespace read {
+    // everything a game checks in the casino before a bet of a player in one token
+    struct game_context {
+        bool paused = false; // in the casino
+        bool no_bonus = false; // bets with bonus are not allowed
+        std::vector<uint64_t> params; // indexed by param id, empty if the token has no params
+        int64_t bonus_balance = 0; // player's bonus balance in the token
+        uint64_t active_sessions_amount = 0; // of the game
+    };
+
+    // one lookup per table: game, gamestate, gameparamtk and playertokens, and gamesnobon for a game
+    // row without the no_bonus flag
+    static game_context get_game_context(name casino_contract, uint64_t game_id, name player, symbol symbol) {
+        game_context result;
+        game_table games(casino_contract, casino_contract.value);
+        const auto game = games.require_find(game_id, "game not found");
+        result.paused = game->paused;
+        result.no_bonus = is_no_bonus(casino_contract, *game);
+
+        game_state_table game_state(casino_contract, casino_contract.value);
+        result.active_sessions_amount = game_state.require_find(game_id, "game not found")->active_sessions_amount;
+
+        game_param_token_table params(casino_contract, game_id);
+        if (const auto itr = params.find(symbol.code().raw()); itr != params.end()) {
+            result.params = itr->values;
+        }
+
+        player_tokens_table player_tokens(casino_contract, casino_contract.value);
+        if (const auto itr = player_tokens.find(player.value); itr != player_tokens.end()) {
+            if (const auto balance = itr->bonus_balance.find(symbol.raw()); balance != itr->bonus_balance.end()) {
+                result.bonus_balance = balance->second;
+            }
+        }
+        return result;
+    }
+
     static uint64_t get_active_sessions_amount(name casino_contract, uint64_t game_id) {
         game_state_table game_state(casino_contract, casino_contract.value);
         return game_state.require_find(game_id)->active_sessions_amount;
@@ -575,6 +835,14 @@ namespace read {
         global_state_singleton global_state(casino_contract, casino_contract.value);
         return global_state.get_or_default().active_sessions_amount;
     }
+
+    // a single row read whatever the number of params
+    static uint64_t get_game_param(name casino_contract, uint64_t game_id, const std::string& token, uint16_t idx) {
+        game_param_token_table params(casino_contract, game_id);
+        const auto itr = params.require_find(platform::get_token_pk(token), "no game params for the token");
+        check(idx < itr->values.size(), "param id exceeds game's params count");
+        return itr->values[idx];
+    }
 } // ns read
 
 } // namespace casino
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <eosio/asset.hpp>
+#include <platform/platform.hpp>
+
+// eosio.token tables read by the casino
+namespace token {
+    struct account {
+        eosio::asset balance;
+        uint64_t primary_key() const { return balance.symbol.code().raw(); }
+    };
+
+    typedef eosio::multi_index<"accounts"_n, account> accounts;
+
+    struct currency_stats {
+        eosio::asset    supply;
+        eosio::asset    max_supply;
+        eosio::name     issuer;
+        uint64_t primary_key() const { return supply.symbol.code().raw(); }
+    };
+
+    typedef eosio::multi_index<"stat"_n, currency_stats> stats;
+
+    inline eosio::asset get_balance(eosio::name platform, eosio::name account, eosio::symbol s) {
+        platform::token_table tokens(platform, platform.value);
+        auto it = tokens.require_find(s.code().raw(), "token is not in the list");
+        accounts accountstable(it->contract, account.value);
+        return accountstable.get(s.code().raw()).balance;
+    }
+
+    inline eosio::symbol get_symbol(eosio::name platform, const std::string& token) {
+        const auto sc = eosio::symbol_code(token);
+        platform::token_table tokens(platform, platform.value);
+        auto it = tokens.require_find(sc.raw(), "token is not in the list");
+        stats currencytable(it->contract, sc.raw());
+        return currencytable.get(sc.raw()).supply.symbol;
+    }
+} // namespace token
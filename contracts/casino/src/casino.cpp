@@ -1,6 +1,8 @@
 #include <casino/casino.hpp>
 #include <casino/version.hpp>
 
+#include <set>
+
 namespace casino {
 
 casino::casino(name receiver, name code, eosio::datastream<const char*> ds):
@@ -71,6 +73,7 @@ void casino::add_game(uint64_t game_id, game_params_type params) {
         row.game_id = game_id;
         row.params = params;
         row.paused = false;
+        row.no_bonus.emplace(false);
     });
     game_state.emplace(get_self(), [&](auto& row) {
         row.game_id = game_id;
@@ -89,6 +92,8 @@ void casino::add_game(uint64_t game_id, game_params_type params) {
         row.game_id = game_id;
         row.params = {{core_symbol.code().raw(), params}};
     });
+    set_dense_params(game_id, core_symbol.code().raw(), params);
+    send_listing("addlisting"_n, game_id);
 }
 
 void casino::set_game_param(uint64_t game_id, game_params_type params) {
@@ -102,6 +107,7 @@ void casino::set_game_param(uint64_t game_id, game_params_type params) {
     game_params.modify(itr_token, get_self(), [&](auto& row) {
         row.params[core_symbol.code().raw()] = params;
     });
+    set_dense_params(game_id, core_symbol.code().raw(), params);
 }
 
 void casino::remove_game(uint64_t game_id) {
@@ -113,9 +119,15 @@ void casino::remove_game(uint64_t game_id) {
     check(!game_state_itr->active_sessions_amount, "trying to remove a game with non-zero active sessions");
     reward_game_developer(game_id);
     game_params.erase(game_params_itr);
+    game_param_token_table dense(_self, game_id);
+    for (auto it = dense.begin(); it != dense.end(); it = dense.erase(it));
+    // at most `daily_stats_days` rows per token are kept
+    daily_stats_table daily_stats(_self, game_id);
+    for (auto it = daily_stats.begin(); it != daily_stats.end(); it = daily_stats.erase(it));
     game_tokens.erase(game_tokens_itr);
     game_state.erase(game_state_itr);
     games.erase(game_itr);
+    send_listing("dellisting"_n, game_id);
 }
 
 void casino::set_owner(name new_owner) {
@@ -145,7 +157,11 @@ void casino::on_transfer(name game_account, name casino_account, asset quantity,
 
     if (games_idx.find(game_account.value) != games_idx.end()) {
         const auto game_id = get_game_id(game_account);
-        add_balance(game_id, quantity * get_profit_margin(game_id) / percent_100);
+        const auto share = get_profit_share(game_id, quantity);
+        add_balance(game_id, share);
+        update_daily_stats(game_id, share.symbol.raw(), [&](auto& stats) {
+            stats.margin += share.amount;
+        });
     }
 }
 
@@ -153,14 +169,60 @@ void casino::on_loss(name game_account, name player_account, asset quantity) {
     require_auth(game_account);
     check(is_account(player_account), "to account does not exist");
     const auto game_id = get_game_id(game_account);
-    transfer(player_account, quantity, "player winnings");
-    sub_balance(game_id, quantity * get_profit_margin(game_id) / percent_100);
+    pay_winnings(player_account, quantity);
+    const auto share = get_profit_share(game_id, quantity);
+    sub_balance(game_id, share);
+    update_daily_stats(game_id, share.symbol.raw(), [&](auto& stats) {
+        stats.margin -= share.amount;
+    });
+}
+
+void casino::pay_winnings(name player_account, asset quantity) {
+    verify_asset(quantity);
+    const auto threshold = get_token_itr(quantity.symbol.code().to_string())->payout_threshold.value_or(0);
+    if (threshold == 0) {
+        send_transfer(get_token_contract(quantity.symbol), player_account, quantity, "player winnings");
+        return;
+    }
+
+    check(quantity.amount > 0, "must transfer positive quantity");
+    pending_payout_table pending(_self, quantity.symbol.raw());
+    const auto itr = pending.find(player_account.value);
+    const auto owed = accounting::add(itr == pending.end() ? 0 : itr->amount, quantity.amount);
+    check_accounting(owed.error);
+    if (owed.amount >= threshold) {
+        if (itr != pending.end()) {
+            add_pending_payouts(quantity.symbol, -itr->amount);
+            pending.erase(itr);
+        }
+        send_transfer(get_token_contract(quantity.symbol), player_account, asset(owed.amount, quantity.symbol), "player winnings");
+        return;
+    }
+
+    if (itr == pending.end()) {
+        pending.emplace(_self, [&](auto& row) {
+            row.player = player_account;
+            row.amount = owed.amount;
+        });
+    } else {
+        pending.modify(itr, _self, [&](auto& row) {
+            row.amount = owed.amount;
+        });
+    }
+    add_pending_payouts(quantity.symbol, quantity.amount);
+}
+
+void casino::add_pending_payouts(symbol symbol, int64_t amount) {
+    tokens.modify(get_token_itr(symbol.code().to_string()), _self, [&](auto& row) {
+        row.payout_threshold.emplace(row.payout_threshold.value_or(0));
+        row.pending_payouts.emplace(row.pending_payouts.value_or(0) + amount);
+    });
 }
 
 void casino::claim_profit(name game_account) {
     const auto ct = current_time_point();
     const auto game_id = get_game_id(game_account);
-    check(ct - get_last_claim_time(game_id) > microseconds(useconds_per_month), "already claimed within past month");
+    check_accounting(accounting::check_claim(ct.time_since_epoch().count(), get_last_claim_time(game_id).time_since_epoch().count()));
     reward_game_developer(game_id);
 }
 
@@ -169,15 +231,16 @@ uint64_t casino::get_game_id(name game_account) {
     return platform::read::get_game(get_platform(), game_account).id;
 }
 
-void casino::verify_game(uint64_t game_id) {
+game_table::const_iterator casino::verify_game(uint64_t game_id) {
     check(platform::read::is_active_game(get_platform(), game_id), "the game was not verified by the platform");
-    check(is_active_game(game_id), "the game is paused");
+    const auto itr = games.require_find(game_id, "game not found");
+    check(!itr->paused, "the game is paused");
+    return itr;
 }
 
-void casino::verify_from_game_account(name game_account) {
+game_table::const_iterator casino::verify_from_game_account(name game_account) {
     require_auth(game_account);
-    const auto game_id = get_game_id(game_account);
-    verify_game(game_id);
+    return verify_game(get_game_id(game_account));
 }
 
 void casino::greet_new_player(name player_account) {
@@ -192,25 +255,38 @@ void casino::greet_new_player_token(name player_account, const std::string& toke
     create_or_update_bonus_balance(player_account, greeting_bonus);
 };
 
+void casino::greet_new_players(const std::vector<name>& players, const std::string& token) {
+    check_from_platform_game();
+    check_bulk_players(players);
+    const auto symbol = token::get_symbol(get_platform(), token);
+    const auto greeting_bonus = asset(gtokens.greeting_bonus[symbol.raw()], symbol);
+    verify_asset(greeting_bonus);
+    for (const auto player: players) {
+        credit_bonus(player, greeting_bonus);
+    }
+}
+
 void casino::withdraw(name beneficiary_account, asset quantity) {
     require_auth(get_owner());
     verify_asset(quantity);
     const auto ct = current_time_point();
     const auto symbol = quantity.symbol;
-    const auto account_balance = token::get_balance(get_platform(), _self, symbol) - asset(gtokens.total_allocated_bonus[symbol.raw()], symbol);
-    // in case game developers screwed it up
-    const auto game_profits_sum = asset(std::max(0LL, gtokens.game_profits_sum[symbol.raw()]), symbol);
-    const auto game_active_sessions_sum = asset(gtokens.game_active_sessions_sum[symbol.raw()], symbol);
-    if (account_balance > game_active_sessions_sum + game_profits_sum) {
-        const asset max_transfer = account_balance - game_active_sessions_sum - game_profits_sum;
-        check(quantity <= max_transfer, "quantity exceededs max transfer amount");
-        transfer(beneficiary_account, quantity, "casino profits");
-    } else {
-        check(account_balance > game_profits_sum, "developer profits exceed account balance");
-        const asset max_transfer = std::min(account_balance / 10, account_balance - game_profits_sum);
-        check(quantity <= max_transfer, "quantity exceededs max transfer amount");
-        check(ct - gtokens.last_withdraw_time[symbol.raw()] > microseconds(useconds_per_week), "already claimed within past week");
-        transfer(beneficiary_account, quantity, "casino profits");
+    const auto balance = accounting::available_balance(
+        token::get_balance(get_platform(), _self, symbol).amount,
+        get_token_itr(symbol.code().to_string())->pending_payouts.value_or(0)
+    );
+    check_accounting(balance.error);
+    const accounting::withdraw_state state {
+        balance.amount,
+        gtokens.total_allocated_bonus[symbol.raw()],
+        gtokens.game_profits_sum[symbol.raw()],
+        gtokens.game_active_sessions_sum[symbol.raw()]
+    };
+    const auto limit = accounting::max_withdraw(state);
+    const auto last_withdraw = limit.weekly ? gtokens.last_withdraw_time[symbol.raw()] : time_point();
+    check_accounting(accounting::check_withdraw(limit, quantity.amount, ct.time_since_epoch().count(), last_withdraw.time_since_epoch().count()));
+    transfer(beneficiary_account, quantity, "casino profits");
+    if (limit.weekly) {
         gstate.last_withdraw_time = ct;
         gtokens.last_withdraw_time[symbol.raw()] = ct;
     }
@@ -246,7 +322,7 @@ void casino::on_new_depo_legacy(name game_account, asset quantity) {
 }
 
 void casino::on_new_depo(name game_account, name player_account, asset quantity) {
-    verify_from_game_account(game_account);
+    const auto game_id = verify_from_game_account(game_account)->game_id;
     verify_asset(quantity);
 
     if (quantity.symbol == core_symbol) {
@@ -263,10 +339,14 @@ void casino::on_new_depo(name game_account, name player_account, asset quantity)
         row.volume_real[symbol_raw] += quantity.amount;
         row.profit_real[symbol_raw] -= quantity.amount;
     });
+    update_leaderboard(*itr_tokens, symbol_raw);
+    update_daily_stats(game_id, symbol_raw, [&](auto& stats) {
+        stats.volume += quantity.amount;
+    });
 }
 
 void casino::on_ses_payout(name game_account, name player_account, asset quantity) {
-    verify_from_game_account(game_account);
+    const auto game_id = verify_from_game_account(game_account)->game_id;
     verify_asset(quantity);
 
     if (quantity.symbol == core_symbol) {
@@ -281,6 +361,10 @@ void casino::on_ses_payout(name game_account, name player_account, asset quantit
     player_tokens.modify(itr_tokens, _self, [&](auto& row) {
         row.profit_real[symbol_raw] += quantity.amount;
     });
+    update_leaderboard(*itr_tokens, symbol_raw);
+    update_daily_stats(game_id, symbol_raw, [&](auto& stats) {
+        stats.payouts += quantity.amount;
+    });
 }
 
 void casino::pause_game(uint64_t game_id, bool pause) {
@@ -318,10 +402,10 @@ void casino::withdraw_bonus(name to, asset quantity, const std::string& memo) {
     verify_asset(quantity);
     check(memo.size() <= 256, "memo has more than 256 bytes");
     const auto symbol_raw = quantity.symbol.raw();
-    check(quantity.amount <= gtokens.total_allocated_bonus[symbol_raw], "withdraw quantity cannot exceed total bonus");
+    check_accounting(accounting::check_withdraw_bonus(quantity.amount, gtokens.total_allocated_bonus[symbol_raw]));
 
     if (quantity.symbol == core_symbol) {
-        check(quantity <= bstate.total_allocated, "withdraw quantity cannot exceed total bonus");
+        check_accounting(accounting::check_withdraw_bonus(quantity.amount, bstate.total_allocated.amount));
         bstate.total_allocated -= quantity;
     }
 
@@ -335,13 +419,28 @@ void casino::send_bonus(name to, asset amount) {
     create_or_update_bonus_balance(to, amount);
 }
 
+void casino::send_bonus_bulk(symbol symbol, const bonus_credits_type& credits) {
+    require_auth(bstate.admin);
+    check(!credits.empty(), "no players");
+    check(credits.size() <= max_bulk_players, "too many players");
+    verify_asset(asset(0, symbol));
+    // the whole batch is checked before any row is written
+    for (size_t i = 0; i < credits.size(); ++i) {
+        check(i == 0 || credits[i - 1].first < credits[i].first, "players should be sorted without duplicates");
+        check(credits[i].second > 0 && credits[i].second <= accounting::max_amount, "bonus amount should be positive");
+    }
+    for (const auto& [player, amount]: credits) {
+        credit_bonus(player, asset(amount, symbol));
+    }
+}
+
 void casino::subtract_bonus(name from, asset amount) {
     require_auth(bstate.admin);
     verify_asset(amount);
 
     if (amount.symbol == core_symbol) {
         const auto itr = bonus_balance.require_find(from.value, "player has no bonus");
-        check(amount <= itr->balance, "subtract amount cannot exceed player's bonus balance");
+        check_accounting(accounting::check_subtract_bonus(amount.amount, itr->balance.amount));
         bonus_balance.modify(itr, _self, [&](auto& row) {
             row.balance -= amount;
         });
@@ -349,7 +448,7 @@ void casino::subtract_bonus(name from, asset amount) {
   
     const auto itr_tokens = get_or_create_player_tokens(from);
     const auto symbol_raw = amount.symbol.raw();
-    check(amount.amount <= itr_tokens->bonus_balance.at(symbol_raw), "subtract amount cannot exceed player's bonus balance");
+    check_accounting(accounting::check_subtract_bonus(amount.amount, itr_tokens->bonus_balance.at(symbol_raw)));
     player_tokens.modify(itr_tokens, _self, [&](auto& row) {
         row.bonus_balance[symbol_raw] -= amount.amount;
     });
@@ -362,9 +461,8 @@ void casino::convert_bonus(name account, const std::string& memo) {
     const auto row = bonus_balance.require_find(account.value, "player has no bonus");
     const auto itr_tokens = get_or_create_player_tokens(account);
     const auto symbol_raw = core_symbol.raw();
-    check(row->balance <= bstate.total_allocated, "convert quantity cannot exceed total allocated");
-    check(itr_tokens->bonus_balance.at(symbol_raw) <= gtokens.total_allocated_bonus[symbol_raw],
-        "convert quantity cannot exceed total allocated");
+    check_accounting(accounting::check_convert_bonus(row->balance.amount, bstate.total_allocated.amount));
+    check_accounting(accounting::check_convert_bonus(itr_tokens->bonus_balance.at(symbol_raw), gtokens.total_allocated_bonus[symbol_raw]));
     bstate.total_allocated -= row->balance;
     gtokens.total_allocated_bonus[symbol_raw] -= itr_tokens->bonus_balance.at(symbol_raw);
     transfer(account, asset(itr_tokens->bonus_balance.at(symbol_raw), core_symbol), memo);
@@ -380,15 +478,14 @@ void casino::convert_bonus_token(name account, symbol symbol, const std::string&
 
     if (symbol == core_symbol) {
         const auto row = bonus_balance.require_find(account.value, "player has no bonus");
-        check(row->balance <= bstate.total_allocated, "convert quantity cannot exceed total allocated");
+        check_accounting(accounting::check_convert_bonus(row->balance.amount, bstate.total_allocated.amount));
         bstate.total_allocated -= row->balance;
         bonus_balance.erase(row);
     }
 
     const auto itr_tokens = get_or_create_player_tokens(account);
     const auto symbol_raw = symbol.raw();    
-    check(itr_tokens->bonus_balance.at(symbol_raw) <= gtokens.total_allocated_bonus[symbol_raw],
-        "convert quantity cannot exceed total allocated");
+    check_accounting(accounting::check_convert_bonus(itr_tokens->bonus_balance.at(symbol_raw), gtokens.total_allocated_bonus[symbol_raw]));
     gtokens.total_allocated_bonus[symbol_raw] -= itr_tokens->bonus_balance.at(symbol_raw);
     transfer(account, asset(itr_tokens->bonus_balance.at(symbol_raw), symbol), memo);
     player_tokens.modify(itr_tokens, _self, [&](auto& row) {
@@ -396,14 +493,56 @@ void casino::convert_bonus_token(name account, symbol symbol, const std::string&
     });
 }
 
+// allocated totals are checked against the sum of the batch, accounts without bonus left get no transfer
+void casino::convert_bonus_bulk(const std::vector<name>& accounts, symbol symbol, const std::string& memo) {
+    require_auth(bstate.admin);
+    check(memo.size() <= 256, "memo has more than 256 bytes");
+    check_bulk_players(accounts);
+    verify_asset(asset(0, symbol));
+    const auto token_contract = get_token_contract(symbol);
+    const auto symbol_raw = symbol.raw();
+
+    int64_t legacy_total = 0;
+    int64_t total = 0;
+    for (const auto account: accounts) {
+        if (symbol == core_symbol) {
+            const auto row = bonus_balance.require_find(account.value, "player has no bonus");
+            const auto sum = accounting::add(legacy_total, row->balance.amount);
+            check_accounting(sum.error);
+            legacy_total = sum.amount;
+            bonus_balance.erase(row);
+        }
+
+        const auto itr_tokens = player_tokens.require_find(account.value, "player has no bonus");
+        const auto amount = itr_tokens->bonus_balance.find(symbol_raw);
+        check(amount != itr_tokens->bonus_balance.end(), "player has no bonus");
+        const auto quantity = asset(amount->second, symbol);
+        const auto sum = accounting::add(total, quantity.amount);
+        check_accounting(sum.error);
+        total = sum.amount;
+        player_tokens.modify(itr_tokens, _self, [&](auto& row) {
+            row.bonus_balance[symbol_raw] = 0;
+        });
+        if (quantity.amount > 0) {
+            send_transfer(token_contract, account, quantity, memo);
+        }
+    }
+
+    if (symbol == core_symbol) {
+        check_accounting(accounting::check_convert_bonus(legacy_total, bstate.total_allocated.amount));
+        bstate.total_allocated.amount -= legacy_total;
+    }
+    check_accounting(accounting::check_convert_bonus(total, gtokens.total_allocated_bonus[symbol_raw]));
+    gtokens.total_allocated_bonus[symbol_raw] -= total;
+}
+
 void casino::session_lock_bonus(name game_account, name player_account, asset amount) {
-    verify_from_game_account(game_account);
-    check(games_no_bonus.find(get_game_id(game_account)) == games_no_bonus.end(), "game is restricted to bonus");
+    check(!is_no_bonus(_self, *verify_from_game_account(game_account)), "game is restricted to bonus");
     verify_asset(amount);
 
     if (amount.symbol == core_symbol) {
         const auto row = bonus_balance.require_find(player_account.value, "player has no bonus");
-        check(amount <= row->balance, "lock amount cannot exceed player's bonus balance");
+        check_accounting(accounting::check_lock_bonus(amount.amount, row->balance.amount));
         bonus_balance.modify(row, _self, [&](auto& row) {
             row.balance -= amount;
         });
@@ -422,12 +561,13 @@ void casino::session_lock_bonus(name game_account, name player_account, asset am
 
     const auto symbol_raw = amount.symbol.raw();
     const auto itr = get_or_create_player_tokens(player_account);
-    check(amount.amount <= itr->bonus_balance.at(symbol_raw), "lock amount cannot exceed player's bonus balance");
+    check_accounting(accounting::check_lock_bonus(amount.amount, itr->bonus_balance.at(symbol_raw)));
     player_tokens.modify(itr, _self, [&](auto& row) {
         row.bonus_balance[symbol_raw] -= amount.amount;
         row.volume_bonus[symbol_raw] += amount.amount;
         row.profit_bonus[symbol_raw] -= amount.amount;
     });
+    update_leaderboard(*itr, symbol_raw);
 }
 
 void casino::session_add_bonus(name game_account, name account, asset amount) {
@@ -445,27 +585,46 @@ void casino::session_add_bonus(name game_account, name account, asset amount) {
     player_tokens.modify(itr, _self, [&](auto& row) {
         row.profit_bonus[amount.symbol.raw()] += amount.amount;
     });
+    update_leaderboard(*itr, amount.symbol.raw());
 }
 
 void casino::add_game_no_bonus(name game_account) {
     require_auth(bstate.admin);
 
-    const auto game_id = get_game_id(game_account);
-    const auto it = games_no_bonus.find(game_id);
-    check(it == games_no_bonus.end(), "game is already restricted");
+    const auto itr = games.require_find(get_game_id(game_account), "game not found");
+    check(!is_no_bonus(_self, *itr), "game is already restricted");
 
-    games_no_bonus.emplace(_self, [&](auto& row) {
-        row.game_id = game_id;
+    games.modify(itr, _self, [&](auto& row) {
+        row.no_bonus.emplace(true);
     });
 }
 
 void casino::remove_game_no_bonus(name game_account) {
     require_auth(bstate.admin);
 
-    const auto game_id = get_game_id(game_account);
-    const auto it = games_no_bonus.require_find(game_id, "game is not restricted");
+    const auto itr = games.require_find(get_game_id(game_account), "game not found");
+    check(is_no_bonus(_self, *itr), "game is not restricted");
 
-    games_no_bonus.erase(it);
+    games.modify(itr, _self, [&](auto& row) {
+        row.no_bonus.emplace(false);
+    });
+}
+
+void casino::migrate_no_bonus(uint64_t from, uint32_t count) {
+    require_auth(get_owner());
+    // a flag set by addgamenobon or rmgamenobon since the upgrade is newer than the legacy row;
+    // restrictions of games the casino doesn't list had no effect and are left as they are
+    for (auto it = games.lower_bound(from); it != games.end() && count > 0; ++it, --count) {
+        const auto legacy = games_no_bonus.find(it->game_id);
+        if (!it->no_bonus.has_value()) {
+            games.modify(it, _self, [&](auto& row) {
+                row.no_bonus.emplace(legacy != games_no_bonus.end());
+            });
+        }
+        if (legacy != games_no_bonus.end()) {
+            games_no_bonus.erase(legacy);
+        }
+    }
 }
 
 void casino::add_token(std::string token_name) {
@@ -474,6 +633,8 @@ void casino::add_token(std::string token_name) {
     tokens.emplace(get_self(), [&](auto& row) {
         row.token_name = token_name;
         row.paused = false;
+        row.payout_threshold.emplace(0);
+        row.pending_payouts.emplace(0);
     });
 
     const auto symbol = token::get_symbol(get_platform(), token_name);
@@ -482,12 +643,18 @@ void casino::add_token(std::string token_name) {
 
 void casino::remove_token(std::string token_name) {
     require_auth(get_self());
-    tokens.erase(get_token_itr(token_name));
+    const auto token = get_token_itr(token_name);
+    check(token->pending_payouts.value_or(0) == 0, "token has pending payouts");
+    tokens.erase(token);
     const auto token_raw = platform::get_token_pk(token_name);
     for (auto it = game_params.begin(); it != game_params.end(); ++it) {
         game_params.modify(it, get_self(), [&](auto& row) {
             row.params.erase(token_raw);
         });
+        game_param_token_table dense(_self, it->game_id);
+        if (const auto dense_itr = dense.find(token_raw); dense_itr != dense.end()) {
+            dense.erase(dense_itr);
+        }
     }
 }
 
@@ -498,6 +665,31 @@ void casino::pause_token(std::string token_name, bool pause) {
     });
 }
 
+void casino::set_payout_threshold(std::string token_name, int64_t threshold) {
+    require_auth(get_self());
+    check(threshold >= 0 && threshold <= accounting::max_amount, "invalid payout threshold");
+    tokens.modify(get_token_itr(token_name), get_self(), [&](auto& row) {
+        row.payout_threshold.emplace(threshold);
+        row.pending_payouts.emplace(row.pending_payouts.value_or(0));
+    });
+}
+
+// anyone can push it, the winnings go to their players only
+void casino::settle_payouts(symbol symbol, uint32_t count) {
+    check(count > 0, "count should be positive");
+    check(count <= max_settle_count, "too many payouts to settle");
+    const auto token_contract = get_token_contract(symbol);
+    pending_payout_table pending(_self, symbol.raw());
+    int64_t settled = 0;
+    for (auto itr = pending.begin(); itr != pending.end() && count > 0; --count) {
+        send_transfer(token_contract, itr->player, asset(itr->amount, symbol), "player winnings");
+        settled += itr->amount;
+        itr = pending.erase(itr);
+    }
+    check(settled > 0, "nothing to settle");
+    add_pending_payouts(symbol, -settled);
+}
+
 void casino::migrate_token() {  
     require_auth(get_owner());
     const auto symbol_raw = core_symbol.raw();
@@ -559,6 +751,45 @@ void casino::set_game_param_token(uint64_t game_id, std::string token, game_para
     game_params.modify(itr_token, get_self(), [&](auto& row) {
         row.params[platform::get_token_pk(token)] = params;
     }); 
+    set_dense_params(game_id, platform::get_token_pk(token), params);
+}
+
+void casino::migrate_leaderboard(name from, uint32_t count) {
+    require_auth(get_owner());
+    for (auto it = player_tokens.lower_bound(from.value); it != player_tokens.end() && count > 0; ++it, --count) {
+        std::set<uint64_t> symbols;
+        for (const auto* amounts: {&it->volume_real, &it->profit_real, &it->profit_bonus}) {
+            for (const auto& [symbol_raw, amount]: *amounts) {
+                symbols.insert(symbol_raw);
+            }
+        }
+        for (const auto symbol_raw: symbols) {
+            update_leaderboard(*it, symbol_raw);
+        }
+    }
+}
+
+// legacy params don't stop a page: games deleted by the platform take no bets and are skipped,
+// params out of the platform's params count are truncated
+void casino::migrate_game_params(uint64_t from, uint32_t count) {
+    require_auth(get_owner());
+    platform::game_table platform_games(get_platform(), get_platform().value);
+    for (auto it = game_params.lower_bound(from); it != game_params.end() && count > 0; ++it, --count) {
+        const auto game = platform_games.find(it->game_id);
+        if (game == platform_games.end()) {
+            continue;
+        }
+        for (const auto& [token_raw, params]: it->params) {
+            write_dense_params(it->game_id, token_raw, to_dense_params(params, game->params_cnt, true));
+        }
+    }
+}
+
+void casino::sync_listing(uint64_t from, uint32_t count) {
+    require_auth(get_owner());
+    for (auto it = games.lower_bound(from); it != games.end() && count > 0; ++it, --count) {
+        send_listing("addlisting"_n, it->game_id);
+    }
 }
 
 } // namespace casino
@@ -3,10 +3,14 @@
 #include <eosio/eosio.hpp>
 #include <eosio/singleton.hpp>
 
+#include <limits>
+#include <optional>
+
 namespace platform {
 
 
 using bytes = std::vector<char>;
+using uint128_t = unsigned __int128;
 using eosio::name;
 
 
@@ -57,6 +61,54 @@ using game_table = eosio::multi_index<
                     eosio::indexed_by<"address"_n, eosio::const_mem_fun<game_row, uint64_t, &game_row::by_address>>
                    >;
 
+// ids of casinos and games that aren't paused, for listing active entries without scanning the
+// whole casino and game tables
+struct [[eosio::table("activecas"), eosio::contract("platform")]] active_casino_row {
+    uint64_t id;
+
+    uint64_t primary_key() const { return id; }
+};
+using active_casino_table = eosio::multi_index<"activecas"_n, active_casino_row>;
+
+struct [[eosio::table("activegame"), eosio::contract("platform")]] active_game_row {
+    uint64_t id;
+
+    uint64_t primary_key() const { return id; }
+};
+using active_game_table = eosio::multi_index<"activegame"_n, active_game_row>;
+
+// games listed by casinos, the casino contracts register them on their addgame and rmgame
+struct [[eosio::table("listing"), eosio::contract("platform")]] listing_row {
+    uint64_t id;
+    uint64_t casino_id;
+    uint64_t game_id;
+
+    uint64_t primary_key() const { return id; }
+    uint128_t by_game() const { return uint128_t(game_id) << 64 | casino_id; }
+    uint128_t by_casino() const { return uint128_t(casino_id) << 64 | game_id; }
+};
+using listing_table = eosio::multi_index<
+                        "listing"_n,
+                        listing_row,
+                        eosio::indexed_by<"bygame"_n, eosio::const_mem_fun<listing_row, uint128_t, &listing_row::by_game>>,
+                        eosio::indexed_by<"bycasino"_n, eosio::const_mem_fun<listing_row, uint128_t, &listing_row::by_casino>>
+                      >;
+
+// RSA public keys in binary next to the rsa_pubkey strings, so signature checks don't parse them:
+// the casino id or platform_rsa_key_id for the platform key. The modulus is big-endian of 2048, 3072
+// or 4096 bits exactly. Setting a string key drops its row, so a row is never older than the string;
+// droprsastr empties a string once its binary key is set
+struct [[eosio::table("rsakey"), eosio::contract("platform")]] rsa_key_row {
+    uint64_t id;
+    bytes modulus;
+    uint32_t exponent;
+
+    uint64_t primary_key() const { return id; }
+};
+using rsa_key_table = eosio::multi_index<"rsakey"_n, rsa_key_row>;
+
+static constexpr uint64_t platform_rsa_key_id = std::numeric_limits<uint64_t>::max();
+
 
 static uint64_t get_token_pk(const std::string& token_name) {
     // https://github.com/EOSIO/eosio.cdt/blob/1ba675ef4fe6dedc9f57a9982d1227a098bcaba9/libraries/eosiolib/core/eosio/symbol.hpp
@@ -90,6 +142,27 @@ struct [[eosio::table("banlist"), eosio::contract("platform")]] ban_list_row {
 
 using ban_list_table = eosio::multi_index<"banlist"_n, ban_list_row>;
 
+// fields of a casino to change in one modify, absent ones are kept
+struct casino_patch {
+    std::optional<name> contract;
+    std::optional<bool> paused;
+    std::optional<std::string> rsa_pubkey;
+    std::optional<bytes> meta;
+
+    bool empty() const { return !contract && !paused && !rsa_pubkey && !meta; }
+};
+
+// fields of a game to change in one modify, absent ones are kept
+struct game_patch {
+    std::optional<name> contract;
+    std::optional<bool> paused;
+    std::optional<uint32_t> profit_margin;
+    std::optional<name> beneficiary;
+    std::optional<bytes> meta;
+
+    bool empty() const { return !contract && !paused && !profit_margin && !beneficiary && !meta; }
+};
+
 class [[eosio::contract("platform")]] platform: public eosio::contract {
 public:
     using eosio::contract::contract;
@@ -99,6 +172,9 @@ public:
     [[eosio::action("setrsakey")]]
     void set_rsa_pubkey(const std::string& rsa_pubkey);
 
+    [[eosio::action("setrsabin")]]
+    void set_rsa_key(const bytes& modulus, uint32_t exponent);
+
     [[eosio::action("addcas")]]
     void add_casino(name contract, bytes meta);
 
@@ -117,6 +193,22 @@ public:
     [[eosio::action("setrsacas")]]
     void set_rsa_pubkey_casino(uint64_t id, const std::string& rsa_pubkey);
 
+    [[eosio::action("setrsacasbin")]]
+    void set_rsa_key_casino(uint64_t id, const bytes& modulus, uint32_t exponent);
+
+    [[eosio::action("droprsastr")]]
+    void drop_rsa_pubkey_string(uint64_t id); // a casino id or platform_rsa_key_id, readers of the string lose it
+
+
+    [[eosio::action("patchcas")]]
+    void patch_casino(uint64_t id, const casino_patch& patch);
+
+    [[eosio::action("patchcasinos")]]
+    void patch_casinos(const std::vector<uint64_t>& ids, const casino_patch& patch);
+
+    [[eosio::action("pausecasinos")]]
+    void pause_casinos(const std::vector<uint64_t>& ids, bool pause);
+
 
     [[eosio::action("addgame")]]
     void add_game(name contract, uint16_t params_cnt, bytes meta);
@@ -139,6 +231,27 @@ public:
     [[eosio::action("setbenefic")]]
     void set_beneficiary_game(uint64_t id, name beneficiary);
 
+    [[eosio::action("patchgame")]]
+    void patch_game(uint64_t id, const game_patch& patch);
+
+    [[eosio::action("patchgames")]]
+    void patch_games(const std::vector<uint64_t>& ids, const game_patch& patch);
+
+    [[eosio::action("pausegames")]]
+    void pause_games(const std::vector<uint64_t>& ids, bool pause);
+
+    [[eosio::action("dellistcas")]]
+    void del_listings_casino(uint64_t id, uint32_t count); // up to `count` listings of the casino, before delcas
+
+    [[eosio::action("dellistgame")]]
+    void del_listings_game(uint64_t id, uint32_t count); // up to `count` listings of the game, before delgame
+
+    [[eosio::action("addlisting")]]
+    void add_listing(name casino, uint64_t game_id); // sent by the casino contract, listed games are skipped
+
+    [[eosio::action("dellisting")]]
+    void del_listing(name casino, uint64_t game_id); // sent by the casino contract, not listed games are skipped
+
     [[eosio::action("addtoken")]]
     void add_token(std::string token_name, name contract);
 
@@ -151,11 +264,29 @@ public:
     [[eosio::action("unbanplayer")]]
     void unban_player(name player);
 
+    [[eosio::action("migrateactiv")]]
+    void migrate_active(uint64_t from, uint32_t count); // fills activecas and activegame from `count` rows of each since id `from`
+
+    static constexpr uint32_t max_bulk_ids = 500; // per patchcasinos, pausecasinos, patchgames and pausegames,
+                                                  // and listings per dellistcas and dellistgame
+
 private:
+    void apply_patch(casino_table::const_iterator casino_itr, const casino_patch& patch);
+    void apply_patch(game_table::const_iterator game_itr, const game_patch& patch);
+    void set_active_casino(uint64_t id, bool active);
+    void set_active_game(uint64_t id, bool active);
+    uint64_t get_listing_casino_id(name casino);
+    void set_binary_rsa_key(uint64_t id, const bytes& modulus, uint32_t exponent);
+    void erase_binary_rsa_key(uint64_t id);
+
     version_singleton version;
     global_singleton global;
     casino_table casinos;
     game_table games;
+    active_casino_table active_casinos;
+    active_game_table active_games;
+    listing_table listings;
+    rsa_key_table rsa_keys;
     token_table tokens;
     ban_list_table ban_list;
 };
@@ -170,6 +301,17 @@ static std::string get_rsa_pubkey(name platform_contract) {
     return gl.rsa_pubkey;
 }
 
+// binary keys without the rest of the global and casino rows, std::nullopt if the key isn't set
+// or is set as a string only
+static std::optional<rsa_key_row> get_rsa_key(name platform_contract, uint64_t id = platform_rsa_key_id) {
+    rsa_key_table rsa_keys(platform_contract, platform_contract.value);
+    const auto itr = rsa_keys.find(id);
+    if (itr == rsa_keys.end()) {
+        return std::nullopt;
+    }
+    return *itr;
+}
+
 static casino_row get_casino(name platform_contract, uint64_t casino_id) {
     casino_table casinos(platform_contract, platform_contract.value);
     return casinos.get(casino_id, "casino not found");
@@ -210,6 +352,49 @@ static bool is_active_game(name platform_contract, uint64_t game_id) {
     return !(game_itr->paused);
 }
 
+// up to `count` ids of active games since `from`
+static std::vector<uint64_t> get_active_games(name platform_contract, uint64_t from, uint32_t count) {
+    active_game_table active_games(platform_contract, platform_contract.value);
+    std::vector<uint64_t> result;
+    for (auto it = active_games.lower_bound(from); it != active_games.end() && result.size() < count; ++it) {
+        result.push_back(it->id);
+    }
+    return result;
+}
+
+static std::vector<uint64_t> get_active_casinos(name platform_contract, uint64_t from, uint32_t count) {
+    active_casino_table active_casinos(platform_contract, platform_contract.value);
+    std::vector<uint64_t> result;
+    for (auto it = active_casinos.lower_bound(from); it != active_casinos.end() && result.size() < count; ++it) {
+        result.push_back(it->id);
+    }
+    return result;
+}
+
+// up to `count` ids of casinos listing the game since casino id `from`
+static std::vector<uint64_t> get_game_casinos(name platform_contract, uint64_t game_id, uint64_t from, uint32_t count) {
+    listing_table listings(platform_contract, platform_contract.value);
+    const auto by_game = listings.get_index<"bygame"_n>();
+    std::vector<uint64_t> result;
+    for (auto it = by_game.lower_bound(uint128_t(game_id) << 64 | from);
+         it != by_game.end() && it->game_id == game_id && result.size() < count; ++it) {
+        result.push_back(it->casino_id);
+    }
+    return result;
+}
+
+// up to `count` ids of games the casino lists since game id `from`
+static std::vector<uint64_t> get_casino_games(name platform_contract, uint64_t casino_id, uint64_t from, uint32_t count) {
+    listing_table listings(platform_contract, platform_contract.value);
+    const auto by_casino = listings.get_index<"bycasino"_n>();
+    std::vector<uint64_t> result;
+    for (auto it = by_casino.lower_bound(uint128_t(casino_id) << 64 | from);
+         it != by_casino.end() && it->casino_id == casino_id && result.size() < count; ++it) {
+        result.push_back(it->game_id);
+    }
+    return result;
+}
+
 static token_row get_token(name platform_contract, std::string token_name) {
     token_table tokens(platform_contract, platform_contract.value);
     return tokens.get(get_token_pk(token_name), "no token found");
@@ -3,12 +3,34 @@
 
 namespace platform {
 
+namespace {
+
+void check_bulk_ids(const std::vector<uint64_t>& ids) {
+    eosio::check(!ids.empty(), "no ids");
+    eosio::check(ids.size() <= platform::max_bulk_ids, "too many ids");
+}
+
+// canonical big-endian integers: the modulus has its top bit set, both are odd
+void check_rsa_key(const bytes& modulus, uint32_t exponent) {
+    const auto size = modulus.size();
+    eosio::check(size == 256 || size == 384 || size == 512, "rsa modulus should be 2048, 3072 or 4096 bits");
+    eosio::check(uint8_t(modulus.front()) & 0x80, "rsa modulus has leading zero bits");
+    eosio::check(uint8_t(modulus.back()) & 1, "rsa modulus should be odd");
+    eosio::check(exponent >= 3 && exponent % 2 == 1, "invalid rsa exponent");
+}
+
+} // namespace
+
 platform::platform(name receiver, name code, eosio::datastream<const char*> ds):
     contract(receiver, code, ds),
     version(_self, _self.value),
     global(_self, _self.value),
     casinos(_self, _self.value),
     games(_self, _self.value),
+    active_casinos(_self, _self.value),
+    active_games(_self, _self.value),
+    listings(_self, _self.value),
+    rsa_keys(_self, _self.value),
     tokens(_self, _self.value),
     ban_list(_self, _self.value)
 {
@@ -21,6 +43,14 @@ void platform::set_rsa_pubkey(const std::string& rsa_pubkey) {
     auto gs = global.get_or_default();
     gs.rsa_pubkey = rsa_pubkey;
     global.set(gs, get_self());
+    erase_binary_rsa_key(platform_rsa_key_id);
+}
+
+void platform::set_rsa_key(const bytes& modulus, uint32_t exponent) {
+    require_auth(get_self());
+    check_rsa_key(modulus, exponent);
+
+    set_binary_rsa_key(platform_rsa_key_id, modulus, exponent);
 }
 
 void platform::add_casino(name contract, bytes meta) {
@@ -28,12 +58,14 @@ void platform::add_casino(name contract, bytes meta) {
 
     auto gs = global.get_or_default();
 
+    const auto id = gs.casinos_seq++; // <-- auto-increment id
     casinos.emplace(get_self(), [&](auto& row) {
-        row.id = gs.casinos_seq++; // <-- auto-increment id
+        row.id = id;
         row.paused = false; // enabled by default
         row.contract = contract;
         row.meta = std::move(meta);
     });
+    set_active_casino(id, true);
 
     global.set(gs, get_self());
 }
@@ -42,7 +74,14 @@ void platform::del_casino(uint64_t id) {
     require_auth(get_self());
 
     const auto casino_itr = casinos.require_find(id, "casino not found");
+    // listings are removed in pages by dellistcas, there can be too many for one transaction
+    const auto by_casino = listings.get_index<"bycasino"_n>();
+    const auto listing = by_casino.lower_bound(uint128_t(id) << 64);
+    eosio::check(listing == by_casino.end() || listing->casino_id != id, "casino has listings, remove them with dellistcas");
+
     casinos.erase(casino_itr);
+    set_active_casino(id, false);
+    erase_binary_rsa_key(id);
 }
 
 void platform::pause_casino(uint64_t id, bool pause) {
@@ -52,6 +91,7 @@ void platform::pause_casino(uint64_t id, bool pause) {
     casinos.modify(casino_itr, get_self(), [&](auto& row) {
         row.paused = pause;
     });
+    set_active_casino(id, !pause);
 }
 
 void platform::set_contract_casino(uint64_t id, name contract) {
@@ -79,21 +119,98 @@ void platform::set_rsa_pubkey_casino(uint64_t id, const std::string& rsa_pubkey)
     casinos.modify(casino_itr, get_self(), [&](auto& row) {
         row.rsa_pubkey = rsa_pubkey;
     });
+    erase_binary_rsa_key(id);
+}
+
+void platform::set_rsa_key_casino(uint64_t id, const bytes& modulus, uint32_t exponent) {
+    require_auth(get_self());
+    check_rsa_key(modulus, exponent);
+
+    casinos.require_find(id, "casino not found");
+    set_binary_rsa_key(id, modulus, exponent);
+}
+
+void platform::drop_rsa_pubkey_string(uint64_t id) {
+    require_auth(get_self());
+    eosio::check(rsa_keys.find(id) != rsa_keys.end(), "no binary rsa key");
+
+    if (id == platform_rsa_key_id) {
+        auto gs = global.get_or_default();
+        gs.rsa_pubkey.clear();
+        global.set(gs, get_self());
+        return;
+    }
+    casinos.modify(casinos.require_find(id, "casino not found"), get_self(), [&](auto& row) {
+        row.rsa_pubkey.clear();
+    });
 }
 
+void platform::patch_casino(uint64_t id, const casino_patch& patch) {
+    require_auth(get_self());
+    eosio::check(!patch.empty(), "nothing to patch");
+
+    apply_patch(casinos.require_find(id, "casino not found"), patch);
+}
+
+void platform::patch_casinos(const std::vector<uint64_t>& ids, const casino_patch& patch) {
+    require_auth(get_self());
+    check_bulk_ids(ids);
+    eosio::check(!patch.empty(), "nothing to patch");
+
+    for (const auto id: ids) {
+        apply_patch(casinos.require_find(id, "casino not found"), patch);
+    }
+}
+
+void platform::pause_casinos(const std::vector<uint64_t>& ids, bool pause) {
+    require_auth(get_self());
+    check_bulk_ids(ids);
+
+    casino_patch patch;
+    patch.paused = pause;
+    for (const auto id: ids) {
+        apply_patch(casinos.require_find(id, "casino not found"), patch);
+    }
+}
+
+void platform::apply_patch(casino_table::const_iterator casino_itr, const casino_patch& patch) {
+    casinos.modify(casino_itr, get_self(), [&](auto& row) {
+        if (patch.contract) row.contract = *patch.contract;
+        if (patch.paused) row.paused = *patch.paused;
+        if (patch.rsa_pubkey) row.rsa_pubkey = *patch.rsa_pubkey;
+        if (patch.meta) row.meta = *patch.meta;
+    });
+    if (patch.rsa_pubkey) {
+        erase_binary_rsa_key(casino_itr->id);
+    }
+    set_active_casino(casino_itr->id, !casino_itr->paused);
+}
+
+void platform::set_active_casino(uint64_t id, bool active) {
+    const auto itr = active_casinos.find(id);
+    if (active && itr == active_casinos.end()) {
+        active_casinos.emplace(get_self(), [&](auto& row) {
+            row.id = id;
+        });
+    } else if (!active && itr != active_casinos.end()) {
+        active_casinos.erase(itr);
+    }
+}
 
 void platform::add_game(name contract, uint16_t params_cnt, bytes meta) {
     require_auth(get_self());
 
     auto gs = global.get_or_default();
 
+    const auto id = gs.games_seq++; // <-- auto-increment id
     games.emplace(get_self(), [&](auto& row) {
-        row.id = gs.games_seq++; // <-- auto-increment id
+        row.id = id;
         row.paused = false; // <-- enabled by default
         row.params_cnt = params_cnt;
         row.contract = contract;
         row.meta = std::move(meta);
     });
+    set_active_game(id, true);
 
     global.set(gs, get_self());
 }
@@ -102,7 +219,12 @@ void platform::del_game(uint64_t id) {
     require_auth(get_self());
 
     const auto game_itr = games.require_find(id, "game not found");
+    const auto by_game = listings.get_index<"bygame"_n>();
+    const auto listing = by_game.lower_bound(uint128_t(id) << 64);
+    eosio::check(listing == by_game.end() || listing->game_id != id, "game has listings, remove them with dellistgame");
+
     games.erase(game_itr);
+    set_active_game(id, false);
 }
 
 void platform::pause_game(uint64_t id, bool pause) {
@@ -112,6 +234,7 @@ void platform::pause_game(uint64_t id, bool pause) {
     games.modify(game_itr, get_self(), [&](auto& row) {
         row.paused = pause;
     });
+    set_active_game(id, !pause);
 }
 
 void platform::set_contract_game(uint64_t id, name contract) {
@@ -150,6 +273,141 @@ void platform::set_beneficiary_game(uint64_t id, name beneficiary) {
     });
 }
 
+void platform::patch_game(uint64_t id, const game_patch& patch) {
+    require_auth(get_self());
+    eosio::check(!patch.empty(), "nothing to patch");
+
+    apply_patch(games.require_find(id, "game not found"), patch);
+}
+
+void platform::patch_games(const std::vector<uint64_t>& ids, const game_patch& patch) {
+    require_auth(get_self());
+    check_bulk_ids(ids);
+    eosio::check(!patch.empty(), "nothing to patch");
+
+    for (const auto id: ids) {
+        apply_patch(games.require_find(id, "game not found"), patch);
+    }
+}
+
+void platform::pause_games(const std::vector<uint64_t>& ids, bool pause) {
+    require_auth(get_self());
+    check_bulk_ids(ids);
+
+    game_patch patch;
+    patch.paused = pause;
+    for (const auto id: ids) {
+        apply_patch(games.require_find(id, "game not found"), patch);
+    }
+}
+
+void platform::apply_patch(game_table::const_iterator game_itr, const game_patch& patch) {
+    games.modify(game_itr, get_self(), [&](auto& row) {
+        if (patch.contract) row.contract = *patch.contract;
+        if (patch.paused) row.paused = *patch.paused;
+        if (patch.profit_margin) row.profit_margin = *patch.profit_margin;
+        if (patch.beneficiary) row.beneficiary = *patch.beneficiary;
+        if (patch.meta) row.meta = *patch.meta;
+    });
+    set_active_game(game_itr->id, !game_itr->paused);
+}
+
+void platform::set_active_game(uint64_t id, bool active) {
+    const auto itr = active_games.find(id);
+    if (active && itr == active_games.end()) {
+        active_games.emplace(get_self(), [&](auto& row) {
+            row.id = id;
+        });
+    } else if (!active && itr != active_games.end()) {
+        active_games.erase(itr);
+    }
+}
+
+void platform::set_binary_rsa_key(uint64_t id, const bytes& modulus, uint32_t exponent) {
+    const auto itr = rsa_keys.find(id);
+    const auto set = [&](auto& row) {
+        row.id = id;
+        row.modulus = modulus;
+        row.exponent = exponent;
+    };
+    if (itr == rsa_keys.end()) {
+        rsa_keys.emplace(get_self(), set);
+    } else {
+        rsa_keys.modify(itr, get_self(), set);
+    }
+}
+
+void platform::erase_binary_rsa_key(uint64_t id) {
+    const auto itr = rsa_keys.find(id);
+    if (itr != rsa_keys.end()) {
+        rsa_keys.erase(itr);
+    }
+}
+
+void platform::del_listings_casino(uint64_t id, uint32_t count) {
+    require_auth(get_self());
+    eosio::check(count > 0, "count should be positive");
+    eosio::check(count <= max_bulk_ids, "too many listings");
+
+    auto by_casino = listings.get_index<"bycasino"_n>();
+    auto it = by_casino.lower_bound(uint128_t(id) << 64);
+    eosio::check(it != by_casino.end() && it->casino_id == id, "no listings");
+    for (; it != by_casino.end() && it->casino_id == id && count > 0; --count) {
+        it = by_casino.erase(it);
+    }
+}
+
+void platform::del_listings_game(uint64_t id, uint32_t count) {
+    require_auth(get_self());
+    eosio::check(count > 0, "count should be positive");
+    eosio::check(count <= max_bulk_ids, "too many listings");
+
+    auto by_game = listings.get_index<"bygame"_n>();
+    auto it = by_game.lower_bound(uint128_t(id) << 64);
+    eosio::check(it != by_game.end() && it->game_id == id, "no listings");
+    for (; it != by_game.end() && it->game_id == id && count > 0; --count) {
+        it = by_game.erase(it);
+    }
+}
+
+// the address index isn't unique, a listing of a contract added as several casinos would be
+// attributed to any of them
+uint64_t platform::get_listing_casino_id(name casino) {
+    const auto by_address = casinos.get_index<"address"_n>();
+    auto itr = by_address.require_find(casino.value, "casino not found");
+    const auto id = itr->id;
+    ++itr;
+    eosio::check(itr == by_address.end() || itr->contract != casino, "casino contract is added more than once");
+    return id;
+}
+
+void platform::add_listing(name casino, uint64_t game_id) {
+    require_auth(casino);
+    const auto casino_id = get_listing_casino_id(casino);
+    games.require_find(game_id, "game not found");
+
+    const auto by_game = listings.get_index<"bygame"_n>();
+    if (by_game.find(uint128_t(game_id) << 64 | casino_id) != by_game.end()) {
+        return;
+    }
+    listings.emplace(get_self(), [&](auto& row) {
+        row.id = listings.available_primary_key();
+        row.casino_id = casino_id;
+        row.game_id = game_id;
+    });
+}
+
+void platform::del_listing(name casino, uint64_t game_id) {
+    require_auth(casino);
+    const auto casino_id = get_listing_casino_id(casino);
+
+    auto by_game = listings.get_index<"bygame"_n>();
+    const auto itr = by_game.find(uint128_t(game_id) << 64 | casino_id);
+    if (itr != by_game.end()) {
+        by_game.erase(itr);
+    }
+}
+
 void platform::add_token(std::string token_name, name contract) {
     require_auth(get_self());
     tokens.emplace(get_self(), [&](auto& row) {
@@ -163,6 +421,17 @@ void platform::del_token(std::string token_name) {
     tokens.erase(tokens.require_find(get_token_pk(token_name), "del token: no token found"));
 }
 
+void platform::migrate_active(uint64_t from, uint32_t count) {
+    require_auth(get_self());
+    auto left = count;
+    for (auto it = casinos.lower_bound(from); it != casinos.end() && left > 0; ++it, --left) {
+        set_active_casino(it->id, !it->paused);
+    }
+    for (auto it = games.lower_bound(from); it != games.end() && count > 0; ++it, --count) {
+        set_active_game(it->id, !it->paused);
+    }
+}
+
 void platform::ban_player(name player) {
     require_auth(get_self());
     const auto it = ban_list.find(player.value);
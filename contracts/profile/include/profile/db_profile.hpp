@@ -0,0 +1,46 @@
+#pragma once
+
+// Force-included into every source of profiled contract builds (-DDB_PROFILE=ON, see contracts/CMakeLists.txt).
+// Renames database and auth intrinsics declared by eosio headers, so that every call made by
+// multi_index, singleton and require_auth goes through counting wrappers from db_profile.cpp.
+// Wrappers print one `@db <op> <code> <table> <bytes>` line per call to the action console.
+
+#ifndef DB_PROFILE_IMPL
+
+#define db_store_i64 db_profile_store_i64
+#define db_update_i64 db_profile_update_i64
+#define db_remove_i64 db_profile_remove_i64
+#define db_get_i64 db_profile_get_i64
+#define db_next_i64 db_profile_next_i64
+#define db_previous_i64 db_profile_previous_i64
+#define db_find_i64 db_profile_find_i64
+#define db_lowerbound_i64 db_profile_lowerbound_i64
+#define db_upperbound_i64 db_profile_upperbound_i64
+#define db_end_i64 db_profile_end_i64
+
+#define db_idx64_store db_profile_idx64_store
+#define db_idx64_update db_profile_idx64_update
+#define db_idx64_remove db_profile_idx64_remove
+#define db_idx64_next db_profile_idx64_next
+#define db_idx64_previous db_profile_idx64_previous
+#define db_idx64_find_primary db_profile_idx64_find_primary
+#define db_idx64_find_secondary db_profile_idx64_find_secondary
+#define db_idx64_lowerbound db_profile_idx64_lowerbound
+#define db_idx64_upperbound db_profile_idx64_upperbound
+#define db_idx64_end db_profile_idx64_end
+
+#define db_idx128_store db_profile_idx128_store
+#define db_idx128_update db_profile_idx128_update
+#define db_idx128_remove db_profile_idx128_remove
+#define db_idx128_next db_profile_idx128_next
+#define db_idx128_previous db_profile_idx128_previous
+#define db_idx128_find_primary db_profile_idx128_find_primary
+#define db_idx128_find_secondary db_profile_idx128_find_secondary
+#define db_idx128_lowerbound db_profile_idx128_lowerbound
+#define db_idx128_upperbound db_profile_idx128_upperbound
+#define db_idx128_end db_profile_idx128_end
+
+#define require_auth db_profile_require_auth
+#define require_auth2 db_profile_require_auth2
+
+#endif // DB_PROFILE_IMPL
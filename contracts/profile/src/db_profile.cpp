@@ -0,0 +1,247 @@
+// Counting wrappers for database and auth intrinsics, linked into profiled contract builds only.
+// Compiled with DB_PROFILE_IMPL so names below refer to the real chain intrinsics.
+
+#include <cstdint>
+
+using uint128_t = unsigned __int128;
+
+extern "C" {
+    __attribute__((eosio_wasm_import)) int32_t db_store_i64(uint64_t, uint64_t, uint64_t, uint64_t, const void*, uint32_t);
+    __attribute__((eosio_wasm_import)) void db_update_i64(int32_t, uint64_t, const void*, uint32_t);
+    __attribute__((eosio_wasm_import)) void db_remove_i64(int32_t);
+    __attribute__((eosio_wasm_import)) int32_t db_get_i64(int32_t, const void*, uint32_t);
+    __attribute__((eosio_wasm_import)) int32_t db_next_i64(int32_t, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_previous_i64(int32_t, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_find_i64(uint64_t, uint64_t, uint64_t, uint64_t);
+    __attribute__((eosio_wasm_import)) int32_t db_lowerbound_i64(uint64_t, uint64_t, uint64_t, uint64_t);
+    __attribute__((eosio_wasm_import)) int32_t db_upperbound_i64(uint64_t, uint64_t, uint64_t, uint64_t);
+    __attribute__((eosio_wasm_import)) int32_t db_end_i64(uint64_t, uint64_t, uint64_t);
+
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_store(uint64_t, uint64_t, uint64_t, uint64_t, const uint64_t*);
+    __attribute__((eosio_wasm_import)) void db_idx64_update(int32_t, uint64_t, const uint64_t*);
+    __attribute__((eosio_wasm_import)) void db_idx64_remove(int32_t);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_next(int32_t, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_previous(int32_t, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_find_primary(uint64_t, uint64_t, uint64_t, uint64_t*, uint64_t);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_find_secondary(uint64_t, uint64_t, uint64_t, const uint64_t*, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_lowerbound(uint64_t, uint64_t, uint64_t, uint64_t*, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_upperbound(uint64_t, uint64_t, uint64_t, uint64_t*, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx64_end(uint64_t, uint64_t, uint64_t);
+
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_store(uint64_t, uint64_t, uint64_t, uint64_t, const uint128_t*);
+    __attribute__((eosio_wasm_import)) void db_idx128_update(int32_t, uint64_t, const uint128_t*);
+    __attribute__((eosio_wasm_import)) void db_idx128_remove(int32_t);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_next(int32_t, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_previous(int32_t, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_find_primary(uint64_t, uint64_t, uint64_t, uint128_t*, uint64_t);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_find_secondary(uint64_t, uint64_t, uint64_t, const uint128_t*, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_lowerbound(uint64_t, uint64_t, uint64_t, uint128_t*, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_upperbound(uint64_t, uint64_t, uint64_t, uint128_t*, uint64_t*);
+    __attribute__((eosio_wasm_import)) int32_t db_idx128_end(uint64_t, uint64_t, uint64_t);
+
+    __attribute__((eosio_wasm_import)) void require_auth(uint64_t);
+    __attribute__((eosio_wasm_import)) void require_auth2(uint64_t, uint64_t);
+
+    __attribute__((eosio_wasm_import)) uint64_t current_receiver();
+    __attribute__((eosio_wasm_import)) void prints(const char*);
+    __attribute__((eosio_wasm_import)) void printn(uint64_t);
+    __attribute__((eosio_wasm_import)) void printui(uint64_t);
+}
+
+namespace db_profile {
+
+static constexpr int32_t max_iterators = 1024;
+
+// code and table of iterators opened during the current action, used to attribute
+// iterator-only calls (get, update, remove, next) to a table
+struct iterator_table {
+    uint64_t code;
+    uint64_t table;
+};
+
+static iterator_table primary_itrs[max_iterators];
+static iterator_table secondary_itrs[max_iterators];
+
+static void track(iterator_table* itrs, int32_t itr, uint64_t code, uint64_t table) {
+    if (itr >= 0 && itr < max_iterators) {
+        itrs[itr] = { code, table };
+    }
+}
+
+static iterator_table lookup(const iterator_table* itrs, int32_t itr) {
+    if (itr >= 0 && itr < max_iterators) {
+        return itrs[itr];
+    }
+    return { 0, 0 };
+}
+
+// @db <op> <code> <table> <bytes>
+static void log(const char* op, uint64_t code, uint64_t table, uint32_t bytes = 0) {
+    prints("@db ");
+    prints(op);
+    prints(" ");
+    printn(code);
+    prints(" ");
+    printn(table);
+    prints(" ");
+    printui(bytes);
+    prints("\n");
+}
+
+static void log(const char* op, const iterator_table& t, uint32_t bytes = 0) {
+    log(op, t.code, t.table, bytes);
+}
+
+} // namespace db_profile
+
+using namespace db_profile;
+
+extern "C" {
+
+// primary index
+
+int32_t db_profile_store_i64(uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len) {
+    const auto itr = db_store_i64(scope, table, payer, id, data, len);
+    track(primary_itrs, itr, current_receiver(), table);
+    log("store", current_receiver(), table, len);
+    return itr;
+}
+
+void db_profile_update_i64(int32_t itr, uint64_t payer, const void* data, uint32_t len) {
+    log("update", lookup(primary_itrs, itr), len);
+    db_update_i64(itr, payer, data, len);
+}
+
+void db_profile_remove_i64(int32_t itr) {
+    log("remove", lookup(primary_itrs, itr));
+    db_remove_i64(itr);
+}
+
+int32_t db_profile_get_i64(int32_t itr, const void* data, uint32_t len) {
+    // multi_index calls get twice: for the size and for the data, the second one is the row load
+    if (len) {
+        log("get", lookup(primary_itrs, itr), len);
+    }
+    return db_get_i64(itr, data, len);
+}
+
+int32_t db_profile_next_i64(int32_t itr, uint64_t* primary) {
+    const auto t = lookup(primary_itrs, itr);
+    const auto next = db_next_i64(itr, primary);
+    track(primary_itrs, next, t.code, t.table);
+    log("next", t);
+    return next;
+}
+
+int32_t db_profile_previous_i64(int32_t itr, uint64_t* primary) {
+    const auto t = lookup(primary_itrs, itr);
+    const auto prev = db_previous_i64(itr, primary);
+    track(primary_itrs, prev, t.code, t.table);
+    log("previous", t);
+    return prev;
+}
+
+int32_t db_profile_find_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id) {
+    const auto itr = db_find_i64(code, scope, table, id);
+    track(primary_itrs, itr, code, table);
+    log("find", code, table);
+    return itr;
+}
+
+int32_t db_profile_lowerbound_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id) {
+    const auto itr = db_lowerbound_i64(code, scope, table, id);
+    track(primary_itrs, itr, code, table);
+    log("lowerbound", code, table);
+    return itr;
+}
+
+int32_t db_profile_upperbound_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id) {
+    const auto itr = db_upperbound_i64(code, scope, table, id);
+    track(primary_itrs, itr, code, table);
+    log("upperbound", code, table);
+    return itr;
+}
+
+int32_t db_profile_end_i64(uint64_t code, uint64_t scope, uint64_t table) {
+    log("end", code, table);
+    return db_end_i64(code, scope, table);
+}
+
+// secondary indices
+
+#define DB_PROFILE_SECONDARY(IDX, TYPE)                                                                             \
+int32_t db_profile_##IDX##_store(uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const TYPE* secondary) { \
+    const auto itr = db_##IDX##_store(scope, table, payer, id, secondary);                                          \
+    track(secondary_itrs, itr, current_receiver(), table);                                                          \
+    log("idx_store", current_receiver(), table, sizeof(TYPE));                                                      \
+    return itr;                                                                                                     \
+}                                                                                                                   \
+void db_profile_##IDX##_update(int32_t itr, uint64_t payer, const TYPE* secondary) {                               \
+    log("idx_update", lookup(secondary_itrs, itr), sizeof(TYPE));                                                   \
+    db_##IDX##_update(itr, payer, secondary);                                                                       \
+}                                                                                                                   \
+void db_profile_##IDX##_remove(int32_t itr) {                                                                      \
+    log("idx_remove", lookup(secondary_itrs, itr));                                                                 \
+    db_##IDX##_remove(itr);                                                                                         \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_next(int32_t itr, uint64_t* primary) {                                                  \
+    const auto t = lookup(secondary_itrs, itr);                                                                     \
+    const auto next = db_##IDX##_next(itr, primary);                                                                \
+    track(secondary_itrs, next, t.code, t.table);                                                                   \
+    log("idx_next", t);                                                                                             \
+    return next;                                                                                                    \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_previous(int32_t itr, uint64_t* primary) {                                              \
+    const auto t = lookup(secondary_itrs, itr);                                                                     \
+    const auto prev = db_##IDX##_previous(itr, primary);                                                            \
+    track(secondary_itrs, prev, t.code, t.table);                                                                   \
+    log("idx_previous", t);                                                                                         \
+    return prev;                                                                                                    \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_find_primary(uint64_t code, uint64_t scope, uint64_t table, TYPE* secondary, uint64_t primary) { \
+    const auto itr = db_##IDX##_find_primary(code, scope, table, secondary, primary);                               \
+    track(secondary_itrs, itr, code, table);                                                                        \
+    log("idx_find", code, table);                                                                                   \
+    return itr;                                                                                                     \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_find_secondary(uint64_t code, uint64_t scope, uint64_t table, const TYPE* secondary, uint64_t* primary) { \
+    const auto itr = db_##IDX##_find_secondary(code, scope, table, secondary, primary);                             \
+    track(secondary_itrs, itr, code, table);                                                                        \
+    log("idx_find", code, table);                                                                                   \
+    return itr;                                                                                                     \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_lowerbound(uint64_t code, uint64_t scope, uint64_t table, TYPE* secondary, uint64_t* primary) { \
+    const auto itr = db_##IDX##_lowerbound(code, scope, table, secondary, primary);                                 \
+    track(secondary_itrs, itr, code, table);                                                                        \
+    log("idx_lowerbound", code, table);                                                                             \
+    return itr;                                                                                                     \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_upperbound(uint64_t code, uint64_t scope, uint64_t table, TYPE* secondary, uint64_t* primary) { \
+    const auto itr = db_##IDX##_upperbound(code, scope, table, secondary, primary);                                 \
+    track(secondary_itrs, itr, code, table);                                                                        \
+    log("idx_upperbound", code, table);                                                                             \
+    return itr;                                                                                                     \
+}                                                                                                                   \
+int32_t db_profile_##IDX##_end(uint64_t code, uint64_t scope, uint64_t table) {                                    \
+    log("idx_end", code, table);                                                                                    \
+    return db_##IDX##_end(code, scope, table);                                                                      \
+}
+
+DB_PROFILE_SECONDARY(idx64, uint64_t)
+DB_PROFILE_SECONDARY(idx128, uint128_t)
+
+#undef DB_PROFILE_SECONDARY
+
+// auth
+
+void db_profile_require_auth(uint64_t account) {
+    log("require_auth", account, 0);
+    require_auth(account);
+}
+
+void db_profile_require_auth2(uint64_t account, uint64_t permission) {
+    log("require_auth", account, permission);
+    require_auth2(account, permission);
+}
+
+} // extern "C"
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <eosio/datastream.hpp>
+#include <eosio/name.hpp>
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace eosio {
+
+struct permission_level {
+    permission_level() {}
+    permission_level(name a, name p): actor(a), permission(p) {}
+
+    friend bool operator==(const permission_level& a, const permission_level& b) {
+        return a.actor == b.actor && a.permission == b.permission;
+    }
+
+    friend bool operator<(const permission_level& a, const permission_level& b) {
+        return std::tie(a.actor.value, a.permission.value) < std::tie(b.actor.value, b.permission.value);
+    }
+
+    name actor;
+    name permission;
+};
+
+// intrinsics, served by the thread's current in-memory chain (native/src/chain.cpp)
+void require_auth(name account);
+void require_auth(const permission_level& level);
+bool has_auth(name account);
+bool is_account(name account);
+void require_recipient(name notify_account);
+
+template <typename... Accounts>
+void require_recipient(name notify_account, Accounts... remaining_accounts) {
+    require_recipient(notify_account);
+    require_recipient(remaining_accounts...);
+}
+
+struct action;
+void send_inline(action act);
+
+struct action {
+    eosio::name account;
+    eosio::name name;
+    std::vector<permission_level> authorization;
+    std::vector<char> data;
+
+    action() = default;
+
+    template <typename T>
+    action(const permission_level& auth, struct name a, struct name n, T&& value):
+        account(a),
+        name(n),
+        authorization(1, auth),
+        data(pack(std::forward<T>(value)))
+    {}
+
+    template <typename T>
+    action(std::vector<permission_level> auths, struct name a, struct name n, T&& value):
+        account(a),
+        name(n),
+        authorization(std::move(auths)),
+        data(pack(std::forward<T>(value)))
+    {}
+
+    template <typename T>
+    T data_as() const {
+        return unpack<T>(data);
+    }
+
+    void send() const {
+        send_inline(*this);
+    }
+};
+
+} // namespace eosio
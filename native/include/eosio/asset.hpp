@@ -0,0 +1,153 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <eosio/symbol.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace eosio {
+
+// same checks as eosio.cdt asset, overflows are reported with the same messages
+struct asset {
+    int64_t amount = 0;
+    eosio::symbol symbol;
+
+    static constexpr int64_t max_amount = (1LL << 62) - 1;
+
+    asset() {}
+
+    asset(int64_t a, eosio::symbol s): amount(a), symbol(s) {
+        check(is_amount_within_range(), "magnitude of asset amount must be less than 2^62");
+        check(symbol.is_valid(), "invalid symbol name");
+    }
+
+    bool is_amount_within_range() const { return -max_amount <= amount && amount <= max_amount; }
+
+    bool is_valid() const { return is_amount_within_range() && symbol.is_valid(); }
+
+    void set_amount(int64_t a) {
+        amount = a;
+        check(is_amount_within_range(), "magnitude of asset amount must be less than 2^62");
+    }
+
+    asset operator-() const {
+        asset r = *this;
+        r.amount = -r.amount;
+        return r;
+    }
+
+    asset& operator-=(const asset& a) {
+        check(a.symbol == symbol, "attempt to subtract asset with different symbol");
+        amount -= a.amount;
+        check(-max_amount <= amount, "subtraction underflow");
+        check(amount <= max_amount, "subtraction overflow");
+        return *this;
+    }
+
+    asset& operator+=(const asset& a) {
+        check(a.symbol == symbol, "attempt to add asset with different symbol");
+        amount += a.amount;
+        check(-max_amount <= amount, "addition underflow");
+        check(amount <= max_amount, "addition overflow");
+        return *this;
+    }
+
+    friend asset operator+(const asset& a, const asset& b) {
+        asset result = a;
+        result += b;
+        return result;
+    }
+
+    friend asset operator-(const asset& a, const asset& b) {
+        asset result = a;
+        result -= b;
+        return result;
+    }
+
+    asset& operator*=(int64_t a) {
+        const __int128 tmp = (__int128)amount * (__int128)a;
+        check(tmp <= max_amount, "multiplication overflow");
+        check(tmp >= -max_amount, "multiplication underflow");
+        amount = (int64_t)tmp;
+        return *this;
+    }
+
+    friend asset operator*(const asset& a, int64_t b) {
+        asset result = a;
+        result *= b;
+        return result;
+    }
+
+    friend asset operator*(int64_t b, const asset& a) {
+        asset result = a;
+        result *= b;
+        return result;
+    }
+
+    asset& operator/=(int64_t a) {
+        check(a != 0, "divide by zero");
+        check(!(amount == std::numeric_limits<int64_t>::min() && a == -1), "signed division overflow");
+        amount /= a;
+        return *this;
+    }
+
+    friend asset operator/(const asset& a, int64_t b) {
+        asset result = a;
+        result /= b;
+        return result;
+    }
+
+    friend int64_t operator/(const asset& a, const asset& b) {
+        check(b.amount != 0, "divide by zero");
+        check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+        return a.amount / b.amount;
+    }
+
+    friend bool operator==(const asset& a, const asset& b) {
+        check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+        return a.amount == b.amount;
+    }
+
+    friend bool operator!=(const asset& a, const asset& b) {
+        return !(a == b);
+    }
+
+    friend bool operator<(const asset& a, const asset& b) {
+        check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+        return a.amount < b.amount;
+    }
+
+    friend bool operator<=(const asset& a, const asset& b) {
+        check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+        return a.amount <= b.amount;
+    }
+
+    friend bool operator>(const asset& a, const asset& b) {
+        check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+        return a.amount > b.amount;
+    }
+
+    friend bool operator>=(const asset& a, const asset& b) {
+        check(a.symbol == b.symbol, "comparison of assets with different symbols is not allowed");
+        return a.amount >= b.amount;
+    }
+
+    // "1.0000 BET"
+    std::string to_string() const {
+        const bool negative = amount < 0;
+        const uint64_t abs_amount = negative ? -static_cast<uint64_t>(amount) : amount;
+        std::string result = std::to_string(abs_amount);
+        const auto precision = symbol.precision();
+        if (precision) {
+            if (result.size() <= precision) {
+                result.insert(0, precision - result.size() + 1, '0');
+            }
+            result.insert(result.size() - precision, 1, '.');
+        }
+        return (negative ? "-" : "") + result + " " + symbol.code().to_string();
+    }
+};
+
+} // namespace eosio
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <eosio/datastream.hpp>
+
+#include <optional>
+#include <utility>
+
+namespace eosio {
+
+// optional trailing field: written only if present, read only if the stream has bytes left
+template <typename T>
+class binary_extension {
+public:
+    using value_type = T;
+
+    constexpr binary_extension() {}
+    constexpr binary_extension(const T& ext): _value(ext) {}
+    constexpr binary_extension(T&& ext): _value(std::move(ext)) {}
+
+    constexpr bool has_value() const { return _value.has_value(); }
+    constexpr explicit operator bool() const { return has_value(); }
+
+    T& value() {
+        check(has_value(), "cannot get value of empty binary_extension");
+        return *_value;
+    }
+
+    const T& value() const {
+        check(has_value(), "cannot get value of empty binary_extension");
+        return *_value;
+    }
+
+    template <typename U>
+    T value_or(U&& def) const { return _value.value_or(std::forward<U>(def)); }
+
+    T* operator->() { return &value(); }
+    const T* operator->() const { return &value(); }
+    T& operator*() { return value(); }
+    const T& operator*() const { return value(); }
+
+    template <typename... Args>
+    binary_extension& emplace(Args&&... args) {
+        _value.emplace(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    void reset() { _value.reset(); }
+
+private:
+    std::optional<T> _value;
+};
+
+template <typename Stream, typename T>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const binary_extension<T>& be) {
+    if (be.has_value()) {
+        ds << be.value();
+    }
+    return ds;
+}
+
+template <typename Stream, typename T>
+datastream<Stream>& operator>>(datastream<Stream>& ds, binary_extension<T>& be) {
+    if (ds.remaining()) {
+        T value;
+        ds >> value;
+        be.emplace(std::move(value));
+    }
+    return ds;
+}
+
+} // namespace eosio
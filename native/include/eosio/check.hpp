@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace eosio {
+
+// thrown instead of aborting the wasm instance, the in-memory chain rolls back the transaction on it
+struct eosio_assert_error: std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+inline void check(bool pred, const char* msg) {
+    if (!pred) {
+        throw eosio_assert_error(msg);
+    }
+}
+
+inline void check(bool pred, const std::string& msg) {
+    if (!pred) {
+        throw eosio_assert_error(msg);
+    }
+}
+
+inline void check(bool pred, const char* msg, size_t n) {
+    if (!pred) {
+        throw eosio_assert_error(std::string(msg, n));
+    }
+}
+
+inline void check(bool pred, uint64_t code) {
+    if (!pred) {
+        throw eosio_assert_error("assertion failure with error code: " + std::to_string(code));
+    }
+}
+
+} // namespace eosio
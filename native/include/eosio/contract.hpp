@@ -0,0 +1,29 @@
+#pragma once
+
+#include <eosio/datastream.hpp>
+#include <eosio/name.hpp>
+
+namespace eosio {
+
+class contract {
+public:
+    contract(name self, name first_receiver, datastream<const char*> ds):
+        _self(self),
+        _first_receiver(first_receiver),
+        _ds(ds)
+    {}
+
+    name get_self() const { return _self; }
+    name get_code() const { return _first_receiver; }
+    name get_first_receiver() const { return _first_receiver; }
+
+    datastream<const char*>& get_datastream() { return _ds; }
+    const datastream<const char*>& get_datastream() const { return _ds; }
+
+protected:
+    name _self;
+    name _first_receiver;
+    datastream<const char*> _ds = datastream<const char*>(nullptr, 0);
+};
+
+} // namespace eosio
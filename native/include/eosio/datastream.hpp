@@ -0,0 +1,348 @@
+#pragma once
+
+#include <eosio/asset.hpp>
+#include <eosio/check.hpp>
+#include <eosio/name.hpp>
+#include <eosio/reflect.hpp>
+#include <eosio/symbol.hpp>
+#include <eosio/time.hpp>
+
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace eosio {
+
+// eosio.cdt compatible binary serialization, action data is packed the same way the chain does
+template <typename T>
+class datastream {
+public:
+    datastream(T start, size_t s): _start(start), _pos(start), _end(start + s) {}
+
+    void skip(size_t s) { _pos += s; }
+
+    bool read(char* d, size_t s) {
+        check(size_t(_end - _pos) >= s, "datastream attempted to read past the end");
+        std::memcpy(d, _pos, s);
+        _pos += s;
+        return true;
+    }
+
+    bool write(const char* d, size_t s) {
+        check(size_t(_end - _pos) >= s, "datastream attempted to write past the end");
+        std::memcpy(_pos, d, s);
+        _pos += s;
+        return true;
+    }
+
+    bool write(char c) {
+        check(_pos < _end, "datastream attempted to write past the end");
+        *_pos++ = c;
+        return true;
+    }
+
+    T pos() const { return _pos; }
+    bool valid() const { return _pos <= _end && _pos >= _start; }
+    size_t tellp() const { return size_t(_pos - _start); }
+    size_t remaining() const { return size_t(_end - _pos); }
+
+private:
+    T _start;
+    T _pos;
+    T _end;
+};
+
+// counts bytes only, used to size the buffer before packing
+template <>
+class datastream<size_t> {
+public:
+    datastream(size_t init_size = 0): _size(init_size) {}
+
+    void skip(size_t s) { _size += s; }
+    bool write(const char*, size_t s) { _size += s; return true; }
+    bool write(char) { _size++; return true; }
+    size_t tellp() const { return _size; }
+    size_t remaining() const { return 0; }
+
+private:
+    size_t _size;
+};
+
+struct unsigned_int {
+    unsigned_int(uint32_t v = 0): value(v) {}
+    operator uint32_t() const { return value; }
+    uint32_t value;
+};
+
+template <typename T>
+struct is_raw_serializable: std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value> {};
+
+template <>
+struct is_raw_serializable<__int128>: std::true_type {};
+
+template <>
+struct is_raw_serializable<unsigned __int128>: std::true_type {};
+
+template <typename Stream, typename T, std::enable_if_t<is_raw_serializable<T>::value, int> = 0>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const T& v) {
+    ds.write(reinterpret_cast<const char*>(&v), sizeof(T));
+    return ds;
+}
+
+template <typename Stream, typename T, std::enable_if_t<is_raw_serializable<T>::value, int> = 0>
+datastream<Stream>& operator>>(datastream<Stream>& ds, T& v) {
+    ds.read(reinterpret_cast<char*>(&v), sizeof(T));
+    return ds;
+}
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const unsigned_int& v) {
+    uint64_t val = v.value;
+    do {
+        uint8_t b = uint8_t(val) & 0x7f;
+        val >>= 7;
+        b |= ((val > 0) << 7);
+        ds.write(char(b));
+    } while (val);
+    return ds;
+}
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, unsigned_int& v) {
+    uint64_t val = 0;
+    char b = 0;
+    uint8_t by = 0;
+    do {
+        ds.read(&b, 1);
+        val |= uint32_t(uint8_t(b) & 0x7f) << by;
+        by += 7;
+    } while (uint8_t(b) & 0x80);
+    v.value = static_cast<uint32_t>(val);
+    return ds;
+}
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const name& v) { return ds << v.value; }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, name& v) { return ds >> v.value; }
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const symbol_code& v) { return ds << v.raw(); }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, symbol_code& v) {
+    uint64_t raw = 0;
+    ds >> raw;
+    v = symbol_code(raw);
+    return ds;
+}
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const symbol& v) { return ds << v.raw(); }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, symbol& v) {
+    uint64_t raw = 0;
+    ds >> raw;
+    v = symbol(raw);
+    return ds;
+}
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const asset& v) { return ds << v.amount << v.symbol; }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, asset& v) { return ds >> v.amount >> v.symbol; }
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const microseconds& v) { return ds << v._count; }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, microseconds& v) { return ds >> v._count; }
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const time_point& v) { return ds << v.elapsed; }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, time_point& v) { return ds >> v.elapsed; }
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const time_point_sec& v) { return ds << v.utc_seconds; }
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, time_point_sec& v) { return ds >> v.utc_seconds; }
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const std::string& v) {
+    ds << unsigned_int(v.size());
+    if (!v.empty()) {
+        ds.write(v.data(), v.size());
+    }
+    return ds;
+}
+
+template <typename Stream>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const char* v) {
+    return ds << std::string(v);
+}
+
+template <typename Stream>
+datastream<Stream>& operator>>(datastream<Stream>& ds, std::string& v) {
+    unsigned_int size;
+    ds >> size;
+    v.resize(size.value);
+    if (size.value) {
+        ds.read(&v[0], size.value);
+    }
+    return ds;
+}
+
+template <typename Stream, typename T>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const std::vector<T>& v) {
+    ds << unsigned_int(v.size());
+    if constexpr (std::is_same<T, char>::value) {
+        if (!v.empty()) {
+            ds.write(v.data(), v.size());
+        }
+    } else {
+        for (const auto& i: v) {
+            ds << i;
+        }
+    }
+    return ds;
+}
+
+template <typename Stream, typename T>
+datastream<Stream>& operator>>(datastream<Stream>& ds, std::vector<T>& v) {
+    unsigned_int size;
+    ds >> size;
+    v.resize(size.value);
+    if constexpr (std::is_same<T, char>::value) {
+        if (size.value) {
+            ds.read(v.data(), size.value);
+        }
+    } else {
+        for (auto& i: v) {
+            ds >> i;
+        }
+    }
+    return ds;
+}
+
+template <typename Stream, typename K, typename V>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const std::pair<K, V>& v) {
+    return ds << v.first << v.second;
+}
+
+template <typename Stream, typename K, typename V>
+datastream<Stream>& operator>>(datastream<Stream>& ds, std::pair<K, V>& v) {
+    return ds >> v.first >> v.second;
+}
+
+template <typename Stream, typename K, typename V>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const std::map<K, V>& v) {
+    ds << unsigned_int(v.size());
+    for (const auto& i: v) {
+        ds << i.first << i.second;
+    }
+    return ds;
+}
+
+template <typename Stream, typename K, typename V>
+datastream<Stream>& operator>>(datastream<Stream>& ds, std::map<K, V>& v) {
+    unsigned_int size;
+    ds >> size;
+    v.clear();
+    for (uint32_t i = 0; i < size.value; ++i) {
+        K key;
+        V value;
+        ds >> key >> value;
+        v.emplace(std::move(key), std::move(value));
+    }
+    return ds;
+}
+
+template <typename Stream, typename T>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const std::optional<T>& v) {
+    ds << v.has_value();
+    if (v) {
+        ds << *v;
+    }
+    return ds;
+}
+
+template <typename Stream, typename T>
+datastream<Stream>& operator>>(datastream<Stream>& ds, std::optional<T>& v) {
+    bool has_value = false;
+    ds >> has_value;
+    if (has_value) {
+        T value;
+        ds >> value;
+        v = std::move(value);
+    } else {
+        v.reset();
+    }
+    return ds;
+}
+
+template <typename Stream, typename... Args>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const std::tuple<Args...>& v) {
+    std::apply([&](const auto&... items) { (void)(ds << ... << items); }, v);
+    return ds;
+}
+
+template <typename Stream, typename... Args>
+datastream<Stream>& operator>>(datastream<Stream>& ds, std::tuple<Args...>& v) {
+    std::apply([&](auto&... items) { (void)(ds >> ... >> items); }, v);
+    return ds;
+}
+
+// table rows and struct action arguments
+template <typename Stream, typename T, std::enable_if_t<detail::is_reflectable<T>::value, int> = 0>
+datastream<Stream>& operator<<(datastream<Stream>& ds, const T& v) {
+    return ds << detail::tie_fields(v);
+}
+
+template <typename Stream, typename T, std::enable_if_t<detail::is_reflectable<T>::value, int> = 0>
+datastream<Stream>& operator>>(datastream<Stream>& ds, T& v) {
+    auto fields = detail::tie_fields(v);
+    return ds >> fields;
+}
+
+template <typename T>
+size_t pack_size(const T& value) {
+    datastream<size_t> ps;
+    ps << value;
+    return ps.tellp();
+}
+
+template <typename T>
+std::vector<char> pack(const T& value) {
+    std::vector<char> result(pack_size(value));
+    if (!result.empty()) {
+        datastream<char*> ds(result.data(), result.size());
+        ds << value;
+    }
+    return result;
+}
+
+template <typename T>
+T unpack(const char* buffer, size_t len) {
+    T result;
+    datastream<const char*> ds(buffer, len);
+    ds >> result;
+    return result;
+}
+
+template <typename T>
+T unpack(const std::vector<char>& bytes) {
+    return unpack<T>(bytes.data(), bytes.size());
+}
+
+} // namespace eosio
@@ -0,0 +1,13 @@
+#pragma once
+
+// host build replacement of eosio.cdt <eosio/eosio.hpp>, see "Native build" in README.md
+#include <eosio/action.hpp>
+#include <eosio/asset.hpp>
+#include <eosio/check.hpp>
+#include <eosio/contract.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+#include <eosio/symbol.hpp>
+#include <eosio/system.hpp>
+#include <eosio/time.hpp>
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <eosio/name.hpp>
+#include <native/database.hpp>
+
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace eosio {
+
+constexpr static inline name same_payer{};
+
+template <class Class, class Type, Type (Class::*PtrToMemberFunction)() const>
+struct const_mem_fun {
+    using result_type = typename std::remove_const<typename std::remove_reference<Type>::type>::type;
+
+    Type operator()(const Class& x) const { return (x.*PtrToMemberFunction)(); }
+};
+
+template <name::raw IndexName, typename Extractor>
+struct indexed_by {
+    static constexpr name index_name = name(IndexName);
+    using secondary_extractor_type = Extractor;
+    using secondary_key_type = typename Extractor::result_type;
+};
+
+// eosio.cdt multi_index interface over rows kept in the in-memory database,
+// writes are journaled so that a failed transaction is rolled back
+template <name::raw TableName, typename T, typename... Indices>
+class multi_index {
+public:
+    using storage_type = native::table_storage<T, Indices...>;
+    using rows_type = typename storage_type::rows_type;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const T& operator*() const {
+            check(_it != _rows->end(), "cannot dereference end iterator");
+            return _it->second;
+        }
+
+        const T* operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            check(_it != _rows->end(), "cannot increment end iterator");
+            ++_it;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        const_iterator& operator--() {
+            check(_it != _rows->begin(), "cannot decrement iterator at beginning of table");
+            --_it;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator result = *this;
+            --(*this);
+            return result;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a._it == b._it; }
+        friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a._it != b._it; }
+
+    private:
+        friend class multi_index;
+
+        const_iterator(const rows_type* rows, typename rows_type::const_iterator it): _rows(rows), _it(it) {}
+
+        const rows_type* _rows = nullptr;
+        typename rows_type::const_iterator _it;
+    };
+
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template <name::raw IndexName, typename Extractor, size_t N>
+    class index {
+    public:
+        using secondary_key_type = typename Extractor::result_type;
+        using set_type = std::set<std::pair<secondary_key_type, uint64_t>>;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            const_iterator() = default;
+
+            const T& operator*() const {
+                check(_it != _set->end(), "cannot dereference end iterator");
+                return _rows->find(_it->second)->second;
+            }
+
+            const T* operator->() const { return &**this; }
+
+            const_iterator& operator++() {
+                check(_it != _set->end(), "cannot increment end iterator");
+                ++_it;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator result = *this;
+                ++(*this);
+                return result;
+            }
+
+            const_iterator& operator--() {
+                check(_it != _set->begin(), "cannot decrement iterator at beginning of index");
+                --_it;
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator result = *this;
+                --(*this);
+                return result;
+            }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b) { return a._it == b._it; }
+            friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a._it != b._it; }
+
+        private:
+            friend class index;
+
+            const_iterator(const index* idx, typename set_type::const_iterator it):
+                _set(idx->_set),
+                _rows(&idx->_mi->_storage->rows),
+                _it(it)
+            {}
+
+            const set_type* _set = nullptr;
+            const rows_type* _rows = nullptr;
+            typename set_type::const_iterator _it;
+        };
+
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        explicit index(multi_index* mi): _mi(mi), _set(&std::get<N>(mi->_storage->secondary)) {}
+
+        static constexpr eosio::name name() { return eosio::name(IndexName); }
+        eosio::name get_code() const { return _mi->get_code(); }
+        uint64_t get_scope() const { return _mi->get_scope(); }
+
+        const_iterator cbegin() const { return const_iterator(this, _set->cbegin()); }
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cend() const { return const_iterator(this, _set->cend()); }
+        const_iterator end() const { return cend(); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(cend()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(cbegin()); }
+
+        const_iterator lower_bound(const secondary_key_type& key) const {
+            return const_iterator(this, _set->lower_bound({key, 0}));
+        }
+
+        const_iterator upper_bound(const secondary_key_type& key) const {
+            return const_iterator(this, _set->upper_bound({key, std::numeric_limits<uint64_t>::max()}));
+        }
+
+        const_iterator find(const secondary_key_type& key) const {
+            auto it = _set->lower_bound({key, 0});
+            if (it != _set->end() && it->first == key) {
+                return const_iterator(this, it);
+            }
+            return cend();
+        }
+
+        const_iterator require_find(const secondary_key_type& key, const char* error_msg = "unable to find secondary key") const {
+            auto it = find(key);
+            check(it != cend(), error_msg);
+            return it;
+        }
+
+        const T& get(const secondary_key_type& key, const char* error_msg = "unable to find secondary key") const {
+            return *require_find(key, error_msg);
+        }
+
+        const_iterator iterator_to(const T& obj) const {
+            return const_iterator(this, _set->find({Extractor()(obj), obj.primary_key()}));
+        }
+
+        template <typename Lambda>
+        void modify(const_iterator itr, eosio::name payer, Lambda&& updater) {
+            _mi->modify(*itr, payer, std::forward<Lambda>(updater));
+        }
+
+        const_iterator erase(const_iterator itr) {
+            check(itr != cend(), "cannot pass end iterator to erase");
+            const auto& obj = *itr;
+            ++itr;
+            _mi->erase(obj);
+            return itr;
+        }
+
+        static auto extract_secondary_key(const T& obj) { return Extractor()(obj); }
+
+    private:
+        multi_index* _mi;
+        const set_type* _set;
+    };
+
+    multi_index(name code, uint64_t scope):
+        _code(code),
+        _scope(scope),
+        _storage(&native::current_db().get_table<storage_type>(code.value, scope, static_cast<uint64_t>(TableName)))
+    {}
+
+    static constexpr name table_name() { return name(TableName); }
+    name get_code() const { return _code; }
+    uint64_t get_scope() const { return _scope; }
+
+    const_iterator cbegin() const { return const_iterator(&_storage->rows, _storage->rows.cbegin()); }
+    const_iterator begin() const { return cbegin(); }
+    const_iterator cend() const { return const_iterator(&_storage->rows, _storage->rows.cend()); }
+    const_iterator end() const { return cend(); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+    const_reverse_iterator rbegin() const { return crbegin(); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+    const_reverse_iterator rend() const { return crend(); }
+
+    const_iterator lower_bound(uint64_t primary) const {
+        return const_iterator(&_storage->rows, _storage->rows.lower_bound(primary));
+    }
+
+    const_iterator upper_bound(uint64_t primary) const {
+        return const_iterator(&_storage->rows, _storage->rows.upper_bound(primary));
+    }
+
+    uint64_t available_primary_key() const {
+        return _storage->rows.empty() ? 0 : _storage->rows.rbegin()->first + 1;
+    }
+
+    template <name::raw IndexName>
+    auto get_index() {
+        constexpr size_t n = index_position(static_cast<uint64_t>(IndexName));
+        static_assert(n < sizeof...(Indices), "name provided is not the name of any secondary index within multi_index");
+        using index_def = typename std::tuple_element<n, std::tuple<Indices...>>::type;
+        return index<IndexName, typename index_def::secondary_extractor_type, n>(this);
+    }
+
+    template <name::raw IndexName>
+    auto get_index() const {
+        return const_cast<multi_index*>(this)->template get_index<IndexName>();
+    }
+
+    const_iterator iterator_to(const T& obj) const {
+        return find(obj.primary_key());
+    }
+
+    template <typename Lambda>
+    const_iterator emplace(name payer, Lambda&& constructor) {
+        check_write();
+        check(payer != name(), "must specify a valid account to pay for new record");
+
+        T obj{};
+        constructor(obj);
+        const auto pk = obj.primary_key();
+        check(_storage->rows.find(pk) == _storage->rows.end(), "could not insert object, most likely a uniqueness constraint was violated");
+
+        auto it = _storage->insert(std::move(obj));
+        native::current_db().on_write(_code.value, _scope, static_cast<uint64_t>(TableName), pk);
+        native::current_db().on_undo([storage = _storage, pk] {
+            storage->remove(storage->rows.find(pk));
+        });
+        return const_iterator(&_storage->rows, it);
+    }
+
+    template <typename Lambda>
+    void modify(const_iterator itr, name payer, Lambda&& updater) {
+        check(itr != end(), "cannot pass end iterator to modify");
+        modify(*itr, payer, std::forward<Lambda>(updater));
+    }
+
+    template <typename Lambda>
+    void modify(const T& obj, name payer, Lambda&& updater) {
+        check_write();
+
+        const auto pk = obj.primary_key();
+        auto it = _storage->rows.find(pk);
+        check(it != _storage->rows.end(), "object passed to modify is not in multi_index");
+
+        T old = it->second;
+        updater(it->second);
+        check(it->second.primary_key() == pk, "updater cannot change primary key when modifying an object");
+        _storage->update_secondary(old, it->second, pk);
+
+        native::current_db().on_write(_code.value, _scope, static_cast<uint64_t>(TableName), pk);
+        native::current_db().on_undo([storage = _storage, pk, old = std::move(old)] {
+            auto it = storage->rows.find(pk);
+            storage->update_secondary(it->second, old, pk);
+            it->second = old;
+        });
+    }
+
+    const_iterator erase(const_iterator itr) {
+        check(itr != end(), "cannot pass end iterator to erase");
+        const auto pk = itr->primary_key();
+        ++itr;
+        erase_primary(pk);
+        return itr;
+    }
+
+    void erase(const T& obj) {
+        erase_primary(obj.primary_key());
+    }
+
+    const T& get(uint64_t primary, const char* error_msg = "unable to find key") const {
+        auto it = _storage->rows.find(primary);
+        check(it != _storage->rows.end(), error_msg);
+        return it->second;
+    }
+
+    const_iterator find(uint64_t primary) const {
+        return const_iterator(&_storage->rows, _storage->rows.find(primary));
+    }
+
+    const_iterator require_find(uint64_t primary, const char* error_msg = "unable to find key") const {
+        auto it = find(primary);
+        check(it != end(), error_msg);
+        return it;
+    }
+
+private:
+    static constexpr size_t index_position(uint64_t index_name) {
+        constexpr uint64_t names[] = { Indices::index_name.value..., 0 };
+        for (size_t i = 0; i < sizeof...(Indices); ++i) {
+            if (names[i] == index_name) {
+                return i;
+            }
+        }
+        return sizeof...(Indices);
+    }
+
+    void check_write() const {
+        const auto receiver = native::current_receiver();
+        check(!_storage->read_only && (receiver == name() || receiver == _code), "db access violation");
+    }
+
+    void erase_primary(uint64_t pk) {
+        check_write();
+
+        auto it = _storage->rows.find(pk);
+        check(it != _storage->rows.end(), "attempt to remove object that was not in multi_index");
+
+        native::current_db().on_write(_code.value, _scope, static_cast<uint64_t>(TableName), pk);
+        native::current_db().on_undo([storage = _storage, old = it->second] {
+            storage->insert(old);
+        });
+        _storage->remove(it);
+    }
+
+    name _code;
+    uint64_t _scope;
+    storage_type* _storage;
+};
+
+} // namespace eosio
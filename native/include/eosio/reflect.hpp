@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace eosio {
+namespace detail {
+
+// table rows are plain aggregates serialized field by field, eosio-cpp generates that code from the
+// struct definition, on the host fields are enumerated with structured bindings instead
+constexpr size_t max_reflected_fields = 16;
+
+template <typename T>
+struct any_field {
+    // never converts to the aggregate itself, otherwise T{any_field} would be a copy
+    template <typename U, typename = std::enable_if_t<!std::is_same<std::decay_t<U>, T>::value>>
+    operator U() const;
+};
+
+template <typename T, typename Seq, typename = void>
+struct is_brace_constructible: std::false_type {};
+
+template <typename T, size_t... I>
+struct is_brace_constructible<T, std::index_sequence<I...>,
+    std::void_t<decltype(T{(void(I), any_field<T>())...})>>: std::true_type {};
+
+// number of fields, rows don't have nested aggregates so brace elision doesn't inflate the count
+template <typename T, size_t N = max_reflected_fields>
+constexpr size_t field_count() {
+    if constexpr (N == 0) {
+        return 0;
+    } else if constexpr (is_brace_constructible<T, std::make_index_sequence<N>>::value) {
+        return N;
+    } else {
+        return field_count<T, N - 1>();
+    }
+}
+
+template <typename T>
+struct is_reflectable: std::integral_constant<bool, std::is_aggregate<T>::value && std::is_class<T>::value
+                                                    && !std::is_polymorphic<T>::value> {};
+
+#define EOSIO_NATIVE_FIELDS_1 f1
+#define EOSIO_NATIVE_FIELDS_2 EOSIO_NATIVE_FIELDS_1, f2
+#define EOSIO_NATIVE_FIELDS_3 EOSIO_NATIVE_FIELDS_2, f3
+#define EOSIO_NATIVE_FIELDS_4 EOSIO_NATIVE_FIELDS_3, f4
+#define EOSIO_NATIVE_FIELDS_5 EOSIO_NATIVE_FIELDS_4, f5
+#define EOSIO_NATIVE_FIELDS_6 EOSIO_NATIVE_FIELDS_5, f6
+#define EOSIO_NATIVE_FIELDS_7 EOSIO_NATIVE_FIELDS_6, f7
+#define EOSIO_NATIVE_FIELDS_8 EOSIO_NATIVE_FIELDS_7, f8
+#define EOSIO_NATIVE_FIELDS_9 EOSIO_NATIVE_FIELDS_8, f9
+#define EOSIO_NATIVE_FIELDS_10 EOSIO_NATIVE_FIELDS_9, f10
+#define EOSIO_NATIVE_FIELDS_11 EOSIO_NATIVE_FIELDS_10, f11
+#define EOSIO_NATIVE_FIELDS_12 EOSIO_NATIVE_FIELDS_11, f12
+#define EOSIO_NATIVE_FIELDS_13 EOSIO_NATIVE_FIELDS_12, f13
+#define EOSIO_NATIVE_FIELDS_14 EOSIO_NATIVE_FIELDS_13, f14
+#define EOSIO_NATIVE_FIELDS_15 EOSIO_NATIVE_FIELDS_14, f15
+#define EOSIO_NATIVE_FIELDS_16 EOSIO_NATIVE_FIELDS_15, f16
+
+#define EOSIO_NATIVE_FOR_EACH_FIELD(N) \
+    if constexpr (count == N) { \
+        auto& [EOSIO_NATIVE_FIELDS_##N] = value; \
+        return std::forward_as_tuple(EOSIO_NATIVE_FIELDS_##N); \
+    } else
+
+// tuple of references to the fields of an aggregate
+template <typename T>
+auto tie_fields(T& value) {
+    constexpr size_t count = field_count<std::remove_const_t<T>>();
+    static_assert(count > 0, "aggregate has no fields or more than max_reflected_fields");
+    EOSIO_NATIVE_FOR_EACH_FIELD(1)
+    EOSIO_NATIVE_FOR_EACH_FIELD(2)
+    EOSIO_NATIVE_FOR_EACH_FIELD(3)
+    EOSIO_NATIVE_FOR_EACH_FIELD(4)
+    EOSIO_NATIVE_FOR_EACH_FIELD(5)
+    EOSIO_NATIVE_FOR_EACH_FIELD(6)
+    EOSIO_NATIVE_FOR_EACH_FIELD(7)
+    EOSIO_NATIVE_FOR_EACH_FIELD(8)
+    EOSIO_NATIVE_FOR_EACH_FIELD(9)
+    EOSIO_NATIVE_FOR_EACH_FIELD(10)
+    EOSIO_NATIVE_FOR_EACH_FIELD(11)
+    EOSIO_NATIVE_FOR_EACH_FIELD(12)
+    EOSIO_NATIVE_FOR_EACH_FIELD(13)
+    EOSIO_NATIVE_FOR_EACH_FIELD(14)
+    EOSIO_NATIVE_FOR_EACH_FIELD(15)
+    EOSIO_NATIVE_FOR_EACH_FIELD(16)
+    {
+        return std::tuple<>();
+    }
+}
+
+#undef EOSIO_NATIVE_FOR_EACH_FIELD
+
+} // namespace detail
+} // namespace eosio
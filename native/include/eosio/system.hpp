@@ -0,0 +1,16 @@
+#pragma once
+
+#include <eosio/name.hpp>
+#include <eosio/time.hpp>
+
+namespace eosio {
+
+// intrinsics, served by the thread's current in-memory chain (native/src/chain.cpp)
+time_point current_time_point();
+name current_receiver();
+
+inline uint32_t current_block_time_sec() {
+    return current_time_point().sec_since_epoch();
+}
+
+} // namespace eosio
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace eosio {
+
+class microseconds {
+public:
+    explicit microseconds(int64_t c = 0): _count(c) {}
+
+    static microseconds maximum() { return microseconds(std::numeric_limits<int64_t>::max()); }
+
+    int64_t count() const { return _count; }
+    int64_t to_seconds() const { return _count / 1000000; }
+
+    friend microseconds operator+(const microseconds& l, const microseconds& r) { return microseconds(l._count + r._count); }
+    friend microseconds operator-(const microseconds& l, const microseconds& r) { return microseconds(l._count - r._count); }
+
+    microseconds& operator+=(const microseconds& c) { _count += c._count; return *this; }
+    microseconds& operator-=(const microseconds& c) { _count -= c._count; return *this; }
+
+    bool operator==(const microseconds& c) const { return _count == c._count; }
+    bool operator!=(const microseconds& c) const { return _count != c._count; }
+    bool operator>(const microseconds& c) const { return _count > c._count; }
+    bool operator>=(const microseconds& c) const { return _count >= c._count; }
+    bool operator<(const microseconds& c) const { return _count < c._count; }
+    bool operator<=(const microseconds& c) const { return _count <= c._count; }
+
+    int64_t _count;
+};
+
+inline microseconds seconds(int64_t s) { return microseconds(s * 1000000); }
+inline microseconds milliseconds(int64_t s) { return microseconds(s * 1000); }
+inline microseconds minutes(int64_t m) { return seconds(60 * m); }
+inline microseconds hours(int64_t h) { return minutes(60 * h); }
+inline microseconds days(int64_t d) { return hours(24 * d); }
+
+class time_point {
+public:
+    time_point() {}
+    explicit time_point(microseconds e): elapsed(e) {}
+
+    const microseconds& time_since_epoch() const { return elapsed; }
+    uint32_t sec_since_epoch() const { return uint32_t(elapsed.count() / 1000000); }
+
+    bool operator>(const time_point& t) const { return elapsed._count > t.elapsed._count; }
+    bool operator>=(const time_point& t) const { return elapsed._count >= t.elapsed._count; }
+    bool operator<(const time_point& t) const { return elapsed._count < t.elapsed._count; }
+    bool operator<=(const time_point& t) const { return elapsed._count <= t.elapsed._count; }
+    bool operator==(const time_point& t) const { return elapsed._count == t.elapsed._count; }
+    bool operator!=(const time_point& t) const { return elapsed._count != t.elapsed._count; }
+
+    time_point& operator+=(const microseconds& m) { elapsed += m; return *this; }
+    time_point& operator-=(const microseconds& m) { elapsed -= m; return *this; }
+    time_point operator+(const microseconds& m) const { return time_point(elapsed + m); }
+    time_point operator-(const microseconds& m) const { return time_point(elapsed - m); }
+    microseconds operator-(const time_point& m) const { return microseconds(elapsed.count() - m.elapsed.count()); }
+
+    microseconds elapsed;
+};
+
+class time_point_sec {
+public:
+    time_point_sec(): utc_seconds(0) {}
+    explicit time_point_sec(uint32_t seconds): utc_seconds(seconds) {}
+    time_point_sec(const time_point& t): utc_seconds(t.sec_since_epoch()) {}
+
+    operator time_point() const { return time_point(eosio::seconds(utc_seconds)); }
+    uint32_t sec_since_epoch() const { return utc_seconds; }
+
+    bool operator==(const time_point_sec& t) const { return utc_seconds == t.utc_seconds; }
+    bool operator!=(const time_point_sec& t) const { return utc_seconds != t.utc_seconds; }
+    bool operator<(const time_point_sec& t) const { return utc_seconds < t.utc_seconds; }
+    bool operator>(const time_point_sec& t) const { return utc_seconds > t.utc_seconds; }
+
+    uint32_t utc_seconds;
+};
+
+} // namespace eosio
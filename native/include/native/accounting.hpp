@@ -0,0 +1,51 @@
+#pragma once
+
+#include <native/table_export.hpp>
+
+#include <casino/accounting.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace native {
+
+// Batch variants of casino/accounting.hpp for risk dashboards: withdraw limits of many (casino, token) pairs
+// and profit shares of many transfers at once. Inputs are stored as structure of arrays and the loops are
+// branchless, results are equal to the scalar functions element by element.
+struct withdraw_batch {
+    std::vector<name> casino;
+    std::vector<uint64_t> symbol; // raw symbol
+    std::vector<int64_t> balance;
+    std::vector<int64_t> allocated_bonus;
+    std::vector<int64_t> profits;
+    std::vector<int64_t> active_sessions;
+
+    size_t size() const { return balance.size(); }
+
+    void add(name casino_account, uint64_t symbol_raw, const casino::accounting::withdraw_state& state);
+    casino::accounting::withdraw_state state(size_t i) const;
+};
+
+struct withdraw_limits {
+    std::vector<int64_t> max_transfer;
+    std::vector<uint8_t> weekly;
+    std::vector<casino::accounting::status> error;
+
+    size_t size() const { return max_transfer.size(); }
+    casino::accounting::withdraw_limit limit(size_t i) const { return { max_transfer[i], weekly[i] != 0, error[i] }; }
+};
+
+// casino::accounting::max_withdraw of every pair
+withdraw_limits max_withdraw(const withdraw_batch& batch);
+
+// shares[i] = casino::accounting::profit_share(amounts[i], margins[i])
+void profit_shares(const int64_t* amounts, const uint32_t* margins, size_t count, int64_t* shares,
+                   casino::accounting::status* errors);
+
+// withdraw states of every token the given casinos have in their globaltokens, read from an export
+// of the platform, casino and token contract tables; a casino without globaltokens is skipped,
+// pending payouts of a token are taken off its balance
+withdraw_batch collect_withdraw_states(const export_reader& source, name platform, const std::vector<name>& casinos);
+
+} // namespace native
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <native/database.hpp>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace native {
+
+using bytes = std::vector<char>;
+using eosio::name;
+using eosio::permission_level;
+
+// calls a contract member function for a given receiver with packed action data
+using action_handler = std::function<void(name receiver, name code, const bytes& data)>;
+
+// dispatch table of a contract, host side counterpart of the apply() generated by eosio-cpp
+struct contract_abi {
+    std::map<name, action_handler> actions;
+    std::map<std::pair<name, name>, action_handler> notify; // (code, action), empty code is "*"
+    std::map<name, database::table_factory> tables; // row types of contract tables, to restore them from an export
+
+    template <typename Contract, typename... Args>
+    contract_abi& action(name action_name, void (Contract::*handler)(Args...)) {
+        actions[action_name] = make_handler(handler);
+        return *this;
+    }
+
+    template <typename Contract, typename... Args>
+    contract_abi& on_notify(name code, name action_name, void (Contract::*handler)(Args...)) {
+        notify[{code, action_name}] = make_handler(handler);
+        return *this;
+    }
+
+    // multi_index or singleton type
+    template <typename Table>
+    contract_abi& table() {
+        tables[Table::table_name()] = [] { return std::make_unique<typename Table::storage_type>(); };
+        return *this;
+    }
+
+    // contract is constructed for every action like in wasm, so its destructor flushes cached state
+    template <typename Contract, typename... Args>
+    static action_handler make_handler(void (Contract::*handler)(Args...)) {
+        return [handler](name receiver, name code, const bytes& data) {
+            std::tuple<std::decay_t<Args>...> args;
+            eosio::datastream<const char*> ds(data.data(), data.size());
+            ds >> args;
+
+            Contract contract(receiver, code, eosio::datastream<const char*>(data.data(), data.size()));
+            std::apply([&](auto&... a) { (contract.*handler)(a...); }, args);
+        };
+    }
+};
+
+// in-memory chain executing natively built contracts: accounts, contract tables, authorization,
+// notifications and inline actions. Intrinsics called by contract code are served by the chain
+// made current on the calling thread, so independent chains can run in parallel threads.
+class chain {
+public:
+    static constexpr uint32_t max_inline_action_depth = 4;
+
+    chain();
+    ~chain();
+
+    chain(const chain&) = delete;
+    chain& operator=(const chain&) = delete;
+
+    void make_current();
+    static chain& current();
+
+    void create_account(name account);
+    void create_accounts(const std::vector<name>& accounts);
+    bool is_account(name account) const;
+    // every name is treated as an existing account, for replaying history of accounts created elsewhere
+    void set_open_accounts(bool open) { _open_accounts = open; }
+
+    void set_code(name account, contract_abi abi);
+    // inline actions sent to `account` are handed to `sink` instead of being executed, e.g. to apply
+    // them on another chain later; they are handed out before the transaction is known to succeed
+    void set_inline_sink(name account, std::function<void(const eosio::action&)> sink);
+
+    // restores a packed row of a table listed in the abi of `code`
+    void load_row(name code, uint64_t scope, name table, const char* data, size_t size);
+
+    database& db() { return _db; }
+    const database& db() const { return _db; }
+
+    eosio::time_point now() const { return _now; }
+    void set_time(eosio::time_point t) { _now = t; }
+    void advance(eosio::microseconds delta) { _now += delta; }
+
+    // actions executed including notifications and inline actions
+    uint64_t executed_actions() const { return _executed_actions; }
+
+    // executes actions with their notifications and inline actions, state is rolled back if any of them fails
+    void push_transaction(const std::vector<eosio::action>& actions);
+
+    // returns error message or empty string, the same way base_tester::push_action does
+    std::string push_action(eosio::action act);
+
+    template <typename... Args>
+    std::string push_action(name code, name action_name, const permission_level& auth, Args&&... args) {
+        return push_action(eosio::action(auth, code, action_name, std::make_tuple(std::forward<Args>(args)...)));
+    }
+
+    template <typename... Args>
+    std::string push_action(name code, name action_name, name actor, Args&&... args) {
+        return push_action(code, action_name, permission_level{actor, "active"_n}, std::forward<Args>(args)...);
+    }
+
+    static std::string success() { return std::string(); }
+
+    // intrinsics
+    void require_auth(name account) const;
+    void require_auth(const permission_level& level) const;
+    bool has_auth(name account) const;
+    void require_recipient(name account);
+    void send_inline(eosio::action act);
+    name current_receiver() const;
+
+private:
+    struct apply_context {
+        name receiver;
+        const eosio::action& act;
+        std::vector<name>& recipients;
+        std::vector<eosio::action>& inlines;
+    };
+
+    void execute(const eosio::action& act, uint32_t depth);
+    void apply(const apply_context& ctx);
+    const apply_context& context() const;
+
+    database _db;
+    std::set<name> _accounts;
+    std::map<name, contract_abi> _code;
+    std::map<name, std::function<void(const eosio::action&)>> _inline_sinks;
+    eosio::time_point _now;
+    const apply_context* _context { nullptr };
+    uint64_t _executed_actions { 0 };
+    bool _open_accounts { false };
+};
+
+} // namespace native
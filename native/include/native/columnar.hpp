@@ -0,0 +1,164 @@
+#pragma once
+
+#include <native/table_export.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace native {
+
+// Columnar export of casino accounting tables for aggregations over millions of players.
+// Token maps are flattened to one row per (key, token), every column is split into chunks of
+// `group_rows` rows and each chunk is stored with the smallest of the encodings below together
+// with its min/max. Layout, little endian:
+//   header     magic "DCCOLEX1", uint32 version, uint32 tables, uint64 footer offset
+//   chunks     encoded column chunks, back to back
+//   footer     table entries, then column entries and chunk entries of every table in table order
+namespace columnar {
+
+constexpr char magic[8] = {'D', 'C', 'C', 'O', 'L', 'E', 'X', '1'};
+constexpr uint32_t version = 1;
+constexpr uint32_t default_group_rows = 1 << 16;
+
+// values are stored as 64 bit words, the type defines how stats compare and how values are printed
+enum class type : uint8_t { name, symbol, u64, i64 };
+
+enum class encoding : uint8_t {
+    plain, // raw 8 byte words
+    delta, // zigzag varints of differences to the previous value, sorted keys and small amounts
+    rle,   // runs of (varint length, zigzag varint value), token symbols and zeroes
+};
+
+struct header {
+    char magic[8];
+    uint32_t version;
+    uint32_t tables;
+    uint64_t footer_offset;
+};
+
+struct table_entry {
+    uint64_t table;
+    uint32_t columns;
+    uint32_t groups;
+    uint64_t rows;
+    uint64_t reserved;
+};
+
+struct column_entry {
+    char name[23];
+    type column_type;
+};
+
+struct chunk_entry {
+    uint64_t offset;
+    uint32_t size;
+    uint32_t rows;
+    encoding chunk_encoding;
+    uint8_t reserved[7];
+    uint64_t min;
+    uint64_t max;
+};
+
+static_assert(sizeof(header) == 24 && sizeof(table_entry) == 32 && sizeof(column_entry) == 24 && sizeof(chunk_entry) == 40);
+
+struct column {
+    std::string name;
+    type column_type;
+};
+
+// encoded chunk of values, the smallest encoding wins
+std::vector<char> encode(const uint64_t* values, size_t count, encoding& used);
+// throws std::runtime_error on malformed data
+void decode(const char* data, size_t size, encoding used, uint64_t* values, size_t count);
+
+// signed or unsigned order depending on the column type
+bool less(type column_type, uint64_t a, uint64_t b);
+
+} // namespace columnar
+
+// Streams a columnar export to disk, only one row group per column is kept in memory.
+class columnar_writer {
+public:
+    explicit columnar_writer(const std::string& path, uint32_t group_rows = columnar::default_group_rows);
+    ~columnar_writer();
+
+    columnar_writer(const columnar_writer&) = delete;
+    columnar_writer& operator=(const columnar_writer&) = delete;
+
+    void begin_table(name table, std::vector<columnar::column> columns);
+    // one value per column, std::logic_error otherwise
+    void add_row(const std::vector<uint64_t>& values);
+    void finish();
+
+private:
+    void flush_group();
+    void end_table();
+    void write(const void* data, size_t size);
+
+    std::FILE* _file { nullptr };
+    std::string _path;
+    uint32_t _group_rows;
+    uint64_t _offset { 0 };
+    std::vector<columnar::table_entry> _tables;
+    std::vector<std::vector<columnar::column_entry>> _columns;
+    std::vector<std::vector<columnar::chunk_entry>> _chunks;
+    std::vector<std::vector<uint64_t>> _group;
+    bool _finished { false };
+};
+
+// playertokens, gametokens and playerstats of a casino from a table export:
+//   playertokens  player, symbol, bonus_balance, volume_real, volume_bonus, profit_real, profit_bonus
+//   gametokens    game_id, symbol, balance, active_sessions_sum
+//   playerstats   player, sessions_created, symbol, volume_real, volume_bonus, profit_real, profit_bonus
+void write_columnar(const export_reader& source, name casino_account, const std::string& path,
+                    uint32_t group_rows = columnar::default_group_rows);
+
+// Reads the footer on open, chunks are read and decoded on demand.
+class columnar_reader {
+public:
+    struct table {
+        name table_name;
+        uint64_t rows;
+        std::vector<columnar::column> columns;
+        // groups x columns, row major
+        const columnar::chunk_entry* chunks;
+        uint32_t groups;
+
+        const columnar::chunk_entry& chunk(uint32_t group, size_t column) const {
+            return chunks[size_t(group) * columns.size() + column];
+        }
+        // throws std::runtime_error if there is no such column
+        size_t column_index(const std::string& column_name) const;
+        // min and max over all chunks of a column, {0, 0} for an empty table
+        std::pair<uint64_t, uint64_t> stats(size_t column) const;
+    };
+
+    explicit columnar_reader(const std::string& path);
+    ~columnar_reader();
+
+    columnar_reader(const columnar_reader&) = delete;
+    columnar_reader& operator=(const columnar_reader&) = delete;
+
+    const std::vector<table>& tables() const { return _tables; }
+    // throws std::runtime_error if the table is absent
+    const table& get_table(name table_name) const;
+
+    // decodes a chunk into `values`, resized to the chunk's rows
+    void read_chunk(const columnar::chunk_entry& chunk, std::vector<uint64_t>& values) const;
+
+    // Calls `visit(group, rows, columns)` for every row group with the given columns decoded,
+    // `columns[i]` points to the values of `column_indices[i]`. Groups rejected by `skip(group)` are not read.
+    using group_visitor = std::function<void(uint32_t group, size_t rows, const std::vector<const uint64_t*>& columns)>;
+    void scan(const table& t, const std::vector<size_t>& column_indices, const group_visitor& visit,
+              const std::function<bool(uint32_t group)>& skip = {}) const;
+
+private:
+    int _fd { -1 };
+    std::string _path;
+    std::vector<char> _footer;
+    std::vector<table> _tables;
+};
+
+} // namespace native
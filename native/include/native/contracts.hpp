@@ -0,0 +1,13 @@
+#pragma once
+
+#include <native/chain.hpp>
+
+namespace native {
+
+// dispatch tables of the natively built contracts, every contract action and table has to be listed here
+contract_abi platform_abi();
+contract_abi casino_abi();
+contract_abi events_abi();
+contract_abi token_abi();
+
+} // namespace native
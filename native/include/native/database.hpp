@@ -0,0 +1,221 @@
+#pragma once
+
+#include <eosio/check.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/name.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace native {
+
+struct table_base {
+    using row_visitor = std::function<void(uint64_t pk, const std::vector<char>& packed)>;
+
+    virtual ~table_base() = default;
+    virtual size_t size() const = 0;
+    // rows in primary key order, packed the way the chain stores them
+    virtual void for_each_row(const row_visitor& visitor) const = 0;
+    // inserts a packed row, used to restore tables from an export
+    virtual void load_row(const char* data, size_t size) = 0;
+
+    bool read_only { false };
+};
+
+// rows of a single (code, scope, table) kept as objects, secondary indices are ordered (key, primary) sets
+template <typename T, typename... Indices>
+struct table_storage: table_base {
+    using rows_type = std::map<uint64_t, T>;
+    using secondary_type = std::tuple<std::set<std::pair<typename Indices::secondary_key_type, uint64_t>>...>;
+
+    rows_type rows;
+    secondary_type secondary;
+
+    size_t size() const override { return rows.size(); }
+
+    void for_each_row(const row_visitor& visitor) const override {
+        for (const auto& [pk, row]: rows) {
+            visitor(pk, eosio::pack(row));
+        }
+    }
+
+    void load_row(const char* data, size_t size) override {
+        auto obj = eosio::unpack<T>(data, size);
+        eosio::check(rows.find(obj.primary_key()) == rows.end(), "duplicate primary key in restored rows");
+        insert(std::move(obj));
+    }
+
+    typename rows_type::iterator insert(T obj) {
+        const auto pk = obj.primary_key();
+        add_secondary(obj, pk, std::index_sequence_for<Indices...>{});
+        return rows.emplace(pk, std::move(obj)).first;
+    }
+
+    typename rows_type::iterator remove(typename rows_type::const_iterator it) {
+        remove_secondary(it->second, it->first, std::index_sequence_for<Indices...>{});
+        return rows.erase(it);
+    }
+
+    // row was changed in place from `old`
+    void update_secondary(const T& old, const T& updated, uint64_t pk) {
+        if constexpr (sizeof...(Indices) > 0) {
+            remove_secondary(old, pk, std::index_sequence_for<Indices...>{});
+            add_secondary(updated, pk, std::index_sequence_for<Indices...>{});
+        }
+    }
+
+private:
+    template <size_t I>
+    using index_type = typename std::tuple_element<I, std::tuple<Indices...>>::type;
+
+    template <size_t... I>
+    void add_secondary(const T& obj, uint64_t pk, std::index_sequence<I...>) {
+        (std::get<I>(secondary).emplace(typename index_type<I>::secondary_extractor_type()(obj), pk), ...);
+    }
+
+    template <size_t... I>
+    void remove_secondary(const T& obj, uint64_t pk, std::index_sequence<I...>) {
+        (std::get<I>(secondary).erase({typename index_type<I>::secondary_extractor_type()(obj), pk}), ...);
+    }
+};
+
+// all contract tables of an in-memory chain with an undo log used to roll back a failed transaction
+class database {
+public:
+    using table_key = std::tuple<uint64_t, uint64_t, uint64_t>; // code, scope, table
+    using tables_type = std::map<table_key, std::unique_ptr<table_base>>;
+    using table_factory = std::function<std::unique_ptr<table_base>()>;
+
+    struct row_write {
+        table_key table;
+        uint64_t primary_key;
+    };
+
+    struct table_key_hash {
+        size_t operator()(const table_key& k) const {
+            return std::get<0>(k) * 0x9E3779B97F4A7C15ULL ^ std::get<1>(k) * 0xC2B2AE3D27D4EB4FULL ^ std::get<2>(k);
+        }
+    };
+
+    template <typename Storage>
+    Storage& get_table(uint64_t code, uint64_t scope, uint64_t table) {
+        const table_key key{code, scope, table};
+        auto& cached = lookup[key];
+        if (!cached) {
+            cached = find_shared(key);
+        }
+        if (!cached) {
+            auto& ptr = tables[key];
+            if (!ptr) {
+                ptr = std::make_unique<Storage>();
+            }
+            cached = ptr.get();
+        }
+        auto* result = dynamic_cast<Storage*>(cached);
+        eosio::check(result != nullptr, "table is accessed with a different row type");
+        return *result;
+    }
+
+    const tables_type& get_tables() const { return tables; }
+
+    // makes every table read-only, multi_index writes fail with "db access violation"
+    void freeze() {
+        for (auto& table: tables) {
+            table.second->read_only = true;
+        }
+    }
+
+    // writable again, once no other database shares it
+    void thaw() {
+        for (auto& table: tables) {
+            table.second->read_only = false;
+        }
+    }
+
+    // tables of `code` are served from a frozen database that can be shared between threads,
+    // missing tables are created locally
+    void share(const database& frozen, uint64_t code) {
+        shared[code] = &frozen;
+        lookup.clear();
+    }
+
+    // a row of a missing table is restored into a table made by `make`
+    void load_row(const table_key& key, const table_factory& make, const char* data, size_t size) {
+        auto& ptr = tables[key];
+        if (!ptr) {
+            ptr = make();
+            lookup.erase(key);
+        }
+        ptr->load_row(data, size);
+    }
+
+    // rows written through multi_index are recorded while tracking is on, including writes
+    // of transactions rolled back later
+    void track_writes(bool track) {
+        tracking = track;
+        writes.clear();
+    }
+
+    void on_write(uint64_t code, uint64_t scope, uint64_t table, uint64_t primary_key) {
+        if (tracking) {
+            writes.push_back({ {code, scope, table}, primary_key });
+        }
+    }
+
+    std::vector<row_write> take_writes() {
+        return std::exchange(writes, {});
+    }
+
+    void on_undo(std::function<void()> undo) {
+        if (undo_enabled) {
+            undo_log.push_back(std::move(undo));
+        }
+    }
+
+    void start_undo() {
+        undo_log.clear();
+        undo_enabled = true;
+    }
+
+    void commit() {
+        undo_log.clear();
+        undo_enabled = false;
+    }
+
+    void rollback() {
+        for (auto it = undo_log.rbegin(); it != undo_log.rend(); ++it) {
+            (*it)();
+        }
+        commit();
+    }
+
+private:
+    table_base* find_shared(const table_key& key) const {
+        const auto db = shared.find(std::get<0>(key));
+        if (db == shared.end()) {
+            return nullptr;
+        }
+        const auto table = db->second->tables.find(key);
+        return table == db->second->tables.end() ? nullptr : table->second.get();
+    }
+
+    tables_type tables;
+    std::map<uint64_t, const database*> shared;
+    std::unordered_map<table_key, table_base*, table_key_hash> lookup; // hot path of every multi_index construction
+    std::vector<std::function<void()>> undo_log;
+    bool undo_enabled { false };
+    std::vector<row_write> writes;
+    bool tracking { false };
+};
+
+// served by the thread's current chain, see chain.hpp
+database& current_db();
+eosio::name current_receiver();
+
+} // namespace native
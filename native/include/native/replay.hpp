@@ -0,0 +1,99 @@
+#pragma once
+
+#include <native/chain.hpp>
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace native {
+namespace replay {
+
+// one recorded action, a line of the log:
+// <time> <account> <action> <actor>[@<permission>][,...] [<hex data>]
+// e.g. 2020-01-01T00:00:00.500 dao.casino sesupdate game.boy@active 0000000000e0a3c3...
+struct log_entry {
+    eosio::time_point time;
+    eosio::action act;
+    size_t line { 0 };
+};
+
+std::vector<log_entry> read_log(std::istream& in);
+// false for blank and comment lines, std::runtime_error for malformed ones
+bool parse_entry(const std::string& line, size_t line_number, log_entry& entry);
+void write_entry(std::ostream& out, const log_entry& entry);
+
+eosio::time_point parse_time(const std::string& str);
+std::string format_time(eosio::time_point time);
+
+std::string to_hex(const bytes& data);
+bytes from_hex(const std::string& hex);
+
+// accounts the recorded actions are replayed against
+struct replay_config {
+    name platform;
+    std::vector<name> casinos;
+    std::vector<name> events;
+    std::vector<name> tokens { "eosio.token"_n };
+    uint32_t threads { 1 };
+};
+
+struct failure {
+    size_t line;
+    std::string message;
+};
+
+struct shard_report {
+    std::vector<name> contracts;
+    uint64_t transactions { 0 };
+    uint64_t executed_actions { 0 };
+    double seconds { 0 };
+};
+
+struct replay_result {
+    uint64_t transactions { 0 };
+    uint64_t executed_actions { 0 }; // including notifications and inline actions
+    uint64_t skipped { 0 }; // not addressed to a replayed contract
+    double seconds { 0 };
+    std::vector<shard_report> shards;
+    std::vector<failure> failures; // ordered by line
+    std::vector<std::string> state; // sorted rows, see dump_tables
+};
+
+// Platform actions and token creation are replayed first, the resulting platform tables are
+// frozen and shared read-only by all shards. Casino and events accounts are independent and are
+// spread over worker threads, each thread replays its accounts in log order on its own chain.
+// Token balances are tracked for replayed contracts only, other accounts are funded on demand.
+// Inline actions the shards send to the platform (game listings of casinos) are applied to it
+// after all shards are done, in log order and after the whole platform history.
+class replayer {
+public:
+    explicit replayer(replay_config config);
+
+    replay_result run(const std::vector<log_entry>& log) const;
+
+private:
+    replay_config _config;
+};
+
+// balances of untracked accounts are unknown, the sender of a token transfer is assumed to hold
+// what it sends; called on the chain replaying the transfer before it's pushed
+void fund_sender(const eosio::action& transfer, const std::function<bool(name)>& tracked);
+
+// "<code> <scope> <table> <primary key> <hex row>" for every row of tables of `code`, an empty name is "."
+void dump_tables(const database& db, name code, std::vector<std::string>& out);
+
+struct state_diff {
+    std::vector<std::string> missing; // expected rows absent in the replayed state
+    std::vector<std::string> unexpected; // replayed rows absent in the expected state
+    std::vector<std::string> changed; // replayed rows with a different value
+
+    bool empty() const { return missing.empty() && unexpected.empty() && changed.empty(); }
+};
+
+state_diff diff_state(const std::vector<std::string>& expected, const std::vector<std::string>& actual);
+
+} // namespace replay
+} // namespace native
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <native/database.hpp>
+
+#include <eosio/datastream.hpp>
+#include <eosio/name.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace native {
+
+using eosio::name;
+
+// Binary export of contract tables read through mmap, rows stay packed the way the chain stores them
+// and are decoded on access. Layout, little endian:
+//   header     magic "DCTBLEX1", uint32 version, uint32 tables, uint64 directory offset
+//   row data   packed rows, back to back
+//   index      per table, 32 byte entries sorted by (scope, primary key): scope, pk, data offset, size
+//   directory  32 byte entries sorted by (code, table): code, table, rows, index offset
+namespace table_export {
+
+constexpr char magic[8] = {'D', 'C', 'T', 'B', 'L', 'E', 'X', '1'};
+constexpr uint32_t version = 1;
+
+struct header {
+    char magic[8];
+    uint32_t version;
+    uint32_t tables;
+    uint64_t directory_offset;
+};
+
+struct index_entry {
+    uint64_t scope;
+    uint64_t primary_key;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t reserved;
+};
+
+struct directory_entry {
+    uint64_t code;
+    uint64_t table;
+    uint64_t rows;
+    uint64_t index_offset;
+};
+
+static_assert(sizeof(header) == 24 && sizeof(index_entry) == 32 && sizeof(directory_entry) == 32);
+
+} // namespace table_export
+
+// Streams an export to disk, memory use doesn't depend on the number of rows: data goes to the file
+// and index entries to a temporary file appended on finish(). Tables have to be written in (code, table)
+// order and rows of a table in (scope, primary key) order, std::logic_error otherwise.
+class export_writer {
+public:
+    explicit export_writer(const std::string& path);
+    ~export_writer();
+
+    export_writer(const export_writer&) = delete;
+    export_writer& operator=(const export_writer&) = delete;
+
+    void begin_table(name code, name table);
+    void add_row(uint64_t scope, uint64_t primary_key, const char* data, size_t size);
+    void add_row(uint64_t scope, uint64_t primary_key, const std::vector<char>& data) {
+        add_row(scope, primary_key, data.data(), data.size());
+    }
+    void finish();
+
+private:
+    void write(const void* data, size_t size);
+
+    std::FILE* _file { nullptr };
+    std::FILE* _index { nullptr };
+    std::string _path;
+    uint64_t _offset { 0 };
+    std::vector<table_export::directory_entry> _directory;
+    std::optional<table_export::index_entry> _last;
+    bool _finished { false };
+};
+
+// tables of the given contracts
+void write_export(const database& db, const std::vector<name>& codes, const std::string& path);
+// the same into an open writer, after tables of smaller (code, table) and before larger ones
+void write_tables(export_writer& writer, const database& db, const std::vector<name>& codes);
+
+// "<code> <scope> <table> <primary key> <hex row>" lines as produced by replay::dump_tables
+void write_export(std::vector<std::string> dump_lines, const std::string& path);
+
+// a packed row pointing into the mapped file, valid while the reader is alive
+struct row_ref {
+    uint64_t scope;
+    uint64_t primary_key;
+    const char* data;
+    uint32_t size;
+
+    template <typename T>
+    T as() const {
+        return eosio::unpack<T>(data, size);
+    }
+};
+
+// rows of one (code, table) over all of its scopes
+class table_view {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = row_ref;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = row_ref;
+
+        iterator() = default;
+        iterator(const table_export::index_entry* entry, const char* base): _entry(entry), _base(base) {}
+
+        row_ref operator*() const {
+            return { _entry->scope, _entry->primary_key, _base + _entry->offset, _entry->size };
+        }
+        iterator& operator++() { ++_entry; return *this; }
+        iterator operator++(int) { auto result = *this; ++_entry; return result; }
+        iterator& operator--() { --_entry; return *this; }
+        iterator& operator+=(difference_type n) { _entry += n; return *this; }
+        iterator operator+(difference_type n) const { return { _entry + n, _base }; }
+        difference_type operator-(const iterator& other) const { return _entry - other._entry; }
+        bool operator==(const iterator& other) const { return _entry == other._entry; }
+        bool operator!=(const iterator& other) const { return _entry != other._entry; }
+        bool operator<(const iterator& other) const { return _entry < other._entry; }
+
+    private:
+        const table_export::index_entry* _entry { nullptr };
+        const char* _base { nullptr };
+    };
+
+    struct range {
+        iterator first;
+        iterator last;
+
+        iterator begin() const { return first; }
+        iterator end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+    };
+
+    table_view(name code, name table, const table_export::index_entry* index, size_t rows, const char* base):
+        _code(code), _table(table), _index(index), _rows(rows), _base(base) {}
+
+    name code() const { return _code; }
+    name table() const { return _table; }
+    size_t size() const { return _rows; }
+
+    iterator begin() const { return { _index, _base }; }
+    iterator end() const { return { _index + _rows, _base }; }
+
+    // first row with (scope, primary key) not less than the given one
+    iterator lower_bound(uint64_t scope, uint64_t primary_key = 0) const;
+
+    // rows of a scope with primary keys in [from, to]
+    range scan(uint64_t scope, uint64_t from = 0, uint64_t to = uint64_t(-1)) const;
+
+    std::optional<row_ref> find(uint64_t scope, uint64_t primary_key) const;
+
+private:
+    name _code;
+    name _table;
+    const table_export::index_entry* _index;
+    size_t _rows;
+    const char* _base;
+};
+
+// read-only mapping of an export file, only touched pages are loaded so memory use is bounded
+// by the page cache rather than by the file size
+class export_reader {
+public:
+    enum class access { random, sequential };
+
+    explicit export_reader(const std::string& path, access hint = access::random);
+    ~export_reader();
+
+    export_reader(const export_reader&) = delete;
+    export_reader& operator=(const export_reader&) = delete;
+
+    std::vector<table_view> tables() const;
+    std::optional<table_view> find_table(name code, name table) const;
+    // throws std::runtime_error if the table is absent
+    table_view get_table(name code, name table) const;
+
+    size_t file_size() const { return _size; }
+
+private:
+    table_view view(const table_export::directory_entry& entry) const;
+
+    const char* _data { nullptr };
+    size_t _size { 0 };
+    const table_export::directory_entry* _directory { nullptr };
+    uint32_t _tables { 0 };
+};
+
+} // namespace native
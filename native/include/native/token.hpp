@@ -0,0 +1,22 @@
+#pragma once
+
+#include <casino/token.hpp>
+#include <eosio/eosio.hpp>
+
+namespace native {
+
+// eosio.token emulation over the same tables the casino reads (casino/token.hpp)
+class eosio_token: public eosio::contract {
+public:
+    using eosio::contract::contract;
+
+    void create(eosio::name issuer, eosio::asset maximum_supply);
+    void issue(eosio::name to, eosio::asset quantity, const std::string& memo);
+    void transfer(eosio::name from, eosio::name to, eosio::asset quantity, const std::string& memo);
+
+private:
+    void sub_balance(eosio::name owner, eosio::asset value);
+    void add_balance(eosio::name owner, eosio::asset value);
+};
+
+} // namespace native
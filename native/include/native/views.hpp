@@ -0,0 +1,145 @@
+#pragma once
+
+#include <native/chain.hpp>
+#include <native/replay.hpp>
+
+#include <casino/casino.hpp>
+
+#include <atomic>
+#include <istream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace native {
+
+struct views_config {
+    name platform;
+    name casino;
+    std::vector<name> tokens { "eosio.token"_n };
+    uint64_t publish_every { 1000 }; // applied log entries between snapshots visible to readers
+    std::string checkpoint; // no checkpoints if empty
+    uint64_t checkpoint_every { 1000000 };
+    uint32_t player_shards { 1 << 16 };
+    uint32_t max_readers { 64 };
+};
+
+// Materialized views of a casino's playertokens, gametokens and globaltokens kept up to date from a stream
+// of recorded actions in the native_replay log format, read from a file or a pipe standing in for a node.
+// Actions are executed by the natively built contracts, so the views follow casino.cpp accounting exactly;
+// rows written by every action are copied into the views.
+//
+// A single writer thread applies the stream, readers see immutable snapshots published every `publish_every`
+// entries. Snapshots share unchanged player shards with the previous ones, readers take them without locks
+// through hazard pointers, one slot per reader. Checkpoints are table exports of the platform, casino and token
+// tables with the stream position, a restarted process restores one and continues from there.
+class casino_views {
+public:
+    using player_shard = std::unordered_map<uint64_t, std::shared_ptr<const casino::player_tokens_row>>;
+
+    struct snapshot {
+        uint64_t applied { 0 }; // log entries applied, failed ones included
+        eosio::time_point time; // of the last applied entry
+        casino::global_tokens_state global;
+        std::map<uint64_t, casino::game_tokens_row> games;
+        std::shared_ptr<const std::vector<std::shared_ptr<const player_shard>>> players;
+        uint64_t player_count { 0 };
+
+        const casino::player_tokens_row* find_player(name player) const;
+    };
+
+    // Reading handle of one thread, see read()
+    class reader {
+    public:
+        reader(reader&& other) noexcept;
+        ~reader();
+
+        reader(const reader&) = delete;
+        reader& operator=(const reader&) = delete;
+        reader& operator=(reader&&) = delete;
+
+        // calls `f(const snapshot&)` on the latest published snapshot, which stays alive until `f` returns
+        template <typename F>
+        auto read(F&& f) const {
+            const guard g(*this);
+            return f(*g.current);
+        }
+
+        std::optional<casino::player_tokens_row> player(name player) const;
+        std::optional<casino::game_tokens_row> game(uint64_t game_id) const;
+        casino::global_tokens_state global() const;
+        uint64_t applied() const;
+
+    private:
+        friend class casino_views;
+
+        struct guard {
+            explicit guard(const reader& r);
+            ~guard();
+
+            const reader& owner;
+            const snapshot* current;
+        };
+
+        reader(const casino_views* views, uint32_t slot): _views(views), _slot(slot) {}
+
+        const casino_views* _views;
+        uint32_t _slot;
+    };
+
+    explicit casino_views(views_config config);
+    // readers have to be destroyed before the views
+    ~casino_views();
+
+    casino_views(const casino_views&) = delete;
+    casino_views& operator=(const casino_views&) = delete;
+
+    // std::runtime_error if all `max_readers` slots are taken
+    reader make_reader() const;
+
+    // writer thread only
+    void restore(const std::string& checkpoint_path);
+    // true if the action succeeded, the error is in last_error() otherwise
+    bool apply(const replay::log_entry& entry);
+    // applies every entry of the stream until its end skipping the first `skip` ones, publishes on return;
+    // returns the number of applied entries
+    uint64_t consume(std::istream& in, uint64_t skip = 0);
+    void publish();
+    void checkpoint(const std::string& path) const;
+
+    uint64_t applied() const { return _applied; }
+    uint64_t failed() const { return _failed; }
+    const std::string& last_error() const { return _last_error; }
+
+private:
+    bool is_token(name account) const;
+    bool relevant(const eosio::action& act) const;
+    void update_player(uint64_t player);
+    void update_rows(const std::vector<database::row_write>& writes);
+    void rebuild();
+    void reclaim();
+
+    views_config _config;
+    chain _chain;
+
+    // writer side, published by copy
+    uint64_t _applied { 0 };
+    uint64_t _failed { 0 };
+    std::string _last_error;
+    eosio::time_point _time;
+    casino::global_tokens_state _global;
+    std::map<uint64_t, casino::game_tokens_row> _games;
+    std::vector<std::shared_ptr<player_shard>> _players;
+    std::vector<bool> _owned; // shard isn't shared with a published snapshot yet
+    uint64_t _player_count { 0 };
+
+    std::atomic<const snapshot*> _current { nullptr };
+    std::unique_ptr<std::atomic<const snapshot*>[]> _hazards;
+    mutable std::unique_ptr<std::atomic<bool>[]> _slots;
+    std::vector<const snapshot*> _retired;
+};
+
+} // namespace native
@@ -0,0 +1,147 @@
+#include <native/accounting.hpp>
+
+#include <platform/platform.hpp>
+#include <casino/casino.hpp>
+
+#include <algorithm>
+#include <set>
+
+namespace native {
+
+namespace {
+
+using casino::accounting::max_amount;
+using casino::accounting::status;
+
+// status of an eosio::asset range check as a byte, status::ok is zero
+inline uint8_t range(int64_t value, status underflow, status overflow) {
+    return value < -max_amount ? uint8_t(underflow) : value > max_amount ? uint8_t(overflow) : uint8_t(status::ok);
+}
+
+// results of failed checks are discarded, so they wrap instead of overflowing
+inline int64_t wrapping_add(int64_t a, int64_t b) {
+    return int64_t(uint64_t(a) + uint64_t(b));
+}
+
+inline int64_t wrapping_sub(int64_t a, int64_t b) {
+    return int64_t(uint64_t(a) - uint64_t(b));
+}
+
+inline uint8_t first_error(uint8_t a, uint8_t b) {
+    return a ? a : b;
+}
+
+} // namespace
+
+void withdraw_batch::add(name casino_account, uint64_t symbol_raw, const casino::accounting::withdraw_state& state) {
+    casino.push_back(casino_account);
+    symbol.push_back(symbol_raw);
+    balance.push_back(state.balance);
+    allocated_bonus.push_back(state.allocated_bonus);
+    profits.push_back(state.profits);
+    active_sessions.push_back(state.active_sessions);
+}
+
+casino::accounting::withdraw_state withdraw_batch::state(size_t i) const {
+    return { balance[i], allocated_bonus[i], profits[i], active_sessions[i] };
+}
+
+// both branches of casino::accounting::max_withdraw are computed for every pair and the result is selected
+withdraw_limits max_withdraw(const withdraw_batch& batch) {
+    const size_t count = batch.size();
+    withdraw_limits result;
+    result.max_transfer.resize(count);
+    result.weekly.resize(count);
+    result.error.resize(count);
+
+    const int64_t* __restrict balances = batch.balance.data();
+    const int64_t* __restrict allocated = batch.allocated_bonus.data();
+    const int64_t* __restrict profits_sums = batch.profits.data();
+    const int64_t* __restrict active = batch.active_sessions.data();
+    int64_t* __restrict max_transfer = result.max_transfer.data();
+    uint8_t* __restrict weekly = result.weekly.data();
+    status* __restrict errors = result.error.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        const int64_t account_balance = wrapping_sub(balances[i], allocated[i]);
+        const int64_t profits = std::max<int64_t>(profits_sums[i], 0);
+        const int64_t reserved = wrapping_add(active[i], profits);
+        const uint8_t base_error = first_error(
+            range(account_balance, status::subtraction_underflow, status::subtraction_overflow),
+            range(reserved, status::addition_underflow, status::addition_overflow));
+        const bool above_reserved = account_balance > reserved;
+
+        const int64_t without_active = wrapping_sub(account_balance, active[i]);
+        const int64_t free = wrapping_sub(without_active, profits);
+        const uint8_t free_error = first_error(
+            range(without_active, status::subtraction_underflow, status::subtraction_overflow),
+            range(free, status::subtraction_underflow, status::subtraction_overflow));
+
+        const int64_t above_profits = wrapping_sub(account_balance, profits);
+        const uint8_t weekly_error = account_balance <= profits ? uint8_t(status::profits_exceed_balance)
+            : range(above_profits, status::subtraction_underflow, status::subtraction_overflow);
+        const int64_t weekly_max = std::min(account_balance / 10, above_profits);
+
+        const uint8_t error = first_error(base_error, above_reserved ? free_error : weekly_error);
+        max_transfer[i] = error ? 0 : above_reserved ? free : weekly_max;
+        weekly[i] = !base_error && !above_reserved;
+        errors[i] = status(error);
+    }
+    return result;
+}
+
+void profit_shares(const int64_t* amounts, const uint32_t* margins, size_t count, int64_t* shares, status* errors) {
+    for (size_t i = 0; i < count; ++i) {
+        const auto share = casino::accounting::profit_share(amounts[i], margins[i]);
+        shares[i] = share.amount;
+        errors[i] = share.error;
+    }
+}
+
+withdraw_batch collect_withdraw_states(const export_reader& source, name platform, const std::vector<name>& casinos) {
+    const auto tokens = source.get_table(platform, "token"_n);
+    const auto amount = [](const std::map<uint64_t, int64_t>& values, uint64_t symbol_raw) {
+        const auto it = values.find(symbol_raw);
+        return it == values.end() ? int64_t(0) : it->second;
+    };
+
+    withdraw_batch batch;
+    for (const auto casino_account: casinos) {
+        const auto table = source.find_table(casino_account, "globaltokens"_n);
+        const auto row = table ? table->find(casino_account.value, "globaltokens"_n.value) : std::nullopt;
+        if (!row) {
+            continue;
+        }
+        const auto gtokens = row->as<casino::global_tokens_state>();
+        const auto casino_tokens = source.find_table(casino_account, "token"_n);
+        std::set<uint64_t> symbols;
+        for (const auto* values: {&gtokens.game_active_sessions_sum, &gtokens.game_profits_sum, &gtokens.total_allocated_bonus}) {
+            for (const auto& it: *values) {
+                symbols.insert(it.first);
+            }
+        }
+        for (const auto symbol_raw: symbols) {
+            const auto code = eosio::symbol(symbol_raw).code().raw();
+            // a token missing from the platform list or the casino's accounts counts as no balance
+            int64_t balance = 0;
+            if (const auto token = tokens.find(platform.value, code)) {
+                const auto accounts = source.find_table(token->as<platform::token_row>().contract, "accounts"_n);
+                if (const auto account = accounts ? accounts->find(casino_account.value, code) : std::nullopt) {
+                    balance = account->as<token::account>().balance.amount;
+                }
+            }
+            if (const auto token = casino_tokens ? casino_tokens->find(casino_account.value, code) : std::nullopt) {
+                balance = casino::accounting::available_balance(balance, token->as<casino::token_row>().pending_payouts.value_or(0)).amount;
+            }
+            batch.add(casino_account, symbol_raw, {
+                balance,
+                amount(gtokens.total_allocated_bonus, symbol_raw),
+                amount(gtokens.game_profits_sum, symbol_raw),
+                amount(gtokens.game_active_sessions_sum, symbol_raw)
+            });
+        }
+    }
+    return batch;
+}
+
+} // namespace native
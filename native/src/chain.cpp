@@ -0,0 +1,228 @@
+#include <native/chain.hpp>
+
+#include <algorithm>
+
+namespace native {
+
+static thread_local chain* current_chain = nullptr;
+
+chain::chain():
+    _now(eosio::seconds(1577836800)) // 2020-01-01
+{
+    create_accounts({"eosio"_n, "eosio.token"_n});
+    make_current();
+}
+
+chain::~chain() {
+    if (current_chain == this) {
+        current_chain = nullptr;
+    }
+}
+
+void chain::make_current() {
+    current_chain = this;
+}
+
+chain& chain::current() {
+    eosio::check(current_chain != nullptr, "no chain is current on this thread");
+    return *current_chain;
+}
+
+void chain::create_account(name account) {
+    eosio::check(_accounts.insert(account).second, "account " + account.to_string() + " already exists");
+}
+
+void chain::create_accounts(const std::vector<name>& accounts) {
+    for (const auto& account: accounts) {
+        create_account(account);
+    }
+}
+
+bool chain::is_account(name account) const {
+    return _open_accounts || _accounts.count(account) != 0;
+}
+
+void chain::set_code(name account, contract_abi abi) {
+    eosio::check(is_account(account), "account " + account.to_string() + " doesn't exist");
+    _code[account] = std::move(abi);
+}
+
+void chain::set_inline_sink(name account, std::function<void(const eosio::action&)> sink) {
+    _inline_sinks[account] = std::move(sink);
+}
+
+void chain::load_row(name code, uint64_t scope, name table, const char* data, size_t size) {
+    const auto abi = _code.find(code);
+    eosio::check(abi != _code.end(), "account " + code.to_string() + " has no contract");
+    const auto factory = abi->second.tables.find(table);
+    eosio::check(factory != abi->second.tables.end(), "table " + table.to_string() + " of " + code.to_string() + " is unknown");
+    _db.load_row({code.value, scope, table.value}, factory->second, data, size);
+}
+
+void chain::push_transaction(const std::vector<eosio::action>& actions) {
+    make_current();
+    _db.start_undo();
+    try {
+        for (const auto& act: actions) {
+            execute(act, 0);
+        }
+    } catch (...) {
+        _context = nullptr;
+        _db.rollback();
+        throw;
+    }
+    _db.commit();
+}
+
+std::string chain::push_action(eosio::action act) {
+    try {
+        push_transaction({std::move(act)});
+    } catch (const eosio::eosio_assert_error& e) {
+        return std::string("assertion failure with message: ") + e.what();
+    } catch (const std::exception& e) {
+        return e.what();
+    }
+    return success();
+}
+
+void chain::execute(const eosio::action& act, uint32_t depth) {
+    eosio::check(depth <= max_inline_action_depth, "max inline action depth per transaction reached");
+
+    // notifications are applied right after the action, inline actions after all of them
+    std::vector<name> recipients { act.account };
+    std::vector<eosio::action> inlines;
+    for (size_t i = 0; i < recipients.size(); ++i) {
+        const apply_context ctx { recipients[i], act, recipients, inlines };
+        const auto prev = _context;
+        _context = &ctx;
+        apply(ctx);
+        _context = prev;
+        ++_executed_actions;
+    }
+
+    for (const auto& inline_act: inlines) {
+        const auto sink = _inline_sinks.find(inline_act.account);
+        if (sink != _inline_sinks.end()) {
+            sink->second(inline_act);
+            continue;
+        }
+        execute(inline_act, depth + 1);
+    }
+}
+
+void chain::apply(const apply_context& ctx) {
+    const auto code = _code.find(ctx.receiver);
+    if (code == _code.end()) {
+        return;
+    }
+    const auto& abi = code->second;
+
+    if (ctx.receiver == ctx.act.account) {
+        const auto handler = abi.actions.find(ctx.act.name);
+        eosio::check(handler != abi.actions.end(), "unknown action " + ctx.act.name.to_string());
+        handler->second(ctx.receiver, ctx.act.account, ctx.act.data);
+        return;
+    }
+
+    auto handler = abi.notify.find({ctx.act.account, ctx.act.name});
+    if (handler == abi.notify.end()) {
+        handler = abi.notify.find({name(), ctx.act.name});
+    }
+    if (handler != abi.notify.end()) {
+        handler->second(ctx.receiver, ctx.act.account, ctx.act.data);
+    }
+}
+
+const chain::apply_context& chain::context() const {
+    eosio::check(_context != nullptr, "intrinsic called outside of an action");
+    return *_context;
+}
+
+void chain::require_auth(name account) const {
+    const auto& auths = context().act.authorization;
+    const auto it = std::find_if(auths.begin(), auths.end(), [&](const auto& auth) {
+        return auth.actor == account;
+    });
+    eosio::check(it != auths.end(), "missing authority of " + account.to_string());
+}
+
+void chain::require_auth(const permission_level& level) const {
+    const auto& auths = context().act.authorization;
+    const auto it = std::find(auths.begin(), auths.end(), level);
+    eosio::check(it != auths.end(), "missing authority of " + level.actor.to_string() + "/" + level.permission.to_string());
+}
+
+bool chain::has_auth(name account) const {
+    const auto& auths = context().act.authorization;
+    return std::any_of(auths.begin(), auths.end(), [&](const auto& auth) {
+        return auth.actor == account;
+    });
+}
+
+void chain::require_recipient(name account) {
+    auto& recipients = context().recipients;
+    if (std::find(recipients.begin(), recipients.end(), account) == recipients.end()) {
+        recipients.push_back(account);
+    }
+}
+
+void chain::send_inline(eosio::action act) {
+    const auto& ctx = context();
+    // contracts are assumed to have eosio.code permission, so they can only authorize on their own behalf
+    for (const auto& auth: act.authorization) {
+        eosio::check(auth.actor == ctx.receiver, "inline action authorized by " + auth.actor.to_string()
+                     + " is sent by " + ctx.receiver.to_string());
+    }
+    ctx.inlines.push_back(std::move(act));
+}
+
+name chain::current_receiver() const {
+    return _context ? _context->receiver : name();
+}
+
+database& current_db() {
+    return chain::current().db();
+}
+
+name current_receiver() {
+    return current_chain ? current_chain->current_receiver() : name();
+}
+
+} // namespace native
+
+
+namespace eosio {
+
+void require_auth(name account) {
+    native::chain::current().require_auth(account);
+}
+
+void require_auth(const permission_level& level) {
+    native::chain::current().require_auth(level);
+}
+
+bool has_auth(name account) {
+    return native::chain::current().has_auth(account);
+}
+
+bool is_account(name account) {
+    return native::chain::current().is_account(account);
+}
+
+void require_recipient(name notify_account) {
+    native::chain::current().require_recipient(notify_account);
+}
+
+void send_inline(action act) {
+    native::chain::current().send_inline(std::move(act));
+}
+
+time_point current_time_point() {
+    return native::chain::current().now();
+}
+
+name current_receiver() {
+    return native::current_receiver();
+}
+
+} // namespace eosio
@@ -0,0 +1,467 @@
+#include <native/columnar.hpp>
+
+#include <casino/casino.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace native {
+
+using namespace columnar;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "columnar entries are read in place");
+
+namespace {
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+constexpr uint64_t zigzag(uint64_t value) {
+    return (value << 1) ^ uint64_t(int64_t(value) >> 63);
+}
+
+constexpr uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+void put_varint(std::vector<char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+uint64_t get_varint(const char*& pos, const char* end) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos == end) {
+            throw std::runtime_error("truncated column chunk");
+        }
+        const auto byte = uint8_t(*pos++);
+        result |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return result;
+        }
+    }
+    throw std::runtime_error("malformed varint in column chunk");
+}
+
+} // namespace
+
+namespace columnar {
+
+std::vector<char> encode(const uint64_t* values, size_t count, encoding& used) {
+    std::vector<char> delta;
+    uint64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        put_varint(delta, zigzag(values[i] - previous));
+        previous = values[i];
+    }
+
+    std::vector<char> rle;
+    for (size_t i = 0; i < count;) {
+        size_t run = 1;
+        while (i + run < count && values[i + run] == values[i]) {
+            ++run;
+        }
+        put_varint(rle, run);
+        put_varint(rle, zigzag(values[i]));
+        i += run;
+    }
+
+    const auto plain_size = count * sizeof(uint64_t);
+    if (plain_size <= rle.size() && plain_size <= delta.size()) {
+        used = encoding::plain;
+        const auto* data = reinterpret_cast<const char*>(values);
+        return std::vector<char>(data, data + plain_size);
+    }
+    if (rle.size() <= delta.size()) {
+        used = encoding::rle;
+        return rle;
+    }
+    used = encoding::delta;
+    return delta;
+}
+
+void decode(const char* data, size_t size, encoding used, uint64_t* values, size_t count) {
+    const char* pos = data;
+    const char* end = data + size;
+    switch (used) {
+        case encoding::plain:
+            if (size != count * sizeof(uint64_t)) {
+                throw std::runtime_error("plain column chunk of a wrong size");
+            }
+            std::memcpy(values, data, size);
+            return;
+        case encoding::delta: {
+            uint64_t previous = 0;
+            for (size_t i = 0; i < count; ++i) {
+                previous += unzigzag(get_varint(pos, end));
+                values[i] = previous;
+            }
+            break;
+        }
+        case encoding::rle:
+            for (size_t i = 0; i < count;) {
+                const auto run = get_varint(pos, end);
+                const auto value = unzigzag(get_varint(pos, end));
+                if (run == 0 || run > count - i) {
+                    throw std::runtime_error("run out of column chunk bounds");
+                }
+                std::fill_n(values + i, run, value);
+                i += run;
+            }
+            break;
+        default:
+            throw std::runtime_error("unknown column encoding " + std::to_string(int(used)));
+    }
+    if (pos != end) {
+        throw std::runtime_error("trailing data in column chunk");
+    }
+}
+
+bool less(type column_type, uint64_t a, uint64_t b) {
+    return column_type == type::i64 ? int64_t(a) < int64_t(b) : a < b;
+}
+
+} // namespace columnar
+
+columnar_writer::columnar_writer(const std::string& path, uint32_t group_rows): _path(path), _group_rows(group_rows) {
+    if (!group_rows) {
+        throw std::logic_error("row group can't be empty");
+    }
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file) {
+        throw system_error("can't create", path);
+    }
+    const header placeholder {};
+    write(&placeholder, sizeof(placeholder));
+}
+
+columnar_writer::~columnar_writer() {
+    if (_file) {
+        std::fclose(_file);
+    }
+}
+
+void columnar_writer::write(const void* data, size_t size) {
+    if (size && std::fwrite(data, 1, size, _file) != size) {
+        throw system_error("can't write", _path);
+    }
+    _offset += size;
+}
+
+void columnar_writer::begin_table(name table, std::vector<column> columns) {
+    if (_finished) {
+        throw std::logic_error("export is finished");
+    }
+    if (columns.empty()) {
+        throw std::logic_error("table " + table.to_string() + " has no columns");
+    }
+    for (const auto& entry: _tables) {
+        if (entry.table == table.value) {
+            throw std::logic_error("table " + table.to_string() + " is written twice");
+        }
+    }
+    std::vector<column_entry> entries;
+    for (const auto& c: columns) {
+        column_entry entry {};
+        if (c.name.empty() || c.name.size() >= sizeof(entry.name)) {
+            throw std::logic_error("bad column name '" + c.name + "'");
+        }
+        std::memcpy(entry.name, c.name.data(), c.name.size());
+        entry.column_type = c.column_type;
+        entries.push_back(entry);
+    }
+    end_table();
+
+    _tables.push_back({ table.value, uint32_t(entries.size()), 0, 0, 0 });
+    _columns.push_back(std::move(entries));
+    _chunks.emplace_back();
+    _group.assign(columns.size(), {});
+    for (auto& values: _group) {
+        values.reserve(_group_rows);
+    }
+}
+
+void columnar_writer::add_row(const std::vector<uint64_t>& values) {
+    if (_tables.empty() || _finished) {
+        throw std::logic_error("row is added outside of a table");
+    }
+    if (values.size() != _group.size()) {
+        throw std::logic_error("row has " + std::to_string(values.size()) + " values, table has "
+                               + std::to_string(_group.size()) + " columns");
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        _group[i].push_back(values[i]);
+    }
+    _tables.back().rows++;
+    if (_group.front().size() == _group_rows) {
+        flush_group();
+    }
+}
+
+void columnar_writer::flush_group() {
+    if (_group.empty() || _group.front().empty()) {
+        return;
+    }
+    const auto& columns = _columns.back();
+    for (size_t i = 0; i < _group.size(); ++i) {
+        auto& values = _group[i];
+        const auto type = columns[i].column_type;
+        chunk_entry chunk {};
+        const auto data = encode(values.data(), values.size(), chunk.chunk_encoding);
+        chunk.offset = _offset;
+        chunk.size = data.size();
+        chunk.rows = values.size();
+        chunk.min = chunk.max = values.front();
+        for (const auto value: values) {
+            if (less(type, value, chunk.min)) chunk.min = value;
+            if (less(type, chunk.max, value)) chunk.max = value;
+        }
+        write(data.data(), data.size());
+        _chunks.back().push_back(chunk);
+        values.clear();
+    }
+    _tables.back().groups++;
+}
+
+void columnar_writer::end_table() {
+    flush_group();
+    _group.clear();
+}
+
+void columnar_writer::finish() {
+    if (_finished) {
+        return;
+    }
+    end_table();
+    _finished = true;
+
+    const uint64_t padding = 0;
+    write(&padding, ((_offset + 7) & ~uint64_t(7)) - _offset);
+
+    header h {};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version = version;
+    h.tables = _tables.size();
+    h.footer_offset = _offset;
+    write(_tables.data(), _tables.size() * sizeof(table_entry));
+    for (size_t i = 0; i < _tables.size(); ++i) {
+        write(_columns[i].data(), _columns[i].size() * sizeof(column_entry));
+        write(_chunks[i].data(), _chunks[i].size() * sizeof(chunk_entry));
+    }
+
+    if (std::fseek(_file, 0, SEEK_SET) != 0 || std::fwrite(&h, sizeof(h), 1, _file) != 1 || std::fflush(_file) != 0) {
+        throw system_error("can't write", _path);
+    }
+}
+
+void write_columnar(const export_reader& source, name casino_account, const std::string& path, uint32_t group_rows) {
+    const auto scope = casino_account.value;
+    // a missing table is written empty, so readers don't have to tell "no rows" from "not exported"
+    const auto rows = [&](name table) {
+        const auto view = source.find_table(casino_account, table);
+        return view ? view->scan(scope) : table_view::range {};
+    };
+    const auto amount = [](const std::map<uint64_t, int64_t>& values, uint64_t symbol_raw) {
+        const auto it = values.find(symbol_raw);
+        return it == values.end() ? uint64_t(0) : uint64_t(it->second);
+    };
+
+    columnar_writer writer(path, group_rows);
+
+    writer.begin_table("playertokens"_n, {
+        {"player", type::name}, {"symbol", type::symbol}, {"bonus_balance", type::i64}, {"volume_real", type::i64},
+        {"volume_bonus", type::i64}, {"profit_real", type::i64}, {"profit_bonus", type::i64},
+    });
+    for (const auto& row: rows("playertokens"_n)) {
+        const auto r = row.as<casino::player_tokens_row>();
+        std::set<uint64_t> symbols;
+        for (const auto* values: {&r.bonus_balance, &r.volume_real, &r.volume_bonus, &r.profit_real, &r.profit_bonus}) {
+            for (const auto& it: *values) {
+                symbols.insert(it.first);
+            }
+        }
+        for (const auto symbol_raw: symbols) {
+            writer.add_row({ r.player.value, symbol_raw, amount(r.bonus_balance, symbol_raw), amount(r.volume_real, symbol_raw),
+                amount(r.volume_bonus, symbol_raw), amount(r.profit_real, symbol_raw), amount(r.profit_bonus, symbol_raw) });
+        }
+    }
+
+    writer.begin_table("gametokens"_n, {
+        {"game_id", type::u64}, {"symbol", type::symbol}, {"balance", type::i64}, {"active_sessions_sum", type::i64},
+    });
+    for (const auto& row: rows("gametokens"_n)) {
+        const auto r = row.as<casino::game_tokens_row>();
+        std::set<uint64_t> symbols;
+        for (const auto* values: {&r.balance, &r.active_sessions_sum}) {
+            for (const auto& it: *values) {
+                symbols.insert(it.first);
+            }
+        }
+        for (const auto symbol_raw: symbols) {
+            writer.add_row({ r.game_id, symbol_raw, amount(r.balance, symbol_raw), amount(r.active_sessions_sum, symbol_raw) });
+        }
+    }
+
+    writer.begin_table("playerstats"_n, {
+        {"player", type::name}, {"sessions_created", type::u64}, {"symbol", type::symbol}, {"volume_real", type::i64},
+        {"volume_bonus", type::i64}, {"profit_real", type::i64}, {"profit_bonus", type::i64},
+    });
+    for (const auto& row: rows("playerstats"_n)) {
+        const auto r = row.as<casino::player_stats_row>();
+        writer.add_row({ r.player.value, r.sessions_created, r.volume_real.symbol.raw(), uint64_t(r.volume_real.amount),
+            uint64_t(r.volume_bonus.amount), uint64_t(r.profit_real.amount), uint64_t(r.profit_bonus.amount) });
+    }
+
+    writer.finish();
+}
+
+size_t columnar_reader::table::column_index(const std::string& column_name) const {
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].name == column_name) {
+            return i;
+        }
+    }
+    throw std::runtime_error("no column " + column_name + " in " + table_name.to_string());
+}
+
+std::pair<uint64_t, uint64_t> columnar_reader::table::stats(size_t column) const {
+    if (!groups) {
+        return { 0, 0 };
+    }
+    const auto type = columns.at(column).column_type;
+    auto result = std::make_pair(chunk(0, column).min, chunk(0, column).max);
+    for (uint32_t g = 1; g < groups; ++g) {
+        const auto& c = chunk(g, column);
+        if (less(type, c.min, result.first)) result.first = c.min;
+        if (less(type, result.second, c.max)) result.second = c.max;
+    }
+    return result;
+}
+
+columnar_reader::columnar_reader(const std::string& path): _path(path) {
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        throw system_error("can't open", path);
+    }
+    try {
+        struct stat st;
+        if (::fstat(_fd, &st) != 0) {
+            throw system_error("can't stat", path);
+        }
+        const uint64_t size = st.st_size;
+        header h {};
+        if (size < sizeof(h) || ::pread(_fd, &h, sizeof(h), 0) != sizeof(h) || std::memcmp(h.magic, magic, sizeof(magic)) != 0) {
+            throw std::runtime_error(path + ": not a columnar export");
+        }
+        if (h.version != version) {
+            throw std::runtime_error(path + ": unsupported columnar export version " + std::to_string(h.version));
+        }
+        if (h.footer_offset < sizeof(h) || h.footer_offset % 8 || h.footer_offset + uint64_t(h.tables) * sizeof(table_entry) > size) {
+            throw std::runtime_error(path + ": truncated footer");
+        }
+        _footer.resize(size - h.footer_offset);
+        if (::pread(_fd, _footer.data(), _footer.size(), h.footer_offset) != ssize_t(_footer.size())) {
+            throw system_error("can't read", path);
+        }
+
+        const auto* entries = reinterpret_cast<const table_entry*>(_footer.data());
+        uint64_t pos = h.tables * sizeof(table_entry);
+        for (uint32_t i = 0; i < h.tables; ++i) {
+            const auto& entry = entries[i];
+            const auto chunks = uint64_t(entry.groups) * entry.columns;
+            if (!entry.columns || pos + entry.columns * sizeof(column_entry) + chunks * sizeof(chunk_entry) > _footer.size()) {
+                throw std::runtime_error(path + ": truncated footer of " + name(entry.table).to_string());
+            }
+            table t { name(entry.table), entry.rows, {}, nullptr, entry.groups };
+            const auto* columns = reinterpret_cast<const column_entry*>(_footer.data() + pos);
+            for (uint32_t c = 0; c < entry.columns; ++c) {
+                t.columns.push_back({ std::string(columns[c].name, strnlen(columns[c].name, sizeof(columns[c].name))), columns[c].column_type });
+            }
+            pos += entry.columns * sizeof(column_entry);
+            t.chunks = reinterpret_cast<const chunk_entry*>(_footer.data() + pos);
+            pos += chunks * sizeof(chunk_entry);
+
+            for (size_t c = 0; c < t.columns.size(); ++c) {
+                uint64_t rows = 0;
+                for (uint32_t g = 0; g < t.groups; ++g) {
+                    const auto& chunk = t.chunk(g, c);
+                    if (chunk.offset + chunk.size > h.footer_offset || chunk.rows != t.chunk(g, 0).rows) {
+                        throw std::runtime_error(path + ": bad chunk " + std::to_string(g) + " of " + t.table_name.to_string() + "." + t.columns[c].name);
+                    }
+                    rows += chunk.rows;
+                }
+                if (rows != t.rows) {
+                    throw std::runtime_error(path + ": row count mismatch in " + t.table_name.to_string() + "." + t.columns[c].name);
+                }
+            }
+            _tables.push_back(std::move(t));
+        }
+    } catch (...) {
+        ::close(_fd);
+        throw;
+    }
+}
+
+columnar_reader::~columnar_reader() {
+    ::close(_fd);
+}
+
+const columnar_reader::table& columnar_reader::get_table(name table_name) const {
+    for (const auto& t: _tables) {
+        if (t.table_name == table_name) {
+            return t;
+        }
+    }
+    throw std::runtime_error("no table " + table_name.to_string() + " in the columnar export");
+}
+
+void columnar_reader::read_chunk(const chunk_entry& chunk, std::vector<uint64_t>& values) const {
+    values.resize(chunk.rows);
+    if (chunk.chunk_encoding == encoding::plain && chunk.size == chunk.rows * sizeof(uint64_t)) {
+        if (::pread(_fd, values.data(), chunk.size, chunk.offset) != ssize_t(chunk.size)) {
+            throw system_error("can't read", _path);
+        }
+        return;
+    }
+    thread_local std::vector<char> buffer;
+    buffer.resize(chunk.size);
+    if (::pread(_fd, buffer.data(), chunk.size, chunk.offset) != ssize_t(chunk.size)) {
+        throw system_error("can't read", _path);
+    }
+    decode(buffer.data(), buffer.size(), chunk.chunk_encoding, values.data(), values.size());
+}
+
+void columnar_reader::scan(const table& t, const std::vector<size_t>& column_indices, const group_visitor& visit,
+                           const std::function<bool(uint32_t group)>& skip) const {
+    for (const auto index: column_indices) {
+        if (index >= t.columns.size()) {
+            throw std::out_of_range("no column " + std::to_string(index) + " in " + t.table_name.to_string());
+        }
+    }
+    std::vector<std::vector<uint64_t>> values(column_indices.size());
+    std::vector<const uint64_t*> columns(column_indices.size());
+    for (uint32_t g = 0; g < t.groups; ++g) {
+        if (skip && skip(g)) {
+            continue;
+        }
+        for (size_t i = 0; i < column_indices.size(); ++i) {
+            read_chunk(t.chunk(g, column_indices.at(i)), values[i]);
+            columns[i] = values[i].data();
+        }
+        visit(g, t.chunk(g, 0).rows, columns);
+    }
+}
+
+} // namespace native
@@ -0,0 +1,145 @@
+#include <native/contracts.hpp>
+#include <native/token.hpp>
+
+#include <platform/platform.hpp>
+#include <casino/casino.hpp>
+#include <events/events.hpp>
+
+namespace native {
+
+contract_abi platform_abi() {
+    using contract = platform::platform;
+    contract_abi abi;
+    abi.action("setrsakey"_n, &contract::set_rsa_pubkey)
+       .action("setrsabin"_n, &contract::set_rsa_key)
+       .action("addcas"_n, &contract::add_casino)
+       .action("delcas"_n, &contract::del_casino)
+       .action("pausecas"_n, &contract::pause_casino)
+       .action("setcontrcas"_n, &contract::set_contract_casino)
+       .action("setmetacas"_n, &contract::set_meta_casino)
+       .action("setrsacas"_n, &contract::set_rsa_pubkey_casino)
+       .action("setrsacasbin"_n, &contract::set_rsa_key_casino)
+       .action("droprsastr"_n, &contract::drop_rsa_pubkey_string)
+       .action("patchcas"_n, &contract::patch_casino)
+       .action("patchcasinos"_n, &contract::patch_casinos)
+       .action("pausecasinos"_n, &contract::pause_casinos)
+       .action("addgame"_n, &contract::add_game)
+       .action("delgame"_n, &contract::del_game)
+       .action("pausegame"_n, &contract::pause_game)
+       .action("setcontrgame"_n, &contract::set_contract_game)
+       .action("setmetagame"_n, &contract::set_meta_game)
+       .action("setmargin"_n, &contract::set_profit_margin_game)
+       .action("setbenefic"_n, &contract::set_beneficiary_game)
+       .action("patchgame"_n, &contract::patch_game)
+       .action("patchgames"_n, &contract::patch_games)
+       .action("pausegames"_n, &contract::pause_games)
+       .action("addtoken"_n, &contract::add_token)
+       .action("deltoken"_n, &contract::del_token)
+       .action("banplayer"_n, &contract::ban_player)
+       .action("unbanplayer"_n, &contract::unban_player)
+       .action("migrateactiv"_n, &contract::migrate_active)
+       .action("dellistcas"_n, &contract::del_listings_casino)
+       .action("dellistgame"_n, &contract::del_listings_game)
+       .action("addlisting"_n, &contract::add_listing)
+       .action("dellisting"_n, &contract::del_listing);
+    abi.table<platform::version_singleton>()
+       .table<platform::global_singleton>()
+       .table<platform::casino_table>()
+       .table<platform::game_table>()
+       .table<platform::active_casino_table>()
+       .table<platform::active_game_table>()
+       .table<platform::listing_table>()
+       .table<platform::rsa_key_table>()
+       .table<platform::token_table>()
+       .table<platform::ban_list_table>();
+    return abi;
+}
+
+contract_abi casino_abi() {
+    using contract = casino::casino;
+    contract_abi abi;
+    abi.action("setplatform"_n, &contract::set_platform)
+       .action("addgame"_n, &contract::add_game)
+       .action("rmgame"_n, &contract::remove_game)
+       .action("setgameparam"_n, &contract::set_game_param)
+       .action("setowner"_n, &contract::set_owner)
+       .on_notify(name(), "transfer"_n, &contract::on_transfer)
+       .action("onloss"_n, &contract::on_loss)
+       .action("claimprofit"_n, &contract::claim_profit)
+       .action("withdraw"_n, &contract::withdraw)
+       .action("sesupdate"_n, &contract::session_update)
+       .action("sesclose"_n, &contract::session_close)
+       .action("sesnewdepo"_n, &contract::on_new_depo_legacy)
+       .action("sesnewdepo2"_n, &contract::on_new_depo)
+       .action("sespayout"_n, &contract::on_ses_payout)
+       .action("newsession"_n, &contract::on_new_session)
+       .action("newsessionpl"_n, &contract::on_new_session_player)
+       .action("pausegame"_n, &contract::pause_game)
+       .action("setadminbon"_n, &contract::set_bonus_admin)
+       .action("withdrawbon"_n, &contract::withdraw_bonus)
+       .action("sendbon"_n, &contract::send_bonus)
+       .action("subtractbon"_n, &contract::subtract_bonus)
+       .action("convertbon"_n, &contract::convert_bonus)
+       .action("convertbon.t"_n, &contract::convert_bonus_token)
+       .action("seslockbon"_n, &contract::session_lock_bonus)
+       .action("sesaddbon"_n, &contract::session_add_bonus)
+       .action("newplayer"_n, &contract::greet_new_player)
+       .action("newplayer.t"_n, &contract::greet_new_player_token)
+       .action("sendbon.b"_n, &contract::send_bonus_bulk)
+       .action("newplayer.b"_n, &contract::greet_new_players)
+       .action("convertbon.b"_n, &contract::convert_bonus_bulk)
+       .action("setgreetbon"_n, &contract::set_greeting_bonus)
+       .action("addgamenobon"_n, &contract::add_game_no_bonus)
+       .action("rmgamenobon"_n, &contract::remove_game_no_bonus)
+       .action("addtoken"_n, &contract::add_token)
+       .action("rmtoken"_n, &contract::remove_token)
+       .action("pausetoken"_n, &contract::pause_token)
+       .action("setpaythr"_n, &contract::set_payout_threshold)
+       .action("settle"_n, &contract::settle_payouts)
+       .action("migratetoken"_n, &contract::migrate_token)
+       .action("setgameparam2"_n, &contract::set_game_param_token)
+       .action("migratenobon"_n, &contract::migrate_no_bonus)
+       .action("migrateboard"_n, &contract::migrate_leaderboard)
+       .action("migrateparam"_n, &contract::migrate_game_params)
+       .action("synclisting"_n, &contract::sync_listing);
+    abi.table<casino::version_singleton>()
+       .table<casino::game_table>()
+       .table<casino::game_state_table>()
+       .table<casino::global_state_singleton>()
+       .table<casino::bonus_pool_state_singleton>()
+       .table<casino::bonus_balance_table>()
+       .table<casino::player_stats_table>()
+       .table<casino::games_no_bonus_table>()
+       .table<casino::token_table>()
+       .table<casino::pending_payout_table>()
+       .table<casino::game_tokens_table>()
+       .table<casino::global_tokens_singleton>()
+       .table<casino::player_tokens_table>()
+       .table<casino::leaderboard_table>()
+       .table<casino::daily_stats_table>()
+       .table<casino::game_params_table>()
+       .table<casino::game_param_token_table>();
+    return abi;
+}
+
+contract_abi events_abi() {
+    using contract = events::events;
+    contract_abi abi;
+    abi.action("setplatform"_n, &contract::set_platform)
+       .action("send"_n, &contract::send);
+    abi.table<events::version_singleton>()
+       .table<events::global_singleton>();
+    return abi;
+}
+
+contract_abi token_abi() {
+    contract_abi abi;
+    abi.action("create"_n, &eosio_token::create)
+       .action("issue"_n, &eosio_token::issue)
+       .action("transfer"_n, &eosio_token::transfer);
+    abi.table<token::accounts>()
+       .table<token::stats>();
+    return abi;
+}
+
+} // namespace native
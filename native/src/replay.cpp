@@ -0,0 +1,484 @@
+#include <native/replay.hpp>
+#include <native/contracts.hpp>
+
+#include <casino/token.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace native {
+namespace replay {
+
+using eosio::asset;
+
+namespace {
+
+// days since 1970-01-01 of a proleptic gregorian date
+int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+void civil_from_days(int64_t z, int& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (m <= 2));
+}
+
+std::vector<permission_level> parse_auth(const std::string& str) {
+    std::vector<permission_level> result;
+    std::istringstream in(str);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        const auto at = item.find('@');
+        const auto actor = item.substr(0, at);
+        const auto permission = at == std::string::npos ? std::string("active") : item.substr(at + 1);
+        result.emplace_back(name(actor), name(permission));
+    }
+    return result;
+}
+
+struct transfer_args {
+    name from;
+    name to;
+    asset quantity;
+    std::string memo;
+};
+
+// replays its accounts on a chain of its own, platform tables are read from the frozen base chain
+class shard {
+public:
+    shard(const replay_config& config, const chain& base, std::vector<name> contracts):
+        _config(config),
+        _contracts(std::move(contracts))
+    {
+        _chain.set_open_accounts(true);
+        _chain.db().share(base.db(), config.platform.value);
+        for (const auto& token: config.tokens) {
+            _chain.set_code(token, token_abi());
+        }
+        for (const auto& contract: _contracts) {
+            const bool is_casino = std::count(config.casinos.begin(), config.casinos.end(), contract) != 0;
+            _chain.set_code(contract, is_casino ? casino_abi() : events_abi());
+        }
+        // the platform is read-only here, e.g. game listings of casinos are applied to it afterwards
+        _chain.set_inline_sink(config.platform, [this](const eosio::action& act) { _sent.push_back(act); });
+    }
+
+    bool owns(name account) const {
+        return std::count(_contracts.begin(), _contracts.end(), account) != 0;
+    }
+
+    void push(const log_entry& entry) {
+        _chain.make_current();
+        _chain.set_time(entry.time);
+        if (is_token(entry.act.account) && entry.act.name == "transfer"_n) {
+            fund_sender(entry.act, [this](name account) { return owns(account); });
+        }
+        ++_report.transactions;
+        _sent.clear();
+        try {
+            _chain.push_transaction({entry.act});
+        } catch (const eosio::eosio_assert_error& e) {
+            _failures.push_back({entry.line, std::string("assertion failure with message: ") + e.what()});
+            return;
+        } catch (const std::exception& e) {
+            _failures.push_back({entry.line, e.what()});
+            return;
+        }
+        for (auto& act: _sent) {
+            _platform_actions.push_back({entry.time, std::move(act), entry.line});
+        }
+    }
+
+    void dump(std::vector<std::string>& out) const {
+        for (const auto& contract: _contracts) {
+            dump_tables(_chain.db(), contract, out);
+        }
+        // balances of the replayed contracts, other accounts are not tracked
+        std::vector<std::string> token_rows;
+        for (const auto& token: _config.tokens) {
+            dump_tables(_chain.db(), token, token_rows);
+        }
+        for (auto& row: token_rows) {
+            std::istringstream in(row);
+            std::string code, scope, table;
+            in >> code >> scope >> table;
+            if (table == "accounts" && owns(name(scope))) {
+                out.push_back(std::move(row));
+            }
+        }
+    }
+
+    shard_report report() const {
+        auto result = _report;
+        result.contracts = _contracts;
+        result.executed_actions = _chain.executed_actions();
+        return result;
+    }
+
+    const std::vector<failure>& failures() const { return _failures; }
+    // inline actions of successful transactions sent to the platform, in log order
+    const std::vector<log_entry>& platform_actions() const { return _platform_actions; }
+
+    void set_seconds(double seconds) { _report.seconds = seconds; }
+
+private:
+    bool is_token(name account) const {
+        return std::count(_config.tokens.begin(), _config.tokens.end(), account) != 0;
+    }
+
+    const replay_config& _config;
+    std::vector<name> _contracts;
+    chain _chain;
+    shard_report _report;
+    std::vector<failure> _failures;
+    std::vector<eosio::action> _sent;
+    std::vector<log_entry> _platform_actions;
+};
+
+} // namespace
+
+bool parse_entry(const std::string& line, size_t line_number, log_entry& entry) {
+    const auto begin = line.find_first_not_of(" \t\r");
+    if (begin == std::string::npos || line[begin] == '#') {
+        return false;
+    }
+
+    std::istringstream fields(line);
+    std::string time, account, action_name, auth, data;
+    fields >> time >> account >> action_name >> auth >> data;
+    try {
+        eosio::check(!auth.empty(), "expected <time> <account> <action> <authorization> [<hex data>]");
+        entry.time = parse_time(time);
+        entry.act.account = name(account);
+        entry.act.name = name(action_name);
+        entry.act.authorization = parse_auth(auth);
+        entry.act.data = from_hex(data);
+        entry.line = line_number;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("line " + std::to_string(line_number) + ": " + e.what());
+    }
+    return true;
+}
+
+std::vector<log_entry> read_log(std::istream& in) {
+    std::vector<log_entry> result;
+    std::string line;
+    size_t line_number = 0;
+    log_entry entry;
+    while (std::getline(in, line)) {
+        if (parse_entry(line, ++line_number, entry)) {
+            result.push_back(std::move(entry));
+        }
+    }
+    return result;
+}
+
+void fund_sender(const eosio::action& transfer, const std::function<bool(name)>& tracked) {
+    const auto args = eosio::unpack<transfer_args>(transfer.data);
+    if (tracked(args.from) || args.quantity.amount <= 0) {
+        return;
+    }
+    ::token::accounts accounts(transfer.account, args.from.value);
+    const auto it = accounts.find(args.quantity.symbol.code().raw());
+    if (it == accounts.end()) {
+        accounts.emplace(transfer.account, [&](auto& row) {
+            row.balance = args.quantity;
+        });
+    } else if (it->balance.symbol == args.quantity.symbol && it->balance.amount < args.quantity.amount) {
+        accounts.modify(it, eosio::same_payer, [&](auto& row) {
+            row.balance.amount = args.quantity.amount;
+        });
+    }
+}
+
+void write_entry(std::ostream& out, const log_entry& entry) {
+    out << format_time(entry.time) << ' ' << entry.act.account.to_string() << ' ' << entry.act.name.to_string() << ' ';
+    for (size_t i = 0; i < entry.act.authorization.size(); ++i) {
+        const auto& auth = entry.act.authorization[i];
+        out << (i ? "," : "") << auth.actor.to_string() << '@' << auth.permission.to_string();
+    }
+    if (!entry.act.data.empty()) {
+        out << ' ' << to_hex(entry.act.data);
+    }
+    out << '\n';
+}
+
+eosio::time_point parse_time(const std::string& str) {
+    int year = 0;
+    unsigned month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    int consumed = 0;
+    const auto parsed = std::sscanf(str.c_str(), "%d-%u-%uT%u:%u:%u%n", &year, &month, &day, &hour, &minute, &second, &consumed);
+    eosio::check(parsed == 6 && month >= 1 && month <= 12 && day >= 1 && day <= 31 && hour < 24 && minute < 60 && second < 60,
+                 "invalid time " + str + ", expected YYYY-MM-DDTHH:MM:SS[.mmm]");
+
+    int64_t micros = 0;
+    if (size_t(consumed) < str.size()) {
+        eosio::check(str[consumed] == '.' && size_t(consumed) + 1 < str.size(), "invalid time " + str);
+        int64_t scale = 100000;
+        for (size_t i = consumed + 1; i < str.size(); ++i) {
+            eosio::check(std::isdigit(static_cast<unsigned char>(str[i])) && scale > 0, "invalid time " + str);
+            micros += (str[i] - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    const auto seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return eosio::time_point(eosio::microseconds(seconds * 1000000 + micros));
+}
+
+std::string format_time(eosio::time_point time) {
+    const auto micros = time.time_since_epoch().count();
+    const auto seconds = micros / 1000000;
+    int year = 0;
+    unsigned month = 0, day = 0;
+    civil_from_days(seconds / 86400, year, month, day);
+
+    const auto of_day = seconds % 86400;
+    char buf[80]; // fits the widest values of every field
+    std::snprintf(buf, sizeof(buf), "%04d-%02u-%02uT%02u:%02u:%02u.%03u", year, month, day,
+                  unsigned(of_day / 3600), unsigned(of_day % 3600 / 60), unsigned(of_day % 60),
+                  unsigned(micros % 1000000 / 1000));
+    return buf;
+}
+
+std::string to_hex(const bytes& data) {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(data.size() * 2);
+    for (const auto c: data) {
+        result.push_back(digits[uint8_t(c) >> 4]);
+        result.push_back(digits[uint8_t(c) & 0xf]);
+    }
+    return result;
+}
+
+bytes from_hex(const std::string& hex) {
+    eosio::check(hex.size() % 2 == 0, "odd number of hex digits");
+    const auto digit = [](char c) -> uint8_t {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        eosio::check(false, std::string("invalid hex digit ") + c);
+        return 0;
+    };
+    bytes result(hex.size() / 2);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = char(digit(hex[2 * i]) << 4 | digit(hex[2 * i + 1]));
+    }
+    return result;
+}
+
+replayer::replayer(replay_config config):
+    _config(std::move(config))
+{
+    eosio::check(_config.platform != name(), "platform account is not set");
+    eosio::check(_config.threads > 0, "at least one thread is required");
+}
+
+replay_result replayer::run(const std::vector<log_entry>& log) const {
+    const auto started = std::chrono::steady_clock::now();
+    const auto is_token = [&](name account) {
+        return std::count(_config.tokens.begin(), _config.tokens.end(), account) != 0;
+    };
+
+    std::set<name> sharded(_config.casinos.begin(), _config.casinos.end());
+    sharded.insert(_config.events.begin(), _config.events.end());
+
+    // which replayed contract an entry belongs to, empty for the base chain
+    std::vector<name> owner(log.size());
+    std::vector<bool> skipped(log.size(), false);
+    std::vector<bool> broadcast(log.size(), false);
+    std::map<name, uint64_t> load;
+    for (size_t i = 0; i < log.size(); ++i) {
+        const auto& act = log[i].act;
+        if (act.account == _config.platform) {
+            continue;
+        }
+        if (is_token(act.account)) {
+            if (act.name == "transfer"_n) {
+                const auto args = eosio::unpack<transfer_args>(act.data);
+                owner[i] = sharded.count(args.from) ? args.from : sharded.count(args.to) ? args.to : name();
+                skipped[i] = owner[i] == name();
+            } else {
+                broadcast[i] = act.name == "create"_n || act.name == "issue"_n;
+                skipped[i] = !broadcast[i];
+            }
+        } else if (sharded.count(act.account)) {
+            owner[i] = act.account;
+        } else {
+            skipped[i] = true;
+        }
+        if (owner[i] != name()) {
+            ++load[owner[i]];
+        }
+    }
+
+    replay_result result;
+
+    // platform history first, it is frozen and shared by the shards afterwards
+    chain base;
+    base.set_open_accounts(true);
+    base.set_code(_config.platform, platform_abi());
+    for (const auto& token: _config.tokens) {
+        base.set_code(token, token_abi());
+    }
+    for (size_t i = 0; i < log.size(); ++i) {
+        if (owner[i] != name() || skipped[i]) {
+            continue;
+        }
+        base.set_time(log[i].time);
+        ++result.transactions;
+        const auto error = base.push_action(log[i].act);
+        if (!error.empty()) {
+            result.failures.push_back({log[i].line, error});
+        }
+    }
+    base.db().freeze();
+
+    // the busiest contracts go first, each one to the least loaded thread
+    std::vector<std::pair<uint64_t, name>> by_load;
+    for (const auto& [contract, actions]: load) {
+        by_load.emplace_back(actions, contract);
+    }
+    std::sort(by_load.begin(), by_load.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    const size_t threads = std::max<size_t>(1, std::min<size_t>(_config.threads, by_load.size()));
+    std::vector<std::vector<name>> assignment(threads);
+    std::vector<uint64_t> assigned_load(threads, 0);
+    for (const auto& [actions, contract]: by_load) {
+        const auto least = std::min_element(assigned_load.begin(), assigned_load.end()) - assigned_load.begin();
+        assignment[least].push_back(contract);
+        assigned_load[least] += actions;
+    }
+
+    std::vector<std::unique_ptr<shard>> shards;
+    std::map<name, size_t> shard_of;
+    for (size_t s = 0; s < threads; ++s) {
+        shards.push_back(std::make_unique<shard>(_config, base, assignment[s]));
+        for (const auto& contract: assignment[s]) {
+            shard_of[contract] = s;
+        }
+    }
+
+    std::vector<std::thread> workers;
+    for (size_t s = 0; s < threads; ++s) {
+        workers.emplace_back([&, s] {
+            const auto shard_started = std::chrono::steady_clock::now();
+            auto& sh = *shards[s];
+            for (size_t i = 0; i < log.size(); ++i) {
+                if (broadcast[i] || (owner[i] != name() && shard_of.at(owner[i]) == s)) {
+                    sh.push(log[i]);
+                }
+            }
+            sh.set_seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - shard_started).count());
+        });
+    }
+    for (auto& worker: workers) {
+        worker.join();
+    }
+
+    // platform actions sent by the shards, attributed to the lines that sent them
+    std::vector<log_entry> sent;
+    for (const auto& sh: shards) {
+        sent.insert(sent.end(), sh->platform_actions().begin(), sh->platform_actions().end());
+    }
+    std::stable_sort(sent.begin(), sent.end(), [](const auto& a, const auto& b) {
+        return a.line < b.line;
+    });
+    base.db().thaw();
+    for (const auto& entry: sent) {
+        base.set_time(entry.time);
+        const auto error = base.push_action(entry.act);
+        if (!error.empty()) {
+            result.failures.push_back({entry.line, error});
+        }
+    }
+
+    result.executed_actions = base.executed_actions();
+    result.skipped = std::count(skipped.begin(), skipped.end(), true);
+    dump_tables(base.db(), _config.platform, result.state);
+    for (const auto& sh: shards) {
+        auto report = sh->report();
+        result.transactions += report.transactions;
+        result.executed_actions += report.executed_actions;
+        result.shards.push_back(std::move(report));
+        result.failures.insert(result.failures.end(), sh->failures().begin(), sh->failures().end());
+        sh->dump(result.state);
+    }
+
+    std::stable_sort(result.failures.begin(), result.failures.end(), [](const auto& a, const auto& b) {
+        return a.line < b.line;
+    });
+    std::sort(result.state.begin(), result.state.end());
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+void dump_tables(const database& db, name code, std::vector<std::string>& out) {
+    // an empty name, e.g. scope 0, is written as "." to keep the columns
+    const auto text = [](uint64_t value) {
+        const auto result = name(value).to_string();
+        return result.empty() ? std::string(".") : result;
+    };
+    const auto first = db.get_tables().lower_bound({code.value, 0, 0});
+    for (auto it = first; it != db.get_tables().end() && std::get<0>(it->first) == code.value; ++it) {
+        const auto prefix = code.to_string() + ' ' + text(std::get<1>(it->first)) + ' ' + text(std::get<2>(it->first)) + ' ';
+        it->second->for_each_row([&](uint64_t pk, const bytes& packed) {
+            out.push_back(prefix + std::to_string(pk) + ' ' + to_hex(packed));
+        });
+    }
+}
+
+state_diff diff_state(const std::vector<std::string>& expected, const std::vector<std::string>& actual) {
+    // rows are keyed by everything before the hex value
+    const auto by_key = [](const std::vector<std::string>& rows) {
+        std::map<std::string, std::string> result;
+        for (const auto& row: rows) {
+            const auto space = row.rfind(' ');
+            result[row.substr(0, space)] = space == std::string::npos ? std::string() : row.substr(space + 1);
+        }
+        return result;
+    };
+    const auto expected_rows = by_key(expected);
+    const auto actual_rows = by_key(actual);
+
+    state_diff result;
+    for (const auto& [key, value]: expected_rows) {
+        const auto it = actual_rows.find(key);
+        if (it == actual_rows.end()) {
+            result.missing.push_back(key + ' ' + value);
+        } else if (it->second != value) {
+            result.changed.push_back(key + ' ' + it->second);
+        }
+    }
+    for (const auto& [key, value]: actual_rows) {
+        if (!expected_rows.count(key)) {
+            result.unexpected.push_back(key + ' ' + value);
+        }
+    }
+    return result;
+}
+
+} // namespace replay
+} // namespace native
@@ -0,0 +1,311 @@
+#include <native/table_export.hpp>
+#include <native/replay.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace native {
+
+using namespace table_export;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "export entries are mapped in place");
+
+namespace {
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+constexpr uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+} // namespace
+
+export_writer::export_writer(const std::string& path): _path(path) {
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file) {
+        throw system_error("can't create", path);
+    }
+    _index = std::tmpfile();
+    if (!_index) {
+        std::fclose(_file);
+        throw system_error("can't create index for", path);
+    }
+    const header placeholder {};
+    write(&placeholder, sizeof(placeholder));
+}
+
+export_writer::~export_writer() {
+    if (_file) {
+        std::fclose(_file);
+    }
+    if (_index) {
+        std::fclose(_index);
+    }
+}
+
+void export_writer::write(const void* data, size_t size) {
+    if (size && std::fwrite(data, 1, size, _file) != size) {
+        throw system_error("can't write", _path);
+    }
+    _offset += size;
+}
+
+void export_writer::begin_table(name code, name table) {
+    if (_finished) {
+        throw std::logic_error("export is finished");
+    }
+    if (!_directory.empty()) {
+        const auto& last = _directory.back();
+        if (std::tie(last.code, last.table) >= std::make_tuple(code.value, table.value)) {
+            throw std::logic_error("tables have to be written in (code, table) order: " + code.to_string() + " " + table.to_string());
+        }
+    }
+    _directory.push_back({ code.value, table.value, 0, 0 });
+    _last.reset();
+}
+
+void export_writer::add_row(uint64_t scope, uint64_t primary_key, const char* data, size_t size) {
+    if (_directory.empty() || _finished) {
+        throw std::logic_error("row is added outside of a table");
+    }
+    if (_last && std::tie(_last->scope, _last->primary_key) >= std::tie(scope, primary_key)) {
+        throw std::logic_error("rows have to be written in (scope, primary key) order");
+    }
+    const index_entry entry { scope, primary_key, _offset, uint32_t(size), 0 };
+    write(data, size);
+    if (std::fwrite(&entry, sizeof(entry), 1, _index) != 1) {
+        throw system_error("can't write index for", _path);
+    }
+    _directory.back().rows++;
+    _last = entry;
+}
+
+void export_writer::finish() {
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+
+    const uint64_t padding = 0;
+    write(&padding, align8(_offset) - _offset);
+
+    // index entries were appended in table order, so every table's entries are contiguous
+    const auto index_offset = _offset;
+    for (auto& entry: _directory) {
+        entry.index_offset = index_offset;
+    }
+    uint64_t rows = 0;
+    for (auto& entry: _directory) {
+        entry.index_offset += rows * sizeof(index_entry);
+        rows += entry.rows;
+    }
+
+    std::rewind(_index);
+    char buffer[1 << 16];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), _index)) > 0) {
+        write(buffer, read);
+    }
+
+    header h {};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version = version;
+    h.tables = _directory.size();
+    h.directory_offset = _offset;
+    write(_directory.data(), _directory.size() * sizeof(directory_entry));
+
+    if (std::fseek(_file, 0, SEEK_SET) != 0 || std::fwrite(&h, sizeof(h), 1, _file) != 1 || std::fflush(_file) != 0) {
+        throw system_error("can't write", _path);
+    }
+}
+
+void write_export(const database& db, const std::vector<name>& codes, const std::string& path) {
+    export_writer writer(path);
+    write_tables(writer, db, codes);
+    writer.finish();
+}
+
+void write_tables(export_writer& writer, const database& db, const std::vector<name>& codes) {
+    // database is ordered by (code, scope, table), the export by (code, table, scope)
+    std::vector<database::table_key> keys;
+    for (const auto& it: db.get_tables()) {
+        // tables left empty by erased rows don't exist on chain
+        if (it.second->size() && std::count(codes.begin(), codes.end(), name(std::get<0>(it.first)))) {
+            keys.push_back(it.first);
+        }
+    }
+    std::sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<0>(a), std::get<2>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<2>(b), std::get<1>(b));
+    });
+
+    std::optional<std::pair<uint64_t, uint64_t>> current;
+    for (const auto& key: keys) {
+        const auto [code, scope, table] = key;
+        if (!current || *current != std::make_pair(code, table)) {
+            writer.begin_table(name(code), name(table));
+            current = std::make_pair(code, table);
+        }
+        db.get_tables().at(key)->for_each_row([&, scope = scope](uint64_t pk, const std::vector<char>& packed) {
+            writer.add_row(scope, pk, packed);
+        });
+    }
+}
+
+void write_export(std::vector<std::string> dump_lines, const std::string& path) {
+    struct row {
+        uint64_t code, table, scope, pk;
+        size_t line;
+    };
+    std::vector<row> rows;
+    rows.reserve(dump_lines.size());
+    for (size_t i = 0; i < dump_lines.size(); ++i) {
+        std::istringstream in(dump_lines[i]);
+        std::string code, scope, table;
+        uint64_t pk;
+        if (!(in >> code >> scope >> table >> pk)) {
+            throw std::runtime_error("line " + std::to_string(i + 1) + ": expected <code> <scope> <table> <primary key> <hex row>");
+        }
+        rows.push_back({ name(code).value, name(table).value, name(scope).value, pk, i });
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.code, a.table, a.scope, a.pk) < std::tie(b.code, b.table, b.scope, b.pk);
+    });
+
+    export_writer writer(path);
+    const row* previous = nullptr;
+    for (const auto& r: rows) {
+        if (!previous || previous->code != r.code || previous->table != r.table) {
+            writer.begin_table(name(r.code), name(r.table));
+        }
+        const auto& line = dump_lines[r.line];
+        const auto hex = line.substr(line.find_last_of(' ') + 1);
+        writer.add_row(r.scope, r.pk, replay::from_hex(hex));
+        previous = &r;
+    }
+    writer.finish();
+}
+
+table_view::iterator table_view::lower_bound(uint64_t scope, uint64_t primary_key) const {
+    const auto* it = std::lower_bound(_index, _index + _rows, std::make_pair(scope, primary_key), [](const auto& entry, const auto& key) {
+        return std::make_pair(entry.scope, entry.primary_key) < key;
+    });
+    return { it, _base };
+}
+
+table_view::range table_view::scan(uint64_t scope, uint64_t from, uint64_t to) const {
+    const auto first = lower_bound(scope, from);
+    auto last = first;
+    if (to == uint64_t(-1)) {
+        last = scope == uint64_t(-1) ? end() : lower_bound(scope + 1, 0);
+    } else {
+        last = lower_bound(scope, to + 1);
+    }
+    return { first, std::max(first, last) };
+}
+
+std::optional<row_ref> table_view::find(uint64_t scope, uint64_t primary_key) const {
+    const auto it = lower_bound(scope, primary_key);
+    if (it == end()) {
+        return {};
+    }
+    const auto row = *it;
+    if (row.scope != scope || row.primary_key != primary_key) {
+        return {};
+    }
+    return row;
+}
+
+export_reader::export_reader(const std::string& path, access hint) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw system_error("can't open", path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw system_error("can't stat", path);
+    }
+    _size = st.st_size;
+    if (_size < sizeof(header)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a table export");
+    }
+    void* mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw system_error("can't map", path);
+    }
+    _data = static_cast<const char*>(mapped);
+    ::madvise(mapped, _size, hint == access::sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+    const auto* h = reinterpret_cast<const header*>(_data);
+    const auto fail = [&](const std::string& what) {
+        ::munmap(const_cast<char*>(_data), _size);
+        return std::runtime_error(path + ": " + what);
+    };
+    if (std::memcmp(h->magic, magic, sizeof(magic)) != 0) {
+        throw fail("not a table export");
+    }
+    if (h->version != version) {
+        throw fail("unsupported export version " + std::to_string(h->version));
+    }
+    if (h->directory_offset % 8 || h->directory_offset + uint64_t(h->tables) * sizeof(directory_entry) > _size) {
+        throw fail("truncated table directory");
+    }
+    _directory = reinterpret_cast<const directory_entry*>(_data + h->directory_offset);
+    _tables = h->tables;
+    for (uint32_t i = 0; i < _tables; ++i) {
+        const auto& entry = _directory[i];
+        if (entry.index_offset % 8 || entry.index_offset + entry.rows * sizeof(index_entry) > h->directory_offset) {
+            throw fail("truncated index of " + name(entry.code).to_string() + " " + name(entry.table).to_string());
+        }
+    }
+}
+
+export_reader::~export_reader() {
+    ::munmap(const_cast<char*>(_data), _size);
+}
+
+table_view export_reader::view(const directory_entry& entry) const {
+    return { name(entry.code), name(entry.table), reinterpret_cast<const index_entry*>(_data + entry.index_offset), entry.rows, _data };
+}
+
+std::vector<table_view> export_reader::tables() const {
+    std::vector<table_view> result;
+    for (uint32_t i = 0; i < _tables; ++i) {
+        result.push_back(view(_directory[i]));
+    }
+    return result;
+}
+
+std::optional<table_view> export_reader::find_table(name code, name table) const {
+    const auto* end = _directory + _tables;
+    const auto* it = std::lower_bound(_directory, end, std::make_pair(code.value, table.value), [](const auto& entry, const auto& key) {
+        return std::make_pair(entry.code, entry.table) < key;
+    });
+    if (it == end || it->code != code.value || it->table != table.value) {
+        return {};
+    }
+    return view(*it);
+}
+
+table_view export_reader::get_table(name code, name table) const {
+    const auto result = find_table(code, table);
+    if (!result) {
+        throw std::runtime_error("no table " + code.to_string() + " " + table.to_string() + " in the export");
+    }
+    return *result;
+}
+
+} // namespace native
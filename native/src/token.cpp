@@ -0,0 +1,93 @@
+#include <native/token.hpp>
+
+namespace native {
+
+using eosio::asset;
+using eosio::check;
+using eosio::name;
+
+void eosio_token::create(name issuer, asset maximum_supply) {
+    require_auth(get_self());
+
+    const auto sym = maximum_supply.symbol;
+    check(sym.is_valid(), "invalid symbol name");
+    check(maximum_supply.is_valid(), "invalid supply");
+    check(maximum_supply.amount > 0, "max-supply must be positive");
+
+    ::token::stats statstable(get_self(), sym.code().raw());
+    check(statstable.find(sym.code().raw()) == statstable.end(), "token with symbol already exists");
+
+    statstable.emplace(get_self(), [&](auto& s) {
+        s.supply.symbol = maximum_supply.symbol;
+        s.max_supply = maximum_supply;
+        s.issuer = issuer;
+    });
+}
+
+void eosio_token::issue(name to, asset quantity, const std::string& memo) {
+    const auto sym = quantity.symbol;
+    check(memo.size() <= 256, "memo has more than 256 bytes");
+
+    ::token::stats statstable(get_self(), sym.code().raw());
+    const auto& st = statstable.get(sym.code().raw(), "token with symbol does not exist, create token before issue");
+    check(to == st.issuer, "tokens can only be issued to issuer account");
+
+    require_auth(st.issuer);
+    check(quantity.is_valid(), "invalid quantity");
+    check(quantity.amount > 0, "must issue positive quantity");
+    check(quantity.symbol == st.supply.symbol, "symbol precision mismatch");
+    check(quantity.amount <= st.max_supply.amount - st.supply.amount, "quantity exceeds available supply");
+
+    statstable.modify(st, eosio::same_payer, [&](auto& s) {
+        s.supply += quantity;
+    });
+    add_balance(st.issuer, quantity);
+}
+
+void eosio_token::transfer(name from, name to, asset quantity, const std::string& memo) {
+    check(from != to, "cannot transfer to self");
+    require_auth(from);
+    check(eosio::is_account(to), "to account does not exist");
+
+    const auto sym = quantity.symbol.code();
+    ::token::stats statstable(get_self(), sym.raw());
+    const auto& st = statstable.get(sym.raw());
+
+    eosio::require_recipient(from);
+    eosio::require_recipient(to);
+
+    check(quantity.is_valid(), "invalid quantity");
+    check(quantity.amount > 0, "must transfer positive quantity");
+    check(quantity.symbol == st.supply.symbol, "symbol precision mismatch");
+    check(memo.size() <= 256, "memo has more than 256 bytes");
+
+    sub_balance(from, quantity);
+    add_balance(to, quantity);
+}
+
+void eosio_token::sub_balance(name owner, asset value) {
+    ::token::accounts from_acnts(get_self(), owner.value);
+
+    const auto& from = from_acnts.get(value.symbol.code().raw(), "no balance object found");
+    check(from.balance.amount >= value.amount, "overdrawn balance");
+
+    from_acnts.modify(from, owner, [&](auto& a) {
+        a.balance -= value;
+    });
+}
+
+void eosio_token::add_balance(name owner, asset value) {
+    ::token::accounts to_acnts(get_self(), owner.value);
+    auto to = to_acnts.find(value.symbol.code().raw());
+    if (to == to_acnts.end()) {
+        to_acnts.emplace(get_self(), [&](auto& a) {
+            a.balance = value;
+        });
+    } else {
+        to_acnts.modify(to, eosio::same_payer, [&](auto& a) {
+            a.balance += value;
+        });
+    }
+}
+
+} // namespace native
@@ -0,0 +1,340 @@
+#include <native/views.hpp>
+#include <native/contracts.hpp>
+#include <native/table_export.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace native {
+
+namespace {
+
+constexpr name position_table = "position"_n;
+
+size_t shard_of(uint64_t player, size_t shards) {
+    return (player * 0x9E3779B97F4A7C15ULL >> 32) % shards;
+}
+
+struct transfer_args {
+    name from;
+    name to;
+    eosio::asset quantity;
+    std::string memo;
+};
+
+} // namespace
+
+const casino::player_tokens_row* casino_views::snapshot::find_player(name player) const {
+    const auto& shard = *(*players)[shard_of(player.value, players->size())];
+    const auto it = shard.find(player.value);
+    return it == shard.end() ? nullptr : it->second.get();
+}
+
+casino_views::reader::guard::guard(const reader& r): owner(r) {
+    const auto& views = *r._views;
+    auto& hazard = views._hazards[r._slot];
+    current = views._current.load(std::memory_order_acquire);
+    while (true) {
+        hazard.store(current, std::memory_order_seq_cst);
+        // the snapshot could have been retired before the hazard was visible to the writer
+        const auto* again = views._current.load(std::memory_order_seq_cst);
+        if (again == current) {
+            break;
+        }
+        current = again;
+    }
+}
+
+casino_views::reader::guard::~guard() {
+    owner._views->_hazards[owner._slot].store(nullptr, std::memory_order_release);
+}
+
+casino_views::reader::reader(reader&& other) noexcept: _views(other._views), _slot(other._slot) {
+    other._views = nullptr;
+}
+
+casino_views::reader::~reader() {
+    if (_views) {
+        _views->_slots[_slot].store(false, std::memory_order_release);
+    }
+}
+
+std::optional<casino::player_tokens_row> casino_views::reader::player(name player) const {
+    return read([&](const snapshot& s) -> std::optional<casino::player_tokens_row> {
+        const auto* row = s.find_player(player);
+        if (!row) {
+            return {};
+        }
+        return *row;
+    });
+}
+
+std::optional<casino::game_tokens_row> casino_views::reader::game(uint64_t game_id) const {
+    return read([&](const snapshot& s) -> std::optional<casino::game_tokens_row> {
+        const auto it = s.games.find(game_id);
+        if (it == s.games.end()) {
+            return {};
+        }
+        return it->second;
+    });
+}
+
+casino::global_tokens_state casino_views::reader::global() const {
+    return read([](const snapshot& s) { return s.global; });
+}
+
+uint64_t casino_views::reader::applied() const {
+    return read([](const snapshot& s) { return s.applied; });
+}
+
+casino_views::casino_views(views_config config):
+    _config(std::move(config)),
+    _hazards(new std::atomic<const snapshot*>[_config.max_readers]),
+    _slots(new std::atomic<bool>[_config.max_readers])
+{
+    eosio::check(_config.platform != name() && _config.casino != name(), "platform and casino accounts have to be set");
+    eosio::check(_config.player_shards > 0 && _config.publish_every > 0 && _config.checkpoint_every > 0,
+                 "shards and intervals can't be zero");
+
+    for (uint32_t i = 0; i < _config.max_readers; ++i) {
+        _hazards[i].store(nullptr);
+        _slots[i].store(false);
+    }
+
+    _chain.set_open_accounts(true);
+    _chain.set_code(_config.platform, platform_abi());
+    _chain.set_code(_config.casino, casino_abi());
+    for (const auto& token: _config.tokens) {
+        _chain.set_code(token, token_abi());
+    }
+    _chain.db().track_writes(true);
+
+    rebuild();
+    publish();
+}
+
+casino_views::~casino_views() {
+    delete _current.load();
+    for (const auto* s: _retired) {
+        delete s;
+    }
+}
+
+casino_views::reader casino_views::make_reader() const {
+    for (uint32_t i = 0; i < _config.max_readers; ++i) {
+        bool expected = false;
+        if (_slots[i].compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return reader(this, i);
+        }
+    }
+    throw std::runtime_error("all " + std::to_string(_config.max_readers) + " reader slots are taken");
+}
+
+bool casino_views::is_token(name account) const {
+    return std::count(_config.tokens.begin(), _config.tokens.end(), account) != 0;
+}
+
+// platform and casino actions, token creation and transfers of the casino
+bool casino_views::relevant(const eosio::action& act) const {
+    if (act.account == _config.platform || act.account == _config.casino) {
+        return true;
+    }
+    if (!is_token(act.account)) {
+        return false;
+    }
+    if (act.name == "transfer"_n) {
+        const auto args = eosio::unpack<transfer_args>(act.data);
+        return args.from == _config.casino || args.to == _config.casino;
+    }
+    return act.name == "create"_n || act.name == "issue"_n;
+}
+
+bool casino_views::apply(const replay::log_entry& entry) {
+    _chain.make_current();
+    _chain.set_time(entry.time);
+
+    bool succeeded = true;
+    if (relevant(entry.act)) {
+        try {
+            if (is_token(entry.act.account) && entry.act.name == "transfer"_n) {
+                replay::fund_sender(entry.act, [&](name account) { return account == _config.casino; });
+            }
+            _chain.push_transaction({entry.act});
+        } catch (const eosio::eosio_assert_error& e) {
+            succeeded = false;
+            _last_error = "line " + std::to_string(entry.line) + ": assertion failure with message: " + e.what();
+        } catch (const std::exception& e) {
+            succeeded = false;
+            _last_error = "line " + std::to_string(entry.line) + ": " + e.what();
+        }
+    }
+    // rows written by a failed transaction are rolled back, reading them again is harmless
+    update_rows(_chain.db().take_writes());
+
+    _failed += !succeeded;
+    _time = entry.time;
+    if (++_applied % _config.publish_every == 0) {
+        publish();
+    }
+    if (!_config.checkpoint.empty() && _applied % _config.checkpoint_every == 0) {
+        checkpoint(_config.checkpoint);
+    }
+    return succeeded;
+}
+
+uint64_t casino_views::consume(std::istream& in, uint64_t skip) {
+    std::string line;
+    size_t line_number = 0;
+    uint64_t entries = 0, applied = 0;
+    replay::log_entry entry;
+    while (std::getline(in, line)) {
+        if (!replay::parse_entry(line, ++line_number, entry) || entries++ < skip) {
+            continue;
+        }
+        apply(entry);
+        ++applied;
+    }
+    publish();
+    return applied;
+}
+
+void casino_views::update_player(uint64_t player) {
+    const auto shard = shard_of(player, _players.size());
+    if (!_owned[shard]) {
+        _players[shard] = std::make_shared<player_shard>(*_players[shard]);
+        _owned[shard] = true;
+    }
+    auto& rows = *_players[shard];
+
+    casino::player_tokens_table player_tokens(_config.casino, _config.casino.value);
+    const auto it = player_tokens.find(player);
+    if (it == player_tokens.end()) {
+        _player_count -= rows.erase(player);
+        return;
+    }
+    auto& row = rows[player];
+    _player_count += !row;
+    row = std::make_shared<const casino::player_tokens_row>(*it);
+}
+
+void casino_views::update_rows(const std::vector<database::row_write>& writes) {
+    std::vector<std::pair<uint64_t, uint64_t>> changed; // (table, primary key) of the casino's own scope
+    for (const auto& write: writes) {
+        const auto [code, scope, table] = write.table;
+        if (code == _config.casino.value && scope == _config.casino.value) {
+            changed.emplace_back(table, write.primary_key);
+        }
+    }
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    for (const auto& [table, pk]: changed) {
+        if (table == "playertokens"_n.value) {
+            update_player(pk);
+        } else if (table == "gametokens"_n.value) {
+            casino::game_tokens_table game_tokens(_config.casino, _config.casino.value);
+            const auto it = game_tokens.find(pk);
+            if (it == game_tokens.end()) {
+                _games.erase(pk);
+            } else {
+                _games[pk] = *it;
+            }
+        } else if (table == "globaltokens"_n.value) {
+            _global = casino::global_tokens_singleton(_config.casino, _config.casino.value).get_or_default();
+        }
+    }
+}
+
+void casino_views::rebuild() {
+    _chain.make_current();
+    _players.clear();
+    for (uint32_t i = 0; i < _config.player_shards; ++i) {
+        _players.push_back(std::make_shared<player_shard>());
+    }
+    _owned.assign(_config.player_shards, true);
+    _player_count = 0;
+
+    casino::player_tokens_table player_tokens(_config.casino, _config.casino.value);
+    for (const auto& row: player_tokens) {
+        (*_players[shard_of(row.player.value, _players.size())])[row.player.value] = std::make_shared<const casino::player_tokens_row>(row);
+        ++_player_count;
+    }
+    _games.clear();
+    casino::game_tokens_table game_tokens(_config.casino, _config.casino.value);
+    for (const auto& row: game_tokens) {
+        _games[row.game_id] = row;
+    }
+    _global = casino::global_tokens_singleton(_config.casino, _config.casino.value).get_or_default();
+}
+
+void casino_views::publish() {
+    auto* next = new snapshot { _applied, _time, _global, _games,
+        std::make_shared<const std::vector<std::shared_ptr<const player_shard>>>(_players.begin(), _players.end()), _player_count };
+    _owned.assign(_owned.size(), false);
+
+    if (const auto* previous = _current.exchange(next, std::memory_order_seq_cst)) {
+        _retired.push_back(previous);
+    }
+    reclaim();
+}
+
+// snapshots retired by publish() are deleted once no reader holds them
+void casino_views::reclaim() {
+    std::vector<const snapshot*> held;
+    for (uint32_t i = 0; i < _config.max_readers; ++i) {
+        held.push_back(_hazards[i].load(std::memory_order_seq_cst));
+    }
+    const auto released = std::partition(_retired.begin(), _retired.end(), [&](const snapshot* s) {
+        return std::count(held.begin(), held.end(), s) != 0;
+    });
+    for (auto it = released; it != _retired.end(); ++it) {
+        delete *it;
+    }
+    _retired.erase(released, _retired.end());
+}
+
+void casino_views::checkpoint(const std::string& path) const {
+    const auto temp = path + ".tmp";
+    {
+        export_writer writer(temp);
+        // the position table has an empty code, so it comes first
+        writer.begin_table(name(), position_table);
+        writer.add_row(0, 0, eosio::pack(std::make_tuple(_applied, _failed, _time.time_since_epoch().count())));
+
+        std::vector<name> codes { _config.platform, _config.casino };
+        codes.insert(codes.end(), _config.tokens.begin(), _config.tokens.end());
+        write_tables(writer, _chain.db(), codes);
+        writer.finish();
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("can't replace checkpoint " + path);
+    }
+}
+
+void casino_views::restore(const std::string& checkpoint_path) {
+    eosio::check(_applied == 0, "views can be restored before any entry is applied only");
+    const export_reader reader(checkpoint_path, export_reader::access::sequential);
+    const auto position = reader.get_table(name(), position_table).find(0, 0);
+    eosio::check(position.has_value(), checkpoint_path + " has no stream position");
+
+    _chain.make_current();
+    for (const auto& table: reader.tables()) {
+        if (table.code() == name()) {
+            continue;
+        }
+        for (const auto& row: table) {
+            _chain.load_row(table.code(), row.scope, table.table(), row.data, row.size);
+        }
+    }
+    const auto [applied, failed, micros] = position->as<std::tuple<uint64_t, uint64_t, int64_t>>();
+    _applied = applied;
+    _failed = failed;
+    _time = eosio::time_point(eosio::microseconds(micros));
+
+    _chain.db().take_writes();
+    rebuild();
+    publish();
+}
+
+} // namespace native
@@ -0,0 +1,145 @@
+#include "native_tester.hpp"
+
+#include <native/accounting.hpp>
+#include <native/table_export.hpp>
+
+#include <cstdio>
+#include <random>
+
+#include <unistd.h>
+
+
+namespace testing {
+
+namespace accounting = casino::accounting;
+
+// the core is usable in constant expressions
+static_assert(accounting::profit_share(1001, 50).amount == 500);
+static_assert(accounting::profit_share(-1001, 50).amount == -500);
+static_assert(accounting::profit_share(accounting::max_amount, 2).error == accounting::status::multiplication_overflow);
+static_assert(accounting::max_withdraw({ 1000, 100, 200, 300 }).max_transfer == 400);
+static_assert(accounting::max_withdraw({ 1000, 0, 500, 600 }).weekly);
+static_assert(accounting::max_withdraw({ 1000, 0, 500, 600 }).max_transfer == 100);
+static_assert(accounting::max_withdraw({ 1000, 0, -500, 2000 }).max_transfer == 100);
+static_assert(accounting::max_withdraw({ 1000, 0, 1000, 0 }).error == accounting::status::profits_exceed_balance);
+static_assert(accounting::check_claim(accounting::useconds_per_month + 1, 0) == accounting::status::ok);
+static_assert(accounting::check_lock_bonus(11, 10) == accounting::status::lock_exceeds_bonus_balance);
+
+class accounting_tester : public native_tester {
+public:
+    static constexpr name game_account = "game.boy"_n;
+
+    std::string export_path;
+
+    accounting_tester() {
+        char path[] = "/tmp/native_accounting_XXXXXX";
+        ::close(::mkstemp(path));
+        export_path = path;
+
+        chain.set_time(eosio::time_point(eosio::seconds(1577836800)));
+        add_game(game_account, 0);
+        require_success(transfer(system_account, game_account, asset(1000000, core_symbol)));
+        // half of it is the game developer's profit
+        require_success(transfer(game_account, casino_account, asset(30000, core_symbol)));
+        require_success(transfer(system_account, casino_account, asset(10000, core_symbol)));
+        require_success(transfer(system_account, casino_account, asset(5000, core_symbol), "bonus"));
+    }
+
+    ~accounting_tester() {
+        std::remove(export_path.c_str());
+    }
+
+    accounting::withdraw_limit limit() {
+        write_export(chain.db(), {platform_name, casino_account, "eosio.token"_n}, export_path);
+        const export_reader reader(export_path);
+        const auto batch = collect_withdraw_states(reader, platform_name, {casino_account, "nocasino"_n});
+        BOOST_REQUIRE_EQUAL(batch.size(), 1);
+        BOOST_REQUIRE(batch.casino[0] == casino_account);
+        BOOST_REQUIRE_EQUAL(batch.symbol[0], core_symbol.raw());
+        const auto limits = max_withdraw(batch);
+        return limits.limit(0);
+    }
+
+    std::string withdraw(int64_t amount) {
+        return chain.push_action(casino_account, "withdraw"_n, casino_account, system_account, asset(amount, core_symbol));
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(accounting_tests)
+
+BOOST_AUTO_TEST_CASE(batch_matches_scalar) {
+    std::mt19937_64 random(38);
+    const int64_t edges[] = { 0, 1, -1, 10, 1000, accounting::max_amount, -accounting::max_amount, accounting::max_amount / 2 };
+    const auto value = [&](int64_t bound) -> int64_t {
+        if (random() % 8 == 0) {
+            return edges[random() % std::size(edges)];
+        }
+        return int64_t(random() % uint64_t(2 * bound + 1)) - bound;
+    };
+
+    native::withdraw_batch batch;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        // small ranges hit both withdraw branches, large ones the range checks
+        const int64_t bound = i % 2 ? 1000 : accounting::max_amount;
+        batch.add(native_tester::casino_account, native_tester::core_symbol.raw(),
+                  { value(bound), std::abs(value(bound)), value(bound), std::abs(value(bound)) });
+    }
+    const auto limits = native::max_withdraw(batch);
+    BOOST_REQUIRE_EQUAL(limits.size(), batch.size());
+    uint32_t plain = 0, weekly = 0, failed = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const auto expected = accounting::max_withdraw(batch.state(i));
+        const auto actual = limits.limit(i);
+        BOOST_REQUIRE(expected.error == actual.error);
+        BOOST_REQUIRE_EQUAL(expected.max_transfer, actual.max_transfer);
+        BOOST_REQUIRE_EQUAL(expected.weekly, actual.weekly);
+        plain += actual.ok() && !actual.weekly;
+        weekly += actual.ok() && actual.weekly;
+        failed += !actual.ok();
+    }
+    BOOST_REQUIRE(plain > 0 && weekly > 0 && failed > 0);
+
+    std::vector<int64_t> amounts, shares(batch.size());
+    std::vector<uint32_t> margins;
+    std::vector<accounting::status> errors(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        amounts.push_back(value(i % 2 ? 1000000 : accounting::max_amount));
+        margins.push_back(i % 3 ? uint32_t(random() % 101) : uint32_t(random()));
+    }
+    native::profit_shares(amounts.data(), margins.data(), amounts.size(), shares.data(), errors.data());
+    for (size_t i = 0; i < amounts.size(); ++i) {
+        const auto expected = accounting::profit_share(amounts[i], margins[i]);
+        BOOST_REQUIRE(expected.error == errors[i]);
+        BOOST_REQUIRE_EQUAL(expected.amount, shares[i]);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(limits_match_contract, accounting_tester) {
+    // 45000 on the account, 5000 of it bonus, 15000 game profits
+    auto limit = this->limit();
+    BOOST_REQUIRE(limit.ok() && !limit.weekly);
+    BOOST_REQUIRE_EQUAL(limit.max_transfer, 25000);
+    BOOST_REQUIRE_EQUAL(withdraw(limit.max_transfer + 1), wasm_assert_msg("quantity exceededs max transfer amount"));
+    require_success(withdraw(limit.max_transfer));
+
+    limit = this->limit();
+    BOOST_REQUIRE(limit.error == accounting::status::profits_exceed_balance);
+    BOOST_REQUIRE_EQUAL(withdraw(1), wasm_assert_msg(accounting::message(limit.error)));
+
+    // an active session keeps the balance below reserved funds, a tenth of it can be withdrawn a week
+    // after the last withdraw or addtoken
+    require_success(chain.push_action(casino_account, "sesupdate"_n, game_account, game_account, asset(5000, core_symbol)));
+    require_success(transfer(system_account, casino_account, asset(2000, core_symbol)));
+    limit = this->limit();
+    BOOST_REQUIRE(limit.ok() && limit.weekly);
+    BOOST_REQUIRE_EQUAL(limit.max_transfer, 1700);
+    BOOST_REQUIRE_EQUAL(withdraw(limit.max_transfer + 1), wasm_assert_msg("quantity exceededs max transfer amount"));
+    BOOST_REQUIRE_EQUAL(withdraw(limit.max_transfer), wasm_assert_msg("already claimed within past week"));
+    chain.advance(eosio::microseconds(accounting::useconds_per_week + 1));
+    require_success(withdraw(limit.max_transfer));
+    BOOST_REQUIRE_EQUAL(withdraw(1), wasm_assert_msg("already claimed within past week"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,248 @@
+#include "native_tester.hpp"
+
+#include <native/columnar.hpp>
+#include <native/table_export.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+
+#include <unistd.h>
+
+
+namespace testing {
+
+namespace {
+
+std::string temp_path() {
+    char name[] = "/tmp/native_columnar_XXXXXX";
+    ::close(::mkstemp(name));
+    return name;
+}
+
+std::vector<uint64_t> round_trip(const std::vector<uint64_t>& values, columnar::encoding& used) {
+    const auto data = columnar::encode(values.data(), values.size(), used);
+    std::vector<uint64_t> result(values.size());
+    columnar::decode(data.data(), data.size(), used, result.data(), result.size());
+    return result;
+}
+
+} // namespace
+
+class columnar_tester : public native_tester {
+public:
+    static constexpr name game_account = "game.boy"_n;
+
+    const symbol kek_symbol { "KEK", 5 };
+    std::vector<name> players;
+    std::string export_path = temp_path();
+    std::string columnar_path = temp_path();
+
+    columnar_tester() {
+        allow_token("KEK", 5, "token.kek"_n);
+        add_game(game_account, 0);
+        require_success(transfer(system_account, game_account, asset(1000000, core_symbol)));
+        require_success(transfer(game_account, casino_account, asset(30000, core_symbol)));
+
+        for (int i = 0; i < 25; ++i) {
+            players.push_back(name("pl." + std::string(1, char('a' + i))));
+            require_success(chain.push_action(casino_account, "newsessionpl"_n, game_account, game_account, players.back()));
+            require_success(chain.push_action(casino_account, "sesnewdepo2"_n, game_account, game_account, players.back(),
+                asset(100 * (i + 1), core_symbol)));
+            if (i % 3 == 0) {
+                require_success(chain.push_action(casino_account, "sendbon"_n, casino_account, players.back(), asset(10 * (i + 1), core_symbol)));
+                require_success(chain.push_action(casino_account, "sesnewdepo2"_n, game_account, game_account, players.back(),
+                    asset(1000 * (i + 1), kek_symbol)));
+            }
+        }
+    }
+
+    ~columnar_tester() {
+        std::remove(export_path.c_str());
+        std::remove(columnar_path.c_str());
+    }
+
+    void write(uint32_t group_rows) {
+        write_export(chain.db(), {casino_account}, export_path);
+        const export_reader reader(export_path);
+        write_columnar(reader, casino_account, columnar_path, group_rows);
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(columnar_tests)
+
+BOOST_AUTO_TEST_CASE(encodings_round_trip) {
+    columnar::encoding used;
+
+    const std::vector<uint64_t> symbols(1000, symbol("BET", 4).raw());
+    BOOST_REQUIRE(round_trip(symbols, used) == symbols);
+    BOOST_REQUIRE(used == columnar::encoding::rle);
+
+    std::vector<uint64_t> keys;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        keys.push_back(("pl.a"_n).value + i * 977);
+    }
+    BOOST_REQUIRE(round_trip(keys, used) == keys);
+    BOOST_REQUIRE(used == columnar::encoding::delta);
+
+    std::mt19937_64 rnd(7);
+    std::vector<uint64_t> noise(1000);
+    for (auto& value: noise) {
+        value = rnd();
+    }
+    BOOST_REQUIRE(round_trip(noise, used) == noise);
+    BOOST_REQUIRE(used == columnar::encoding::plain);
+
+    const std::vector<uint64_t> edges {
+        uint64_t(std::numeric_limits<int64_t>::min()), uint64_t(std::numeric_limits<int64_t>::max()), 0, uint64_t(-1), 1, uint64_t(-1),
+    };
+    BOOST_REQUIRE(round_trip(edges, used) == edges);
+    BOOST_REQUIRE(round_trip({}, used).empty());
+
+    // every encoding decodes what it encoded, whichever one was picked
+    for (const auto* values: std::vector<const std::vector<uint64_t>*>{&symbols, &keys, &edges}) {
+        std::vector<uint64_t> result(values->size());
+        const auto data = columnar::encode(values->data(), values->size(), used);
+        BOOST_REQUIRE_THROW(columnar::decode(data.data(), data.size() - 1, used, result.data(), result.size()), std::runtime_error);
+    }
+
+    BOOST_REQUIRE(columnar::less(columnar::type::i64, uint64_t(-1), 0));
+    BOOST_REQUIRE(!columnar::less(columnar::type::u64, uint64_t(-1), 0));
+}
+
+BOOST_FIXTURE_TEST_CASE(casino_tables, columnar_tester) {
+    write(4);
+    const columnar_reader reader(columnar_path);
+    BOOST_REQUIRE_EQUAL(reader.tables().size(), 3);
+
+    // one row per (player, token)
+    const auto& player_tokens = reader.get_table("playertokens"_n);
+    BOOST_REQUIRE_EQUAL(player_tokens.rows, players.size() + (players.size() + 2) / 3);
+    BOOST_REQUIRE_EQUAL(player_tokens.groups, (player_tokens.rows + 3) / 4);
+
+    std::map<uint64_t, int64_t> bonus, volume;
+    casino::player_tokens_table stored(casino_account, casino_account.value);
+    for (const auto& row: stored) {
+        for (const auto& [s, v]: row.bonus_balance) bonus[s] += v;
+        for (const auto& [s, v]: row.volume_real) volume[s] += v;
+    }
+
+    const auto player = player_tokens.column_index("player");
+    const auto symbol_column = player_tokens.column_index("symbol");
+    const auto bonus_column = player_tokens.column_index("bonus_balance");
+    const auto volume_column = player_tokens.column_index("volume_real");
+    std::map<uint64_t, int64_t> scanned_bonus, scanned_volume;
+    uint64_t rows = 0;
+    reader.scan(player_tokens, {player, symbol_column, bonus_column, volume_column}, [&](uint32_t, size_t n, const auto& values) {
+        for (size_t r = 0; r < n; ++r) {
+            BOOST_REQUIRE(stored.find(values[0][r]) != stored.end());
+            scanned_bonus[values[1][r]] += int64_t(values[2][r]);
+            scanned_volume[values[1][r]] += int64_t(values[3][r]);
+        }
+        rows += n;
+    });
+    BOOST_REQUIRE_EQUAL(rows, player_tokens.rows);
+    for (auto& [s, v]: bonus) {
+        BOOST_REQUIRE_EQUAL(scanned_bonus[s], v);
+    }
+    for (auto& [s, v]: volume) {
+        BOOST_REQUIRE_EQUAL(scanned_volume[s], v);
+    }
+    BOOST_REQUIRE_EQUAL(scanned_volume[kek_symbol.raw()], 1000 * (1 + 4 + 7 + 10 + 13 + 16 + 19 + 22 + 25));
+
+    // rows are ordered by player, so stats bound every chunk
+    const auto [min_player, max_player] = player_tokens.stats(player);
+    BOOST_REQUIRE(name(min_player) == "pl.a"_n);
+    BOOST_REQUIRE(name(max_player) == "pl.y"_n);
+    for (uint32_t g = 1; g < player_tokens.groups; ++g) {
+        BOOST_REQUIRE(player_tokens.chunk(g - 1, player).max <= player_tokens.chunk(g, player).min);
+    }
+
+    // groups can be skipped by stats without reading them
+    uint32_t visited = 0;
+    reader.scan(player_tokens, {player}, [&](uint32_t, size_t n, const auto& values) {
+        visited++;
+    }, [&](uint32_t g) {
+        const auto& chunk = player_tokens.chunk(g, player);
+        return "pl.k"_n.value < chunk.min || chunk.max < "pl.k"_n.value;
+    });
+    BOOST_REQUIRE(visited >= 1 && visited <= 2);
+
+    const auto& game_tokens = reader.get_table("gametokens"_n);
+    BOOST_REQUIRE_EQUAL(game_tokens.rows, 1);
+    reader.scan(game_tokens, {game_tokens.column_index("balance")}, [&](uint32_t, size_t n, const auto& values) {
+        BOOST_REQUIRE_EQUAL(int64_t(values[0][0]), 15000);
+    });
+
+    const auto& player_stats = reader.get_table("playerstats"_n);
+    BOOST_REQUIRE_EQUAL(player_stats.rows, players.size());
+    const auto sessions = player_stats.stats(player_stats.column_index("sessions_created"));
+    BOOST_REQUIRE_EQUAL(sessions.first, 1);
+    BOOST_REQUIRE_EQUAL(sessions.second, 1);
+    BOOST_REQUIRE_THROW(player_stats.column_index("bonus_balance"), std::runtime_error);
+    BOOST_REQUIRE_THROW(reader.get_table("gamestate"_n), std::runtime_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(missing_tables_are_empty, columnar_tester) {
+    {
+        export_writer writer(export_path);
+        writer.finish();
+    }
+    const export_reader source(export_path);
+    write_columnar(source, casino_account, columnar_path);
+
+    const columnar_reader reader(columnar_path);
+    for (const auto& t: reader.tables()) {
+        BOOST_REQUIRE_EQUAL(t.rows, 0);
+        BOOST_REQUIRE_EQUAL(t.groups, 0);
+        BOOST_REQUIRE(t.stats(0) == std::make_pair(uint64_t(0), uint64_t(0)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(writer_and_reader_reject_bad_input) {
+    const auto path = temp_path();
+    {
+        columnar_writer writer(path, 2);
+        BOOST_REQUIRE_THROW(writer.add_row({1}), std::logic_error);
+        writer.begin_table("t"_n, {{"a", columnar::type::u64}, {"b", columnar::type::i64}});
+        BOOST_REQUIRE_THROW(writer.add_row({1}), std::logic_error);
+        BOOST_REQUIRE_THROW(writer.begin_table("t"_n, {{"a", columnar::type::u64}}), std::logic_error);
+        BOOST_REQUIRE_THROW(writer.begin_table("u"_n, {}), std::logic_error);
+        BOOST_REQUIRE_THROW(writer.begin_table("u"_n, {{"a_column_name_that_is_too_long", columnar::type::u64}}), std::logic_error);
+        for (uint64_t i = 0; i < 5; ++i) {
+            writer.add_row({i, uint64_t(-int64_t(i))});
+        }
+        writer.finish();
+    }
+    {
+        const columnar_reader reader(path);
+        const auto& t = reader.get_table("t"_n);
+        BOOST_REQUIRE_EQUAL(t.rows, 5);
+        BOOST_REQUIRE_EQUAL(t.groups, 3);
+        BOOST_REQUIRE(t.stats(1) == std::make_pair(uint64_t(-4), uint64_t(0)));
+    }
+
+    std::string content;
+    {
+        std::ifstream in(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() - 8);
+    }
+    BOOST_REQUIRE_THROW(columnar_reader{path}, std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not columnar at all, just text";
+    }
+    BOOST_REQUIRE_EXCEPTION(columnar_reader{path}, std::runtime_error, [](const auto& e) {
+        return std::string(e.what()).find("not a columnar export") != std::string::npos;
+    });
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,2 @@
+#define BOOST_TEST_MODULE native_test
+#include <boost/test/included/unit_test.hpp>
@@ -0,0 +1,789 @@
+#include "native_tester.hpp"
+
+#include <chrono>
+
+
+namespace testing {
+
+BOOST_AUTO_TEST_SUITE(native_tests)
+
+BOOST_FIXTURE_TEST_CASE(on_transfer_update_game_balance, native_tester) {
+    const name game_account = "game.boy"_n;
+    add_game(game_account, 0);
+
+    require_success(transfer(system_account, game_account, asset(30000, core_symbol)));
+    require_success(transfer(system_account, casino_account, asset(3000000, core_symbol)));
+
+    require_success(transfer(game_account, casino_account, asset(30000, core_symbol)));
+    BOOST_REQUIRE(get_game_balance(0) == asset(15000, core_symbol));
+    BOOST_REQUIRE(get_balance(casino_account) == asset(3030000, core_symbol));
+    BOOST_REQUIRE(get_balance(game_account) == asset(0, core_symbol));
+
+    const symbol kek_symbol("KEK", 5);
+    allow_token("KEK", 5, "token.kek"_n);
+    require_success(transfer(system_account, game_account, asset(300000, kek_symbol)));
+    require_success(transfer(game_account, casino_account, asset(300000, kek_symbol)));
+
+    BOOST_REQUIRE(get_game_balance(0, kek_symbol) == asset(150000, kek_symbol));
+    BOOST_REQUIRE(get_balance(casino_account, kek_symbol) == asset(300000, kek_symbol));
+}
+
+BOOST_FIXTURE_TEST_CASE(on_loss_update_game_balance, native_tester) {
+    const name game_account = "game.boy"_n;
+    const name player_account = "din.don"_n;
+    chain.create_account(player_account);
+    add_game(game_account, 0);
+
+    require_success(transfer(system_account, casino_account, asset(50000, core_symbol)));
+
+    require_success(chain.push_action(casino_account, "onloss"_n, game_account,
+        game_account, player_account, asset(30000, core_symbol)
+    ));
+
+    BOOST_REQUIRE(get_balance(player_account) == asset(30000, core_symbol));
+    BOOST_REQUIRE(get_game_balance(0) == asset(-15000, core_symbol));
+    BOOST_REQUIRE(get_balance(casino_account) == asset(20000, core_symbol));
+
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("token is not in the list"),
+        chain.push_action(casino_account, "onloss"_n, game_account,
+            game_account, player_account, asset(300000, symbol("KEK", 5))
+        )
+    );
+}
+
+BOOST_FIXTURE_TEST_CASE(leaderboard_follows_sessions, native_tester) {
+    const name game_account = "game.boy"_n;
+    add_game(game_account, 0);
+    require_success(transfer(system_account, casino_account, asset(1000000, core_symbol)));
+
+    // volume 3000, 1000, 2000; net profit -1000, 5000, -2000 + 500 - 300
+    const std::vector<name> players { "pl.a"_n, "pl.b"_n, "pl.c"_n };
+    const auto deposit = [&](name player, int64_t amount) {
+        require_success(chain.push_action(casino_account, "sesnewdepo2"_n, game_account, game_account, player, asset(amount, core_symbol)));
+    };
+    const auto payout = [&](name player, int64_t amount) {
+        require_success(chain.push_action(casino_account, "sespayout"_n, game_account, game_account, player, asset(amount, core_symbol)));
+    };
+    deposit(players[0], 3000);
+    payout(players[0], 2000);
+    deposit(players[1], 1000);
+    payout(players[1], 6000);
+    deposit(players[2], 2000);
+    require_success(chain.push_action(casino_account, "sendbon"_n, casino_account, players[2], asset(1000, core_symbol)));
+    require_success(chain.push_action(casino_account, "seslockbon"_n, game_account, game_account, players[2], asset(800, core_symbol)));
+    require_success(chain.push_action(casino_account, "sesaddbon"_n, game_account, game_account, players[2], asset(500, core_symbol)));
+
+    const auto check_board = [&] {
+        chain.make_current();
+        casino::leaderboard_table leaderboard(casino_account, core_symbol.raw());
+        std::vector<std::pair<name, int64_t>> by_volume, by_profit;
+        const auto volume_index = leaderboard.get_index<"volume"_n>();
+        for (auto it = volume_index.rbegin(); it != volume_index.rend(); ++it) {
+            by_volume.emplace_back(it->player, it->volume);
+        }
+        const auto profit_index = leaderboard.get_index<"profit"_n>();
+        for (auto it = profit_index.rbegin(); it != profit_index.rend(); ++it) {
+            by_profit.emplace_back(it->player, it->profit);
+        }
+        BOOST_REQUIRE(by_volume == (std::vector<std::pair<name, int64_t>> { {players[0], 3000}, {players[2], 2000}, {players[1], 1000} }));
+        BOOST_REQUIRE(by_profit == (std::vector<std::pair<name, int64_t>> { {players[1], 5000}, {players[0], -1000}, {players[2], -2300} }));
+    };
+    check_board();
+
+    // players who played before the leaderboard existed are added by migrateboard
+    chain.make_current();
+    casino::leaderboard_table leaderboard(casino_account, core_symbol.raw());
+    for (auto it = leaderboard.begin(); it != leaderboard.end();) {
+        it = leaderboard.erase(it);
+    }
+    require_success(chain.push_action(casino_account, "migrateboard"_n, casino_account, players[1], uint32_t(1)));
+    BOOST_REQUIRE_EQUAL(casino::leaderboard_table(casino_account, core_symbol.raw()).get(players[1].value).profit, 5000);
+    BOOST_REQUIRE(casino::leaderboard_table(casino_account, core_symbol.raw()).find(players[2].value) == leaderboard.end());
+    require_success(chain.push_action(casino_account, "migrateboard"_n, casino_account, name(), uint32_t(10)));
+    check_board();
+}
+
+BOOST_FIXTURE_TEST_CASE(daily_stats_roll_up, native_tester) {
+    const name game_account = "game.boy"_n;
+    const name player_account = "din.don"_n;
+    chain.create_account(player_account);
+    add_game(game_account, 0);
+    require_success(transfer(system_account, game_account, asset(100000, core_symbol)));
+    require_success(transfer(system_account, casino_account, asset(100000, core_symbol)));
+
+    const auto session = [&](int64_t deposit, int64_t payout) {
+        require_success(chain.push_action(casino_account, "newsession"_n, game_account, game_account));
+        require_success(chain.push_action(casino_account, "sesnewdepo2"_n, game_account, game_account, player_account, asset(deposit, core_symbol)));
+        require_success(chain.push_action(casino_account, "sesupdate"_n, game_account, game_account, asset(deposit, core_symbol)));
+        require_success(transfer(game_account, casino_account, asset(deposit, core_symbol)));
+        require_success(chain.push_action(casino_account, "sespayout"_n, game_account, game_account, player_account, asset(payout, core_symbol)));
+        require_success(chain.push_action(casino_account, "sesclose"_n, game_account, game_account, asset(deposit, core_symbol)));
+    };
+    const auto days = [&] {
+        chain.make_current();
+        std::vector<casino::daily_stats_row> result;
+        for (const auto& row: casino::daily_stats_table(casino_account, 0)) {
+            BOOST_REQUIRE_EQUAL(row.symbol_raw, core_symbol.raw());
+            result.push_back(row);
+        }
+        return result;
+    };
+    const auto today = [&] {
+        const auto day = uint32_t(chain.now().sec_since_epoch() / casino::casino::seconds_per_day);
+        const auto rows = days();
+        const auto row = std::find_if(rows.begin(), rows.end(), [&](const auto& r) { return r.day == day; });
+        BOOST_REQUIRE(row != rows.end());
+        return *row;
+    };
+
+    session(10000, 4000);
+    session(20000, 0);
+    require_success(chain.push_action(casino_account, "onloss"_n, game_account, game_account, player_account, asset(6000, core_symbol)));
+    auto stats = today();
+    BOOST_REQUIRE_EQUAL(stats.volume, 30000);
+    BOOST_REQUIRE_EQUAL(stats.payouts, 4000);
+    BOOST_REQUIRE_EQUAL(stats.sessions, 2);
+    BOOST_REQUIRE_EQUAL(stats.margin, 15000 - 3000);
+
+    chain.advance(eosio::seconds(casino::casino::seconds_per_day));
+    session(5000, 1000);
+    stats = today();
+    BOOST_REQUIRE_EQUAL(stats.volume, 5000);
+    BOOST_REQUIRE_EQUAL(stats.sessions, 1);
+    BOOST_REQUIRE_EQUAL(days().size(), 2);
+
+    // the first day is out of the kept days then and is pruned
+    const auto first_day = days().front().day;
+    chain.advance(eosio::seconds(casino::casino::seconds_per_day * (casino::casino::daily_stats_days - 1)));
+    session(7000, 0);
+    stats = today();
+    BOOST_REQUIRE_EQUAL(stats.volume, 7000);
+    BOOST_REQUIRE_EQUAL(stats.payouts, 0);
+    BOOST_REQUIRE_EQUAL(stats.margin, 3500);
+    const auto rows = days();
+    BOOST_REQUIRE_EQUAL(rows.size(), 2);
+    BOOST_REQUIRE(std::none_of(rows.begin(), rows.end(), [&](const auto& r) { return r.day == first_day; }));
+
+    // a removed game leaves no rows behind
+    chain.create_account("dev"_n);
+    require_success(chain.push_action(platform_name, "setbenefic"_n, platform_name, uint64_t(0), "dev"_n));
+    require_success(chain.push_action(casino_account, "rmgame"_n, casino_account, uint64_t(0)));
+    BOOST_REQUIRE(days().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(migrate_games_no_bonus, native_tester) {
+    const name game_account = "game.boy"_n;
+    const name player_account = "din.don"_n;
+    chain.create_account(player_account);
+    add_game(game_account, 0);
+    require_success(transfer(system_account, casino_account, asset(10000, core_symbol), "bonus"));
+    require_success(chain.push_action(casino_account, "sendbon"_n, casino_account, player_account, asset(1000, core_symbol)));
+
+    // state written before the flag: game rows without it and restrictions in gamesnobon,
+    // one of them for a game the casino doesn't list
+    add_game("game.free"_n, 1);
+    chain.make_current();
+    casino::game_table games(casino_account, casino_account.value);
+    for (const uint64_t game_id: {0, 1}) {
+        games.modify(games.require_find(game_id), casino_account, [](auto& row) {
+            row.no_bonus.reset();
+        });
+    }
+    casino::games_no_bonus_table games_no_bonus(casino_account, casino_account.value);
+    for (const uint64_t game_id: {0, 7}) {
+        games_no_bonus.emplace(casino_account, [&](auto& row) {
+            row.game_id = game_id;
+        });
+    }
+    const auto lock = [&] {
+        return chain.push_action(casino_account, "seslockbon"_n, game_account, game_account, player_account, asset(100, core_symbol));
+    };
+    const auto migrate = [&](uint64_t from, uint32_t count) {
+        return chain.push_action(casino_account, "migratenobon"_n, casino_account, from, count);
+    };
+    // the legacy restriction holds until the migration
+    BOOST_REQUIRE_EQUAL(lock(), wasm_assert_msg("game is restricted to bonus"));
+    BOOST_REQUIRE(casino::read::get_game_context(casino_account, 0, player_account, core_symbol).no_bonus);
+
+    require_success(migrate(0, 1));
+    chain.make_current();
+    BOOST_REQUIRE(games.get(0).no_bonus.value_or(false));
+    BOOST_REQUIRE(!games.get(1).no_bonus.has_value());
+    BOOST_REQUIRE(games_no_bonus.find(0) == games_no_bonus.end());
+    BOOST_REQUIRE_EQUAL(lock(), wasm_assert_msg("game is restricted to bonus"));
+
+    // unrestricted games get the flag too, so nothing reads gamesnobon afterwards
+    require_success(migrate(1, 10));
+    chain.make_current();
+    BOOST_REQUIRE(games.get(1).no_bonus.has_value() && !games.get(1).no_bonus.value_or(true));
+    BOOST_REQUIRE(games_no_bonus.find(7) != games_no_bonus.end());
+
+    require_success(chain.push_action(casino_account, "rmgamenobon"_n, casino_account, game_account));
+    require_success(lock());
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "rmgamenobon"_n, casino_account, game_account), wasm_assert_msg("game is not restricted"));
+
+    // a restriction lifted before the migration isn't brought back by the legacy row
+    chain.make_current();
+    games.modify(games.require_find(0), casino_account, [](auto& row) {
+        row.no_bonus.reset();
+    });
+    games_no_bonus.emplace(casino_account, [](auto& row) {
+        row.game_id = 0;
+    });
+    require_success(chain.push_action(casino_account, "rmgamenobon"_n, casino_account, game_account));
+    require_success(migrate(0, 10));
+    require_success(lock());
+    chain.make_current();
+    BOOST_REQUIRE(games_no_bonus.find(0) == games_no_bonus.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(bulk_bonus_credits, native_tester) {
+    const name existing = "pl.bb"_n;
+    require_success(chain.push_action(casino_account, "sendbon"_n, casino_account, existing, asset(50, core_symbol)));
+
+    casino::bonus_credits_type credits;
+    for (const auto player: {"pl.aa"_n, existing, "pl.cc"_n}) {
+        credits.emplace_back(player, 100);
+    }
+    const auto send = [&](const casino::bonus_credits_type& credits) {
+        return chain.push_action(casino_account, "sendbon.b"_n, casino_account, core_symbol, credits);
+    };
+
+    // a bad entry anywhere rejects the whole batch
+    auto bad = credits;
+    bad.back().second = 0;
+    BOOST_REQUIRE_EQUAL(send(bad), wasm_assert_msg("bonus amount should be positive"));
+    bad = credits;
+    std::swap(bad[0], bad[1]);
+    BOOST_REQUIRE_EQUAL(send(bad), wasm_assert_msg("players should be sorted without duplicates"));
+    bad = credits;
+    bad.push_back(bad.back());
+    BOOST_REQUIRE_EQUAL(send(bad), wasm_assert_msg("players should be sorted without duplicates"));
+    BOOST_REQUIRE_EQUAL(send({}), wasm_assert_msg("no players"));
+    bad.clear();
+    for (uint64_t i = 0; i <= casino::casino::max_bulk_players; ++i) {
+        bad.emplace_back(name(i + 1), 1);
+    }
+    BOOST_REQUIRE_EQUAL(send(bad), wasm_assert_msg("too many players"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "sendbon.b"_n, casino_account, symbol("BET", 2), credits),
+        wasm_assert_msg("incorrect asset symbol"));
+
+    chain.make_current();
+    casino::bonus_balance_table bonus_balance(casino_account, casino_account.value);
+    casino::player_tokens_table player_tokens(casino_account, casino_account.value);
+    BOOST_REQUIRE(bonus_balance.find("pl.aa"_n.value) == bonus_balance.end());
+    BOOST_REQUIRE(player_tokens.find("pl.aa"_n.value) == player_tokens.end());
+
+    require_success(send(credits));
+    chain.make_current();
+    for (const auto& [player, amount]: credits) {
+        const auto expected = player == existing ? 150 : 100;
+        BOOST_REQUIRE_EQUAL(bonus_balance.get(player.value).balance.amount, expected);
+        BOOST_REQUIRE_EQUAL(player_tokens.get(player.value).bonus_balance.at(core_symbol.raw()), expected);
+    }
+
+    // greeting bonus of the signed up players, the same rows as newplayer writes
+    require_success(chain.push_action(casino_account, "setgreetbon"_n, casino_account, asset(7, core_symbol)));
+    const std::vector<name> players = {"pl.aa"_n, "pl.dd"_n};
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "newplayer.b"_n, casino_account, players, std::string("BET")),
+        wasm_assert_msg("missing authority of platform/gameaction"));
+    const permission_level gameaction{platform_name, casino::casino::platform_game_permission};
+    require_success(chain.push_action(casino_account, "newplayer.b"_n, gameaction, players, std::string("BET")));
+    require_success(chain.push_action(casino_account, "newplayer"_n, gameaction, "pl.ee"_n));
+    chain.make_current();
+    BOOST_REQUIRE_EQUAL(bonus_balance.get("pl.aa"_n.value).balance.amount, 107);
+    BOOST_REQUIRE(eosio::pack(player_tokens.get("pl.dd"_n.value)).size() == eosio::pack(player_tokens.get("pl.ee"_n.value)).size());
+    BOOST_REQUIRE_EQUAL(player_tokens.get("pl.dd"_n.value).bonus_balance.at(core_symbol.raw()), 7);
+    BOOST_REQUIRE(bonus_balance.get("pl.dd"_n.value).balance == bonus_balance.get("pl.ee"_n.value).balance);
+}
+
+BOOST_FIXTURE_TEST_CASE(bulk_bonus_conversion, native_tester) {
+    const std::vector<name> players = {"pl.aa"_n, "pl.bb"_n, "pl.cc"_n};
+    for (const auto player: players) {
+        chain.create_account(player);
+    }
+    require_success(transfer(system_account, casino_account, asset(500, core_symbol), "bonus"));
+    require_success(chain.push_action(casino_account, "sendbon.b"_n, casino_account, core_symbol,
+        casino::bonus_credits_type{{players[0], 100}, {players[1], 200}, {players[2], 300}}));
+
+    const auto convert = [&](const std::vector<name>& accounts) {
+        return chain.push_action(casino_account, "convertbon.b"_n, casino_account, accounts, core_symbol, std::string("promo"));
+    };
+    // checked against the sum of the batch
+    BOOST_REQUIRE_EQUAL(convert(players), wasm_assert_msg("convert quantity cannot exceed total allocated"));
+    BOOST_REQUIRE_EQUAL(convert({players[0], "pl.dd"_n}), wasm_assert_msg("player has no bonus"));
+    BOOST_REQUIRE_EQUAL(convert({players[2], players[0]}), wasm_assert_msg("players should be sorted without duplicates"));
+
+    require_success(chain.push_action(casino_account, "subtractbon"_n, casino_account, players[1], asset(200, core_symbol)));
+    require_success(convert(players));
+    BOOST_REQUIRE(get_balance(players[0]) == asset(100, core_symbol));
+    BOOST_REQUIRE(get_balance(players[1]) == asset(0, core_symbol));
+    BOOST_REQUIRE(get_balance(players[2]) == asset(300, core_symbol));
+    BOOST_REQUIRE(get_balance(casino_account) == asset(100, core_symbol));
+
+    chain.make_current();
+    const auto gtokens = casino::global_tokens_singleton(casino_account, casino_account.value).get();
+    BOOST_REQUIRE_EQUAL(gtokens.total_allocated_bonus.at(core_symbol.raw()), 100);
+    const auto bstate = casino::bonus_pool_state_singleton(casino_account, casino_account.value).get();
+    BOOST_REQUIRE(bstate.total_allocated == asset(100, core_symbol));
+    casino::bonus_balance_table bonus_balance(casino_account, casino_account.value);
+    casino::player_tokens_table player_tokens(casino_account, casino_account.value);
+    for (const auto player: players) {
+        BOOST_REQUIRE(bonus_balance.find(player.value) == bonus_balance.end());
+        BOOST_REQUIRE_EQUAL(player_tokens.get(player.value).bonus_balance.at(core_symbol.raw()), 0);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(netted_payouts, native_tester) {
+    const name game_account = "game.boy"_n;
+    const std::vector<name> players = {"pl.aa"_n, "pl.bb"_n};
+    for (const auto player: players) {
+        chain.create_account(player);
+    }
+    add_game(game_account, 0);
+    require_success(transfer(system_account, casino_account, asset(10000, core_symbol)));
+    // a token setting like addtoken, by the contract itself rather than the owner
+    chain.create_account("new.owner"_n);
+    require_success(chain.push_action(casino_account, "setowner"_n, casino_account, "new.owner"_n));
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "setpaythr"_n, "new.owner"_n, std::string("BET"), int64_t(1000)),
+        wasm_assert_msg("missing authority of " + casino_account.to_string()));
+    require_success(chain.push_action(casino_account, "setowner"_n, "new.owner"_n, casino_account));
+    require_success(chain.push_action(casino_account, "setpaythr"_n, casino_account, std::string("BET"), int64_t(1000)));
+
+    const auto loss = [&](name player, int64_t amount) {
+        return chain.push_action(casino_account, "onloss"_n, game_account, game_account, player, asset(amount, core_symbol));
+    };
+    casino::pending_payout_table pending(casino_account, core_symbol.raw());
+    const auto pending_of = [&](name player) {
+        chain.make_current();
+        const auto itr = pending.find(player.value);
+        return itr == pending.end() ? 0 : itr->amount;
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        require_success(loss(players[0], 300));
+    }
+    require_success(loss(players[1], 200));
+    BOOST_REQUIRE_EQUAL(pending_of(players[0]), 900);
+    BOOST_REQUIRE(get_balance(players[0]) == asset(0, core_symbol));
+    // margins are applied on every onloss
+    BOOST_REQUIRE(get_game_balance(0) == asset(-550, core_symbol));
+    BOOST_REQUIRE_EQUAL(loss(players[0], 0), wasm_assert_msg("must transfer positive quantity"));
+
+    // pending payouts aren't withdrawable
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "withdraw"_n, casino_account, system_account, asset(9000, core_symbol)),
+        wasm_assert_msg("quantity exceededs max transfer amount"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "rmtoken"_n, casino_account, std::string("BET")),
+        wasm_assert_msg("token has pending payouts"));
+
+    // reaching the threshold sends the whole amount at once
+    require_success(loss(players[0], 300));
+    BOOST_REQUIRE(get_balance(players[0]) == asset(1200, core_symbol));
+    BOOST_REQUIRE_EQUAL(pending_of(players[0]), 0);
+
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "settle"_n, players[0], core_symbol, uint32_t(0)),
+        wasm_assert_msg("count should be positive"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "settle"_n, players[0], core_symbol, casino::casino::max_settle_count + 1),
+        wasm_assert_msg("too many payouts to settle"));
+    require_success(chain.push_action(casino_account, "settle"_n, players[0], core_symbol, uint32_t(10)));
+    BOOST_REQUIRE(get_balance(players[1]) == asset(200, core_symbol));
+    BOOST_REQUIRE_EQUAL(pending_of(players[1]), 0);
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "settle"_n, players[0], core_symbol, uint32_t(10)),
+        wasm_assert_msg("nothing to settle"));
+    casino::token_table tokens(casino_account, casino_account.value);
+    BOOST_REQUIRE_EQUAL(tokens.get(core_symbol.code().raw()).pending_payouts.value_or(-1), 0);
+
+    // without a threshold every onloss is a transfer again
+    require_success(chain.push_action(casino_account, "setpaythr"_n, casino_account, std::string("BET"), int64_t(0)));
+    require_success(loss(players[1], 1));
+    BOOST_REQUIRE(get_balance(players[1]) == asset(201, core_symbol));
+    BOOST_REQUIRE(get_game_balance(0) == asset(-700, core_symbol));
+}
+
+BOOST_FIXTURE_TEST_CASE(dense_game_params, native_tester) {
+    const name game_account = "game.boy"_n;
+    chain.create_account(game_account);
+    require_success(chain.push_action(platform_name, "addgame"_n, platform_name, game_account, uint16_t(3), bytes()));
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "addgame"_n, casino_account, uint64_t(0), game_params_type{{3, 1}}),
+        wasm_assert_msg("param id exceeds game's params count"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(casino_account, "addgame"_n, casino_account, uint64_t(0), game_params_type{{1, 1}, {1, 2}}),
+        wasm_assert_msg("duplicate param id"));
+    require_success(chain.push_action(casino_account, "addgame"_n, casino_account, uint64_t(0), game_params_type{{2, 7}, {0, 5}}));
+
+    const auto param = [&](uint16_t idx) {
+        chain.make_current();
+        return casino::read::get_game_param(casino_account, 0, "BET", idx);
+    };
+    BOOST_REQUIRE_EQUAL(param(0), 5);
+    BOOST_REQUIRE_EQUAL(param(1), 0);
+    BOOST_REQUIRE_EQUAL(param(2), 7);
+    BOOST_REQUIRE_EXCEPTION(param(3), eosio::eosio_assert_error, [](const auto& e) {
+        return std::string(e.what()).find("param id exceeds game's params count") != std::string::npos;
+    });
+    BOOST_REQUIRE_EXCEPTION(casino::read::get_game_param(casino_account, 0, "KEK", 0), eosio::eosio_assert_error, [](const auto& e) {
+        return std::string(e.what()).find("no game params for the token") != std::string::npos;
+    });
+
+    require_success(chain.push_action(casino_account, "setgameparam"_n, casino_account, uint64_t(0), game_params_type{{1, 9}}));
+    BOOST_REQUIRE_EQUAL(param(1), 9);
+    BOOST_REQUIRE_EQUAL(param(2), 0);
+
+    // games added before the dense rows get them from gameparams
+    chain.make_current();
+    casino::game_param_token_table dense(casino_account, 0);
+    dense.erase(dense.require_find(core_symbol.code().raw()));
+    require_success(chain.push_action(casino_account, "migrateparam"_n, casino_account, uint64_t(0), uint32_t(10)));
+    BOOST_REQUIRE_EQUAL(param(1), 9);
+
+    // legacy params the rule rejects and games the platform deleted don't stop a page
+    const name other_game = "game.two"_n;
+    chain.create_account(other_game);
+    require_success(chain.push_action(platform_name, "addgame"_n, platform_name, other_game, uint16_t(1), bytes()));
+    require_success(chain.push_action(platform_name, "addgame"_n, platform_name, other_game, uint16_t(2), bytes()));
+    require_success(chain.push_action(platform_name, "delgame"_n, platform_name, uint64_t(1)));
+    chain.make_current();
+    casino::game_params_table game_params(casino_account, casino_account.value);
+    game_params.modify(game_params.require_find(0), casino_account, [&](auto& row) {
+        row.params[core_symbol.code().raw()] = game_params_type{{1, 4}, {5, 8}, {1, 6}};
+    });
+    for (const uint64_t game_id: {1, 2}) {
+        game_params.emplace(casino_account, [&](auto& row) {
+            row.game_id = game_id;
+            row.params[core_symbol.code().raw()] = game_params_type{{1, 3}};
+        });
+    }
+    require_success(chain.push_action(casino_account, "migrateparam"_n, casino_account, uint64_t(0), uint32_t(10)));
+    chain.make_current();
+    BOOST_REQUIRE(dense.get(core_symbol.code().raw()).values == std::vector<uint64_t>({0, 6, 0}));
+    BOOST_REQUIRE(casino::game_param_token_table(casino_account, 1).begin() == casino::game_param_token_table(casino_account, 1).end());
+    BOOST_REQUIRE(casino::game_param_token_table(casino_account, 2).get(core_symbol.code().raw()).values == std::vector<uint64_t>({0, 3}));
+
+    require_success(transfer(system_account, game_account, asset(100, core_symbol)));
+    require_success(transfer(game_account, casino_account, asset(100, core_symbol)));
+    require_success(chain.push_action(casino_account, "rmgame"_n, casino_account, uint64_t(0)));
+    chain.make_current();
+    BOOST_REQUIRE(dense.begin() == dense.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(game_context_read, native_tester) {
+    const name game_account = "game.boy"_n;
+    const name player_account = "din.don"_n;
+    add_game(game_account, 0);
+    require_success(chain.push_action(casino_account, "sendbon"_n, casino_account, player_account, asset(1000, core_symbol)));
+    require_success(chain.push_action(casino_account, "newsessionpl"_n, game_account, game_account, player_account));
+    require_success(chain.push_action(casino_account, "newsession"_n, game_account, game_account));
+    require_success(chain.push_action(casino_account, "addgamenobon"_n, casino_account, game_account));
+    require_success(chain.push_action(casino_account, "pausegame"_n, casino_account, uint64_t(0), true));
+
+    chain.make_current();
+    auto context = casino::read::get_game_context(casino_account, 0, player_account, core_symbol);
+    BOOST_REQUIRE(context.paused);
+    BOOST_REQUIRE(context.no_bonus);
+    BOOST_REQUIRE(context.params == std::vector<uint64_t>{0});
+    BOOST_REQUIRE_EQUAL(context.bonus_balance, 1000);
+    BOOST_REQUIRE_EQUAL(context.active_sessions_amount, 1);
+
+    // nothing of the player or the token is not an error
+    context = casino::read::get_game_context(casino_account, 0, "pl.zzz"_n, symbol("KEK", 4));
+    BOOST_REQUIRE(context.params.empty());
+    BOOST_REQUIRE_EQUAL(context.bonus_balance, 0);
+    BOOST_REQUIRE_EXCEPTION(casino::read::get_game_context(casino_account, 1, player_account, core_symbol), eosio::eosio_assert_error,
+        [](const auto& e) { return std::string(e.what()).find("game not found") != std::string::npos; });
+}
+
+BOOST_FIXTURE_TEST_CASE(platform_patches, native_tester) {
+    std::vector<uint64_t> ids;
+    for (uint64_t i = 0; i < 3; ++i) {
+        const name game_account(("game." + std::string(1, char('a' + i))).c_str());
+        require_success(chain.push_action(platform_name, "addgame"_n, platform_name, game_account, uint16_t(1), bytes()));
+        ids.push_back(i);
+    }
+
+    platform::game_patch patch;
+    patch.profit_margin = 30;
+    patch.beneficiary = "dev"_n;
+    patch.meta = bytes{1, 2};
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "patchgame"_n, platform_name, uint64_t(1), platform::game_patch()),
+        wasm_assert_msg("nothing to patch"));
+    require_success(chain.push_action(platform_name, "patchgame"_n, platform_name, uint64_t(1), patch));
+    chain.make_current();
+    auto game = platform::read::get_game(platform_name, 1);
+    BOOST_REQUIRE(game.contract == "game.b"_n);
+    BOOST_REQUIRE_EQUAL(game.profit_margin, 30);
+    BOOST_REQUIRE(game.beneficiary == "dev"_n);
+    BOOST_REQUIRE(game.meta == bytes({1, 2}));
+    BOOST_REQUIRE(!game.paused);
+
+    // an unknown id rolls back the whole list
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "pausegames"_n, platform_name, std::vector<uint64_t>{0, 1, 7}, true),
+        wasm_assert_msg("game not found"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "pausegames"_n, platform_name, std::vector<uint64_t>(), true),
+        wasm_assert_msg("no ids"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "pausegames"_n, platform_name,
+        std::vector<uint64_t>(platform::platform::max_bulk_ids + 1), true), wasm_assert_msg("too many ids"));
+    require_success(chain.push_action(platform_name, "pausegames"_n, platform_name, ids, true));
+    chain.make_current();
+    for (const auto id: ids) {
+        BOOST_REQUIRE(!platform::read::is_active_game(platform_name, id));
+    }
+
+    patch = {};
+    patch.paused = false;
+    patch.profit_margin = 10;
+    require_success(chain.push_action(platform_name, "patchgames"_n, platform_name, std::vector<uint64_t>{0, 2}, patch));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::is_active_game(platform_name, 0));
+    BOOST_REQUIRE(!platform::read::is_active_game(platform_name, 1));
+    BOOST_REQUIRE_EQUAL(platform::read::get_game(platform_name, 2).profit_margin, 10);
+    BOOST_REQUIRE_EQUAL(platform::read::get_game(platform_name, 1).profit_margin, 30);
+
+    // casinos are patched the same way
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, casino_account, bytes()));
+    require_success(chain.push_action(platform_name, "pausecasinos"_n, platform_name, std::vector<uint64_t>{0}, true));
+    platform::casino_patch casino_patch;
+    casino_patch.meta = bytes{3};
+    require_success(chain.push_action(platform_name, "patchcasinos"_n, platform_name, std::vector<uint64_t>{0}, casino_patch));
+    casino_patch = {};
+    casino_patch.rsa_pubkey = "key";
+    require_success(chain.push_action(platform_name, "patchcas"_n, platform_name, uint64_t(0), casino_patch));
+    chain.make_current();
+    const auto casino = platform::read::get_casino(platform_name, 0);
+    BOOST_REQUIRE(casino.paused);
+    BOOST_REQUIRE(casino.meta == bytes({3}));
+    BOOST_REQUIRE_EQUAL(casino.rsa_pubkey, "key");
+    BOOST_REQUIRE(casino.contract == casino_account);
+}
+
+BOOST_FIXTURE_TEST_CASE(active_platform_entries, native_tester) {
+    for (uint64_t i = 0; i < 4; ++i) {
+        const name game_account(("game." + std::string(1, char('a' + i))).c_str());
+        require_success(chain.push_action(platform_name, "addgame"_n, platform_name, game_account, uint16_t(1), bytes()));
+    }
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, casino_account, bytes()));
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, "casino.b"_n, bytes()));
+
+    const auto active_games = [&] {
+        chain.make_current();
+        return platform::read::get_active_games(platform_name, 0, 100);
+    };
+    BOOST_REQUIRE(active_games() == std::vector<uint64_t>({0, 1, 2, 3}));
+
+    require_success(chain.push_action(platform_name, "pausegame"_n, platform_name, uint64_t(1), true));
+    require_success(chain.push_action(platform_name, "delgame"_n, platform_name, uint64_t(3)));
+    BOOST_REQUIRE(active_games() == std::vector<uint64_t>({0, 2}));
+    require_success(chain.push_action(platform_name, "pausegames"_n, platform_name, std::vector<uint64_t>{0, 1}, true));
+    BOOST_REQUIRE(active_games() == std::vector<uint64_t>({2}));
+    platform::game_patch patch;
+    patch.paused = false;
+    require_success(chain.push_action(platform_name, "patchgame"_n, platform_name, uint64_t(1), patch));
+    BOOST_REQUIRE(active_games() == std::vector<uint64_t>({1, 2}));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_active_games(platform_name, 2, 100) == std::vector<uint64_t>({2}));
+    BOOST_REQUIRE(platform::read::get_active_games(platform_name, 0, 1) == std::vector<uint64_t>({1}));
+
+    require_success(chain.push_action(platform_name, "pausecas"_n, platform_name, uint64_t(0), true));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_active_casinos(platform_name, 0, 100) == std::vector<uint64_t>({1}));
+
+    // tables written before the active sets
+    platform::active_game_table games(platform_name, platform_name.value);
+    for (auto it = games.begin(); it != games.end(); it = games.erase(it));
+    platform::active_casino_table casinos(platform_name, platform_name.value);
+    for (auto it = casinos.begin(); it != casinos.end(); it = casinos.erase(it));
+    require_success(chain.push_action(platform_name, "migrateactiv"_n, platform_name, uint64_t(0), uint32_t(2)));
+    BOOST_REQUIRE(active_games() == std::vector<uint64_t>({1}));
+    require_success(chain.push_action(platform_name, "migrateactiv"_n, platform_name, uint64_t(2), uint32_t(2)));
+    BOOST_REQUIRE(active_games() == std::vector<uint64_t>({1, 2}));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_active_casinos(platform_name, 0, 100) == std::vector<uint64_t>({1}));
+}
+
+BOOST_FIXTURE_TEST_CASE(platform_listings, native_tester) {
+    // a casino not added to the platform lists nothing
+    add_game("game.a"_n, 0);
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 0, 0, 10).empty());
+
+    const name other_casino = "casino.b"_n;
+    chain.create_account(other_casino);
+    chain.set_code(other_casino, casino_abi());
+    require_success(chain.push_action(other_casino, "setplatform"_n, other_casino, platform_name));
+    require_success(chain.push_action(other_casino, "addtoken"_n, other_casino, std::string("BET")));
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, casino_account, bytes()));
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, other_casino, bytes()));
+    add_game("game.b"_n, 1);
+    require_success(chain.push_action(other_casino, "addgame"_n, other_casino, uint64_t(1), game_params_type{{0, 0}}));
+    require_success(chain.push_action(other_casino, "addgame"_n, other_casino, uint64_t(0), game_params_type{{0, 0}}));
+
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 1, 0, 10) == std::vector<uint64_t>({0, 1}));
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 1, 1, 10) == std::vector<uint64_t>({1}));
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 0, 0, 10) == std::vector<uint64_t>({1}));
+    BOOST_REQUIRE(platform::read::get_casino_games(platform_name, 1, 0, 10) == std::vector<uint64_t>({0, 1}));
+    BOOST_REQUIRE(platform::read::get_casino_games(platform_name, 0, 0, 10) == std::vector<uint64_t>({1}));
+
+    // games listed before the casino was added to the platform
+    require_success(chain.push_action(casino_account, "synclisting"_n, casino_account, uint64_t(0), uint32_t(10)));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_casino_games(platform_name, 0, 0, 10) == std::vector<uint64_t>({0, 1}));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "addlisting"_n, casino_account, other_casino, uint64_t(0)),
+        wasm_assert_msg("missing authority of casino.b"));
+
+    // the developer is rewarded on removal, so the game needs a balance in the casino, an empty one
+    // without a beneficiary
+    require_success(chain.push_action(platform_name, "setmargin"_n, platform_name, uint64_t(0), uint32_t(0)));
+    require_success(transfer(system_account, "game.a"_n, asset(1000, core_symbol)));
+    require_success(transfer("game.a"_n, other_casino, asset(1000, core_symbol)));
+    require_success(chain.push_action(other_casino, "rmgame"_n, other_casino, uint64_t(0)));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 0, 0, 10) == std::vector<uint64_t>({0}));
+
+    // listings are removed in pages before the game or the casino
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "delgame"_n, platform_name, uint64_t(1)),
+        wasm_assert_msg("game has listings, remove them with dellistgame"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "dellistgame"_n, platform_name, uint64_t(1), uint32_t(0)),
+        wasm_assert_msg("count should be positive"));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "dellistgame"_n, platform_name, uint64_t(1), platform::platform::max_bulk_ids + 1),
+        wasm_assert_msg("too many listings"));
+    require_success(chain.push_action(platform_name, "dellistgame"_n, platform_name, uint64_t(1), uint32_t(1)));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 1, 0, 10) == std::vector<uint64_t>({1}));
+    require_success(chain.push_action(platform_name, "dellistgame"_n, platform_name, uint64_t(1), uint32_t(10)));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "dellistgame"_n, platform_name, uint64_t(1), uint32_t(10)),
+        wasm_assert_msg("no listings"));
+    require_success(chain.push_action(platform_name, "delgame"_n, platform_name, uint64_t(1)));
+    require_success(chain.push_action(platform_name, "delcas"_n, platform_name, uint64_t(1)));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 1, 0, 10).empty());
+    BOOST_REQUIRE(platform::read::get_casino_games(platform_name, 1, 0, 10).empty());
+    BOOST_REQUIRE(platform::read::get_casino_games(platform_name, 0, 0, 10) == std::vector<uint64_t>({0}));
+
+    // a contract added as two casinos can't tell which of them lists a game
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, casino_account, bytes()));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "addlisting"_n, casino_account, casino_account, uint64_t(0)),
+        wasm_assert_msg("casino contract is added more than once"));
+    require_success(chain.push_action(platform_name, "delcas"_n, platform_name, uint64_t(2)));
+
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "delcas"_n, platform_name, uint64_t(0)),
+        wasm_assert_msg("casino has listings, remove them with dellistcas"));
+    require_success(chain.push_action(platform_name, "dellistcas"_n, platform_name, uint64_t(0), uint32_t(10)));
+    require_success(chain.push_action(platform_name, "delcas"_n, platform_name, uint64_t(0)));
+    chain.make_current();
+    BOOST_REQUIRE(platform::read::get_game_casinos(platform_name, 0, 0, 10).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(binary_rsa_keys, native_tester) {
+    const auto set_key = [&](const bytes& modulus, uint32_t exponent) {
+        return chain.push_action(platform_name, "setrsabin"_n, platform_name, modulus, exponent);
+    };
+    bytes modulus(512, '\x35');
+    modulus[0] = '\x80';
+    BOOST_REQUIRE_EQUAL(set_key(bytes(100, '\x81'), 65537), wasm_assert_msg("rsa modulus should be 2048, 3072 or 4096 bits"));
+    BOOST_REQUIRE_EQUAL(set_key(bytes(256, '\x01'), 65537), wasm_assert_msg("rsa modulus has leading zero bits"));
+    BOOST_REQUIRE_EQUAL(set_key(bytes(256, '\x80'), 65537), wasm_assert_msg("rsa modulus should be odd"));
+    BOOST_REQUIRE_EQUAL(set_key(modulus, 65536), wasm_assert_msg("invalid rsa exponent"));
+    BOOST_REQUIRE_EQUAL(set_key(modulus, 1), wasm_assert_msg("invalid rsa exponent"));
+
+    require_success(chain.push_action(platform_name, "setrsakey"_n, platform_name, std::string("pem key")));
+    require_success(set_key(modulus, 65537));
+    chain.make_current();
+    auto key = platform::read::get_rsa_key(platform_name);
+    BOOST_REQUIRE(key && key->modulus == modulus);
+    BOOST_REQUIRE_EQUAL(key->exponent, 65537);
+    BOOST_REQUIRE_EQUAL(platform::read::get_rsa_pubkey(platform_name), "pem key");
+    // a string key replaces the binary one
+    require_success(chain.push_action(platform_name, "setrsakey"_n, platform_name, std::string("pem key")));
+    chain.make_current();
+    BOOST_REQUIRE(!platform::read::get_rsa_key(platform_name));
+
+    require_success(chain.push_action(platform_name, "addcas"_n, platform_name, casino_account, bytes()));
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "setrsacasbin"_n, platform_name, uint64_t(1), modulus, uint32_t(3)),
+        wasm_assert_msg("casino not found"));
+    require_success(chain.push_action(platform_name, "setrsacasbin"_n, platform_name, uint64_t(0), modulus, uint32_t(3)));
+    chain.make_current();
+    key = platform::read::get_rsa_key(platform_name, 0);
+    BOOST_REQUIRE(key && key->modulus == modulus);
+    BOOST_REQUIRE_EQUAL(key->exponent, 3);
+    BOOST_REQUIRE(!platform::read::get_rsa_key(platform_name));
+
+    // strings are emptied on request only, with the binary key in place
+    BOOST_REQUIRE_EQUAL(chain.push_action(platform_name, "droprsastr"_n, platform_name, platform::platform_rsa_key_id),
+        wasm_assert_msg("no binary rsa key"));
+    require_success(chain.push_action(platform_name, "setrsacas"_n, platform_name, uint64_t(0), std::string("pem key")));
+    require_success(chain.push_action(platform_name, "setrsacasbin"_n, platform_name, uint64_t(0), modulus, uint32_t(3)));
+    chain.make_current();
+    BOOST_REQUIRE_EQUAL(platform::read::get_casino(platform_name, uint64_t(0)).rsa_pubkey, "pem key");
+    require_success(chain.push_action(platform_name, "droprsastr"_n, platform_name, uint64_t(0)));
+    chain.make_current();
+    BOOST_REQUIRE_EQUAL(platform::read::get_casino(platform_name, uint64_t(0)).rsa_pubkey, "");
+    BOOST_REQUIRE(platform::read::get_rsa_key(platform_name, 0));
+
+    platform::casino_patch patch;
+    patch.rsa_pubkey = "pem key";
+    require_success(chain.push_action(platform_name, "patchcas"_n, platform_name, uint64_t(0), patch));
+    chain.make_current();
+    BOOST_REQUIRE(!platform::read::get_rsa_key(platform_name, 0));
+}
+
+BOOST_FIXTURE_TEST_CASE(failed_transaction_rollback, native_tester) {
+    const name game_account = "game.boy"_n;
+    const name player_account = "din.don"_n;
+    chain.create_account(player_account);
+    add_game(game_account, 0);
+
+    require_success(transfer(system_account, casino_account, asset(10000, core_symbol)));
+
+    // casino has not enough tokens, inline transfer fails after game balance was updated
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("overdrawn balance"),
+        chain.push_action(casino_account, "onloss"_n, game_account,
+            game_account, player_account, asset(30000, core_symbol)
+        )
+    );
+
+    BOOST_REQUIRE(get_game_balance(0) == asset(0, core_symbol));
+    BOOST_REQUIRE(get_balance(casino_account) == asset(10000, core_symbol));
+    BOOST_REQUIRE(get_balance(player_account) == asset(0, core_symbol));
+}
+
+BOOST_FIXTURE_TEST_CASE(auth_failure, native_tester) {
+    const name game_account = "game.boy"_n;
+    add_game(game_account, 0);
+
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("missing authority of game.boy"),
+        chain.push_action(casino_account, "sesupdate"_n, casino_account,
+            game_account, asset(10000, core_symbol)
+        )
+    );
+}
+
+// not a benchmark, prints actions per second to catch the emulation getting slower by orders of magnitude
+BOOST_FIXTURE_TEST_CASE(session_throughput, native_tester) {
+    const name game_account = "game.boy"_n;
+    add_game(game_account, 0);
+    require_success(transfer(system_account, game_account, asset(100000000, core_symbol)));
+
+    constexpr uint32_t sessions = 10000;
+    const auto started = std::chrono::steady_clock::now();
+    const auto actions_before = chain.executed_actions();
+    for (uint32_t i = 0; i < sessions; ++i) {
+        const name player(("pl." + std::string(1, char('a' + i % 26))).c_str());
+        const asset quantity(10000, core_symbol);
+        chain.push_transaction({
+            eosio::action({game_account, "active"_n}, casino_account, "newsessionpl"_n, std::make_tuple(game_account, player)),
+            eosio::action({game_account, "active"_n}, casino_account, "newsession"_n, std::make_tuple(game_account)),
+            eosio::action({game_account, "active"_n}, casino_account, "sesnewdepo2"_n, std::make_tuple(game_account, player, quantity)),
+            eosio::action({game_account, "active"_n}, casino_account, "sesupdate"_n, std::make_tuple(game_account, quantity)),
+            eosio::action({game_account, "active"_n}, "eosio.token"_n, "transfer"_n, std::make_tuple(game_account, casino_account, quantity, std::string())),
+            eosio::action({game_account, "active"_n}, casino_account, "sesclose"_n, std::make_tuple(game_account, quantity)),
+        });
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    const auto actions = chain.executed_actions() - actions_before;
+
+    BOOST_TEST_MESSAGE("native: " << actions << " actions in " << elapsed << "s, " << uint64_t(actions / elapsed) << " actions/s");
+    BOOST_REQUIRE(get_game_balance(0) == asset(sessions * 5000, core_symbol));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <native/chain.hpp>
+#include <native/contracts.hpp>
+
+#include <platform/platform.hpp>
+#include <casino/casino.hpp>
+#include <events/events.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+
+namespace testing {
+
+using namespace native;
+using eosio::asset;
+using eosio::symbol;
+
+using game_params_type = std::vector<std::pair<uint16_t, uint64_t>>;
+
+// in-memory chain with platform, casino, events and eosio.token deployed,
+// mirrors casino_tester setup from tests/casino_test.cpp
+class native_tester {
+public:
+    static constexpr name platform_name = "platform"_n;
+    static constexpr name events_name = "events"_n;
+    static constexpr name casino_account = "dao.casino"_n;
+    static constexpr name system_account = "eosio"_n;
+
+    static constexpr symbol core_symbol = symbol("BET", 4);
+
+    native::chain chain;
+
+    native_tester() {
+        chain.create_accounts({
+            platform_name,
+            events_name,
+            casino_account
+        });
+
+        chain.set_code(platform_name, platform_abi());
+        chain.set_code(casino_account, casino_abi());
+        chain.set_code(events_name, events_abi());
+
+        require_success(chain.push_action(casino_account, "setplatform"_n, casino_account, platform_name));
+        require_success(chain.push_action(events_name, "setplatform"_n, events_name, platform_name));
+
+        allow_token("BET", 4, "eosio.token"_n);
+    }
+
+    static std::string success() { return native::chain::success(); }
+
+    static std::string wasm_assert_msg(const std::string& msg) {
+        return "assertion failure with message: " + msg;
+    }
+
+    static void require_success(const std::string& result) {
+        BOOST_REQUIRE_EQUAL(success(), result);
+    }
+
+    void allow_token(const std::string& token_name, uint8_t precision, name contract) {
+        if (!chain.is_account(contract)) {
+            chain.create_account(contract);
+        }
+        chain.set_code(contract, token_abi());
+
+        const symbol symb(token_name, precision);
+        require_success(chain.push_action(contract, "create"_n, contract, system_account, asset(100000000000000, symb)));
+        require_success(chain.push_action(contract, "issue"_n, system_account, system_account, asset(1672708210000, symb), ""));
+
+        require_success(chain.push_action(platform_name, "addtoken"_n, platform_name, token_name, contract));
+        require_success(chain.push_action(casino_account, "addtoken"_n, casino_account, token_name));
+    }
+
+    name get_token_contract(const symbol& symb) {
+        platform::token_table tokens(platform_name, platform_name.value);
+        const auto it = tokens.find(symb.code().raw());
+        return it == tokens.end() ? name() : it->contract;
+    }
+
+    std::string transfer(name from, name to, const asset& amount, const std::string& memo = "") {
+        const auto contract = get_token_contract(amount.symbol);
+        if (contract == name()) {
+            return wasm_assert_msg("token is not in the list");
+        }
+        return chain.push_action(contract, "transfer"_n, from, from, to, amount, memo);
+    }
+
+    asset get_balance(name account, const symbol& symb = core_symbol) {
+        const auto contract = get_token_contract(symb);
+        if (contract == name()) {
+            return asset(0, symb);
+        }
+        token::accounts accounts(contract, account.value);
+        const auto it = accounts.find(symb.code().raw());
+        return it == accounts.end() ? asset(0, symb) : it->balance;
+    }
+
+    asset get_game_balance(uint64_t game_id, const symbol& symb = core_symbol) {
+        casino::game_tokens_table game_tokens(casino_account, casino_account.value);
+        const auto it = game_tokens.find(game_id);
+        if (it == game_tokens.end() || !it->balance.count(symb.raw())) {
+            return asset(0, symb);
+        }
+        return asset(it->balance.at(symb.raw()), symb);
+    }
+
+    // platform game with 50% profit margin listed in the casino
+    void add_game(name game_account, uint64_t game_id) {
+        chain.create_account(game_account);
+        require_success(chain.push_action(platform_name, "addgame"_n, platform_name, game_account, uint16_t(1), bytes()));
+        require_success(chain.push_action(platform_name, "setmargin"_n, platform_name, game_id, uint32_t(50)));
+        require_success(chain.push_action(casino_account, "addgame"_n, casino_account, game_id, game_params_type{{0, 0}}));
+    }
+};
+
+} // namespace testing
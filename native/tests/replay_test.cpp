@@ -0,0 +1,202 @@
+#include "native_tester.hpp"
+
+#include <native/replay.hpp>
+
+#include <sstream>
+
+
+namespace testing {
+
+using namespace native::replay;
+
+// two casinos sharing a game, every casino gets its own sessions and deposits
+class replay_tester {
+public:
+    static constexpr name platform_name = "platform"_n;
+    static constexpr name events_name = "events"_n;
+    static constexpr name game_account = "game.boy"_n;
+    static constexpr symbol core_symbol = symbol("BET", 4);
+
+    const std::vector<name> casinos { "casino.a"_n, "casino.b"_n };
+
+    std::vector<log_entry> log;
+    eosio::time_point now { eosio::seconds(1577836800) };
+
+    template <typename... Args>
+    void record(name account, name action_name, name actor, Args&&... args) {
+        now += eosio::milliseconds(500);
+        log_entry entry;
+        entry.time = now;
+        entry.act = eosio::action({actor, "active"_n}, account, action_name, std::make_tuple(std::forward<Args>(args)...));
+        entry.line = log.size() + 1;
+        log.push_back(std::move(entry));
+    }
+
+    replay_tester() {
+        record("eosio.token"_n, "create"_n, "eosio.token"_n, "eosio"_n, asset(100000000000000, core_symbol));
+        record("eosio.token"_n, "issue"_n, "eosio"_n, "eosio"_n, asset(1000000000000, core_symbol), std::string());
+        record(platform_name, "addtoken"_n, platform_name, std::string("BET"), "eosio.token"_n);
+        record(platform_name, "addgame"_n, platform_name, game_account, uint16_t(1), bytes());
+        record(platform_name, "setmargin"_n, platform_name, uint64_t(0), uint32_t(50));
+        record(events_name, "setplatform"_n, events_name, platform_name);
+        record("eosio.token"_n, "transfer"_n, "eosio"_n, "eosio"_n, game_account, asset(100000000, core_symbol), std::string());
+
+        for (const auto& casino: casinos) {
+            record(platform_name, "addcas"_n, platform_name, casino, bytes());
+            record(casino, "setplatform"_n, casino, platform_name);
+            record(casino, "addtoken"_n, casino, std::string("BET"));
+            record(casino, "addgame"_n, casino, uint64_t(0), game_params_type{{0, 0}});
+            record("eosio.token"_n, "transfer"_n, "eosio"_n, "eosio"_n, casino, asset(10000000, core_symbol), std::string());
+        }
+
+        for (uint32_t i = 0; i < 100; ++i) {
+            const auto& casino = casinos[i % casinos.size()];
+            const name player(("pl." + std::string(1, char('a' + i % 26))).c_str());
+            const asset quantity(10000 + i, core_symbol);
+            record(casino, "newsessionpl"_n, game_account, game_account, player);
+            record(casino, "newsession"_n, game_account, game_account);
+            record(casino, "sesnewdepo2"_n, game_account, game_account, player, quantity);
+            record(casino, "sesupdate"_n, game_account, game_account, quantity);
+            record("eosio.token"_n, "transfer"_n, game_account, game_account, casino, quantity, std::string());
+            record(casino, "sesclose"_n, game_account, game_account, quantity);
+            record(events_name, "send"_n, game_account, game_account, uint64_t(i % casinos.size()), uint64_t(0), uint64_t(i), uint32_t(0), bytes());
+            if (i % 10 == 0) {
+                record(casino, "onloss"_n, game_account, game_account, player, asset(5000, core_symbol));
+            }
+        }
+    }
+
+    replay_config config(uint32_t threads) const {
+        replay_config result;
+        result.platform = platform_name;
+        result.casinos = casinos;
+        result.events = { events_name };
+        result.threads = threads;
+        return result;
+    }
+
+    // the same log on a single chain without sharding
+    std::vector<std::string> sequential_state() const {
+        native::chain chain;
+        chain.set_open_accounts(true);
+        chain.set_code(platform_name, platform_abi());
+        chain.set_code(events_name, events_abi());
+        chain.set_code("eosio.token"_n, token_abi());
+        for (const auto& casino: casinos) {
+            chain.set_code(casino, casino_abi());
+        }
+        for (const auto& entry: log) {
+            chain.set_time(entry.time);
+            BOOST_REQUIRE_EQUAL(native::chain::success(), chain.push_action(entry.act));
+        }
+
+        std::vector<std::string> state;
+        dump_tables(chain.db(), platform_name, state);
+        dump_tables(chain.db(), events_name, state);
+        for (const auto& casino: casinos) {
+            dump_tables(chain.db(), casino, state);
+            token::accounts balances("eosio.token"_n, casino.value);
+            for (const auto& row: balances) {
+                state.push_back("eosio.token " + casino.to_string() + " accounts " + std::to_string(row.primary_key())
+                                + ' ' + to_hex(eosio::pack(row)));
+            }
+        }
+        std::sort(state.begin(), state.end());
+        return state;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(replay_tests)
+
+BOOST_AUTO_TEST_CASE(log_format_round_trip) {
+    replay_tester t;
+    std::stringstream stream;
+    stream << "# recorded by the test\n\n";
+    for (const auto& entry: t.log) {
+        write_entry(stream, entry);
+    }
+
+    const auto parsed = read_log(stream);
+    BOOST_REQUIRE_EQUAL(parsed.size(), t.log.size());
+    for (size_t i = 0; i < parsed.size(); ++i) {
+        BOOST_REQUIRE(parsed[i].time == t.log[i].time);
+        BOOST_REQUIRE(parsed[i].act.account == t.log[i].act.account);
+        BOOST_REQUIRE(parsed[i].act.name == t.log[i].act.name);
+        BOOST_REQUIRE(parsed[i].act.authorization == t.log[i].act.authorization);
+        BOOST_REQUIRE(parsed[i].act.data == t.log[i].act.data);
+        BOOST_REQUIRE_EQUAL(parsed[i].line, i + 3);
+    }
+
+    BOOST_REQUIRE(parse_time("2020-01-01T00:00:00.5") == eosio::time_point(eosio::microseconds(1577836800500000)));
+    BOOST_REQUIRE_EQUAL(format_time(parse_time("2024-02-29T23:59:59.250")), "2024-02-29T23:59:59.250");
+
+    std::istringstream bad("2020-01-01T00:00:00.000 dao.casino sesupdate\n");
+    BOOST_REQUIRE_EXCEPTION(read_log(bad), std::runtime_error, [](const auto& e) {
+        return std::string(e.what()).find("line 1:") == 0;
+    });
+}
+
+BOOST_AUTO_TEST_CASE(sharded_replay_matches_sequential) {
+    replay_tester t;
+    const auto expected = t.sequential_state();
+
+    for (const uint32_t threads: {1u, 3u}) {
+        const auto result = replayer(t.config(threads)).run(t.log);
+        for (const auto& f: result.failures) {
+            BOOST_TEST_MESSAGE("line " << f.line << ": " << f.message);
+        }
+        BOOST_REQUIRE(result.failures.empty());
+        BOOST_REQUIRE_EQUAL(result.shards.size(), threads);
+        BOOST_REQUIRE_EQUAL(result.skipped, 1); // eosio -> game.boy transfer
+
+        const auto diff = diff_state(expected, result.state);
+        for (const auto& row: diff.missing) BOOST_TEST_MESSAGE("missing " << row);
+        for (const auto& row: diff.unexpected) BOOST_TEST_MESSAGE("unexpected " << row);
+        for (const auto& row: diff.changed) BOOST_TEST_MESSAGE("changed " << row);
+        BOOST_REQUIRE(diff.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(divergence_and_failures_reported) {
+    replay_tester t;
+    auto expected = t.sequential_state();
+    const auto changed = expected.back();
+    expected.back().back() = expected.back().back() == '0' ? '1' : '0';
+    expected.push_back("casino.c casino.c game 0 00");
+
+    // the casino can't pay a loss bigger than its balance
+    t.record(t.casinos[0], "onloss"_n, t.game_account, t.game_account, "pl.a"_n, asset(100000000000, t.core_symbol));
+
+    const auto result = replayer(t.config(2)).run(t.log);
+    BOOST_REQUIRE_EQUAL(result.failures.size(), 1);
+    BOOST_REQUIRE_EQUAL(result.failures[0].line, t.log.size());
+    BOOST_REQUIRE_EQUAL(result.failures[0].message, native_tester::wasm_assert_msg("overdrawn balance"));
+
+    const auto diff = diff_state(expected, result.state);
+    BOOST_REQUIRE_EQUAL(diff.missing.size(), 1);
+    BOOST_REQUIRE_EQUAL(diff.missing[0], "casino.c casino.c game 0 00");
+    BOOST_REQUIRE_EQUAL(diff.changed.size(), 1);
+    BOOST_REQUIRE_EQUAL(diff.changed[0], changed);
+    BOOST_REQUIRE(diff.unexpected.empty());
+}
+
+BOOST_AUTO_TEST_CASE(shared_platform_is_read_only) {
+    native::chain base;
+    base.create_account(replay_tester::platform_name);
+    base.set_code(replay_tester::platform_name, platform_abi());
+    BOOST_REQUIRE_EQUAL(native::chain::success(),
+        base.push_action(replay_tester::platform_name, "addtoken"_n, replay_tester::platform_name, std::string("BET"), "eosio.token"_n));
+    base.db().freeze();
+
+    native::chain shard;
+    shard.db().share(base.db(), replay_tester::platform_name.value);
+    platform::token_table tokens(replay_tester::platform_name, replay_tester::platform_name.value);
+    BOOST_REQUIRE(tokens.find(eosio::symbol_code("BET").raw()) != tokens.end());
+    BOOST_REQUIRE_EXCEPTION(tokens.erase(tokens.begin()), eosio::eosio_assert_error, [](const auto& e) {
+        return std::string(e.what()) == "db access violation";
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,198 @@
+#include "native_tester.hpp"
+
+#include <native/replay.hpp>
+#include <native/table_export.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+
+
+namespace testing {
+
+// export file removed with the fixture
+struct export_file {
+    std::string path;
+
+    export_file() {
+        char name[] = "/tmp/native_export_XXXXXX";
+        ::close(::mkstemp(name));
+        path = name;
+    }
+    ~export_file() { std::remove(path.c_str()); }
+};
+
+class export_tester : public native_tester {
+public:
+    static constexpr name game_account = "game.boy"_n;
+
+    const std::vector<name> players { "pl.a"_n, "pl.b"_n, "pl.c"_n, "pl.d"_n };
+
+    export_tester() {
+        const symbol kek_symbol("KEK", 5);
+        allow_token("KEK", 5, "token.kek"_n);
+        add_game(game_account, 0);
+        require_success(transfer(system_account, game_account, asset(1000000, core_symbol)));
+        require_success(transfer(game_account, casino_account, asset(30000, core_symbol)));
+
+        for (size_t i = 0; i < players.size(); ++i) {
+            require_success(chain.push_action(casino_account, "sendbon"_n, casino_account, players[i], asset(100 * (i + 1), core_symbol)));
+            require_success(chain.push_action(casino_account, "sesnewdepo2"_n, game_account, game_account, players[i],
+                asset(1000 * (i + 1), kek_symbol)));
+        }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(table_export_tests)
+
+BOOST_FIXTURE_TEST_CASE(rows_round_trip, export_tester) {
+    export_file file;
+    write_export(chain.db(), {platform_name, casino_account, "eosio.token"_n}, file.path);
+    const export_reader reader(file.path);
+
+    // directory is sorted by (code, table) and holds every table of the exported contracts
+    const auto tables = reader.tables();
+    size_t expected_tables = 0;
+    for (const auto& it: chain.db().get_tables()) {
+        const auto code = std::get<0>(it.first);
+        if (code == platform_name.value || code == casino_account.value || code == "eosio.token"_n.value) {
+            expected_tables++;
+        }
+    }
+    size_t rows = 0;
+    for (size_t i = 0; i < tables.size(); ++i) {
+        rows += tables[i].size();
+        if (i) {
+            BOOST_REQUIRE(std::make_pair(tables[i - 1].code(), tables[i - 1].table()) < std::make_pair(tables[i].code(), tables[i].table()));
+        }
+    }
+    BOOST_REQUIRE(rows >= expected_tables);
+    BOOST_REQUIRE(!reader.find_table(events_name, "global"_n));
+
+    const auto player_tokens = reader.get_table(casino_account, "playertokens"_n);
+    BOOST_REQUIRE_EQUAL(player_tokens.size(), players.size());
+    casino::player_tokens_table stored(casino_account, casino_account.value);
+    for (const auto& row: player_tokens) {
+        BOOST_REQUIRE_EQUAL(row.scope, casino_account.value);
+        const auto decoded = row.as<casino::player_tokens_row>();
+        const auto& expected = stored.get(row.primary_key);
+        BOOST_REQUIRE(decoded.player == expected.player);
+        BOOST_REQUIRE(decoded.bonus_balance == expected.bonus_balance);
+        BOOST_REQUIRE(decoded.volume_real == expected.volume_real);
+        BOOST_REQUIRE(decoded.profit_real == expected.profit_real);
+    }
+
+    const auto player = player_tokens.find(casino_account.value, "pl.c"_n.value);
+    BOOST_REQUIRE(player);
+    BOOST_REQUIRE_EQUAL(player->as<casino::player_tokens_row>().bonus_balance.at(core_symbol.raw()), 300);
+    BOOST_REQUIRE(!player_tokens.find(casino_account.value, "pl.e"_n.value));
+    BOOST_REQUIRE(!player_tokens.find(platform_name.value, "pl.c"_n.value));
+
+    const auto game_tokens = reader.get_table(casino_account, "gametokens"_n).find(casino_account.value, 0);
+    BOOST_REQUIRE(game_tokens);
+    BOOST_REQUIRE_EQUAL(game_tokens->as<casino::game_tokens_row>().balance.at(core_symbol.raw()), 15000);
+
+    const auto global = reader.get_table(casino_account, "globaltokens"_n).find(casino_account.value, "globaltokens"_n.value);
+    BOOST_REQUIRE(global);
+    BOOST_REQUIRE_EQUAL(global->as<casino::global_tokens_state>().game_profits_sum.at(core_symbol.raw()), 15000);
+
+    // token balances are scoped by owner
+    const auto balances = reader.get_table("eosio.token"_n, "accounts"_n);
+    const auto casino_balance = balances.scan(casino_account.value);
+    BOOST_REQUIRE_EQUAL(casino_balance.size(), 1);
+    BOOST_REQUIRE((*casino_balance.begin()).as<token::account>().balance == asset(30000, core_symbol));
+}
+
+BOOST_FIXTURE_TEST_CASE(import_replay_dump, export_tester) {
+    std::vector<std::string> dump;
+    replay::dump_tables(chain.db(), casino_account, dump);
+    std::sort(dump.begin(), dump.end());
+
+    export_file direct, imported;
+    write_export(chain.db(), {casino_account}, direct.path);
+    write_export(dump, imported.path);
+
+    std::ifstream a(direct.path, std::ios::binary), b(imported.path, std::ios::binary);
+    const std::string direct_bytes((std::istreambuf_iterator<char>(a)), std::istreambuf_iterator<char>());
+    const std::string imported_bytes((std::istreambuf_iterator<char>(b)), std::istreambuf_iterator<char>());
+    BOOST_REQUIRE(direct_bytes == imported_bytes);
+
+    BOOST_REQUIRE_EXCEPTION(write_export(std::vector<std::string>{"dao.casino dao.casino"}, imported.path), std::runtime_error,
+        [](const auto& e) { return std::string(e.what()).find("line 1:") == 0; });
+}
+
+BOOST_AUTO_TEST_CASE(range_scans) {
+    export_file file;
+    {
+        export_writer writer(file.path);
+        writer.begin_table("dao.casino"_n, "playertokens"_n);
+        for (uint64_t scope = 1; scope <= 3; ++scope) {
+            for (uint64_t pk = 0; pk < 100000; pk += 2) {
+                writer.add_row(scope, pk, reinterpret_cast<const char*>(&pk), sizeof(pk));
+            }
+        }
+        writer.begin_table("dao.casino"_n, "zzzz"_n);
+        writer.finish();
+    }
+
+    const export_reader reader(file.path);
+    const auto table = reader.get_table("dao.casino"_n, "playertokens"_n);
+    BOOST_REQUIRE_EQUAL(table.size(), 150000);
+    BOOST_REQUIRE_EQUAL(reader.get_table("dao.casino"_n, "zzzz"_n).size(), 0);
+
+    const auto scope = table.scan(2);
+    BOOST_REQUIRE_EQUAL(scope.size(), 50000);
+    uint64_t expected = 0;
+    for (const auto& row: scope) {
+        BOOST_REQUIRE_EQUAL(row.scope, 2);
+        BOOST_REQUIRE_EQUAL(row.primary_key, expected);
+        BOOST_REQUIRE_EQUAL(row.as<uint64_t>(), expected);
+        expected += 2;
+    }
+
+    const auto range = table.scan(3, 11, 21);
+    BOOST_REQUIRE_EQUAL(range.size(), 5);
+    BOOST_REQUIRE_EQUAL((*range.begin()).primary_key, 12);
+    BOOST_REQUIRE(table.scan(4).empty());
+    BOOST_REQUIRE(table.scan(1, 30, 10).empty());
+    BOOST_REQUIRE(table.find(1, 99998));
+    BOOST_REQUIRE(!table.find(1, 99999));
+}
+
+BOOST_AUTO_TEST_CASE(writer_and_reader_reject_bad_input) {
+    export_file file;
+    {
+        export_writer writer(file.path);
+        BOOST_REQUIRE_THROW(writer.add_row(0, 0, bytes()), std::logic_error);
+        writer.begin_table("b"_n, "t"_n);
+        writer.add_row(1, 5, bytes());
+        BOOST_REQUIRE_THROW(writer.add_row(1, 5, bytes()), std::logic_error);
+        BOOST_REQUIRE_THROW(writer.add_row(0, 9, bytes()), std::logic_error);
+        BOOST_REQUIRE_THROW(writer.begin_table("a"_n, "t"_n), std::logic_error);
+        writer.finish();
+    }
+
+    // truncated file
+    std::string content;
+    {
+        std::ifstream in(file.path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() - 8);
+    }
+    BOOST_REQUIRE_THROW(export_reader(file.path), std::runtime_error);
+    {
+        std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+        out << "not an export at all";
+    }
+    BOOST_REQUIRE_EXCEPTION(export_reader(file.path), std::runtime_error, [](const auto& e) {
+        return std::string(e.what()).find("not a table export") != std::string::npos;
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,251 @@
+#include "native_tester.hpp"
+
+#include <native/views.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+
+namespace testing {
+
+using namespace native::replay;
+
+// sessions and bonuses of a single casino recorded as a log
+class views_tester {
+public:
+    static constexpr name platform_name = "platform"_n;
+    static constexpr name casino_account = "dao.casino"_n;
+    static constexpr name game_account = "game.boy"_n;
+    static constexpr symbol core_symbol = symbol("BET", 4);
+
+    std::vector<log_entry> log;
+    eosio::time_point now { eosio::seconds(1577836800) };
+    std::string checkpoint_path;
+
+    template <typename... Args>
+    void record(name account, name action_name, name actor, Args&&... args) {
+        now += eosio::milliseconds(500);
+        log_entry entry;
+        entry.time = now;
+        entry.act = eosio::action({actor, "active"_n}, account, action_name, std::make_tuple(std::forward<Args>(args)...));
+        entry.line = log.size() + 1;
+        log.push_back(std::move(entry));
+    }
+
+    views_tester() {
+        char path[] = "/tmp/native_views_XXXXXX";
+        ::close(::mkstemp(path));
+        checkpoint_path = path;
+
+        record("eosio.token"_n, "create"_n, "eosio.token"_n, "eosio"_n, asset(100000000000000, core_symbol));
+        record("eosio.token"_n, "issue"_n, "eosio"_n, "eosio"_n, asset(1000000000000, core_symbol), std::string());
+        record(platform_name, "addtoken"_n, platform_name, std::string("BET"), "eosio.token"_n);
+        record(platform_name, "addgame"_n, platform_name, game_account, uint16_t(1), bytes());
+        record(platform_name, "setmargin"_n, platform_name, uint64_t(0), uint32_t(50));
+        record(platform_name, "addcas"_n, platform_name, casino_account, bytes());
+        record(casino_account, "setplatform"_n, casino_account, platform_name);
+        record(casino_account, "addtoken"_n, casino_account, std::string("BET"));
+        record(casino_account, "addgame"_n, casino_account, uint64_t(0), game_params_type{{0, 0}});
+        record("eosio.token"_n, "transfer"_n, "eosio"_n, "eosio"_n, casino_account, asset(10000000, core_symbol), std::string());
+        // not a transfer of the casino, the views fund the game on demand instead
+        record("eosio.token"_n, "transfer"_n, "eosio"_n, "eosio"_n, game_account, asset(100000000, core_symbol), std::string());
+
+        for (uint32_t i = 0; i < 300; ++i) {
+            const name player(("pl." + std::string(1, char('a' + i % 26)) + std::string(1, char('a' + i / 26 % 26))).c_str());
+            const asset quantity(10000 + i, core_symbol);
+            record(casino_account, "newsessionpl"_n, game_account, game_account, player);
+            record(casino_account, "newsession"_n, game_account, game_account);
+            record(casino_account, "sesnewdepo2"_n, game_account, game_account, player, quantity);
+            record(casino_account, "sesupdate"_n, game_account, game_account, quantity);
+            record("eosio.token"_n, "transfer"_n, game_account, game_account, casino_account, quantity, std::string());
+            record(casino_account, "sesclose"_n, game_account, game_account, quantity);
+            if (i % 7 == 0) {
+                record(casino_account, "sendbon"_n, casino_account, player, asset(100 + i, core_symbol));
+            }
+            if (i % 50 == 0) {
+                // not a contract of the casino, skipped
+                record("events"_n, "send"_n, game_account, game_account, uint64_t(0), uint64_t(0), uint64_t(i), uint32_t(0), bytes());
+                // more than the session holds, fails
+                record(casino_account, "sesclose"_n, game_account, game_account, asset(1000000000, core_symbol));
+            }
+        }
+    }
+
+    ~views_tester() {
+        std::remove(checkpoint_path.c_str());
+    }
+
+    native::views_config config() const {
+        native::views_config result;
+        result.platform = platform_name;
+        result.casino = casino_account;
+        result.publish_every = 64;
+        result.player_shards = 16;
+        return result;
+    }
+
+    std::string stream(size_t from = 0, size_t to = size_t(-1)) const {
+        std::ostringstream out;
+        for (size_t i = from; i < std::min(to, log.size()); ++i) {
+            write_entry(out, log[i]);
+        }
+        return out.str();
+    }
+
+    // the log pushed to a chain directly
+    void check(const native::casino_views& views) const {
+        native::chain chain;
+        chain.set_open_accounts(true);
+        chain.set_code(platform_name, platform_abi());
+        chain.set_code(casino_account, casino_abi());
+        chain.set_code("eosio.token"_n, token_abi());
+        for (const auto& entry: log) {
+            chain.set_time(entry.time);
+            chain.push_action(entry.act);
+        }
+        chain.make_current();
+
+        const auto reader = views.make_reader();
+        reader.read([&](const auto& s) {
+            BOOST_REQUIRE_EQUAL(s.applied, log.size());
+            casino::player_tokens_table player_tokens(casino_account, casino_account.value);
+            uint64_t players = 0;
+            for (const auto& row: player_tokens) {
+                const auto* viewed = s.find_player(row.player);
+                BOOST_REQUIRE(viewed);
+                BOOST_REQUIRE(eosio::pack(*viewed) == eosio::pack(row));
+                ++players;
+            }
+            BOOST_REQUIRE_EQUAL(s.player_count, players);
+            BOOST_REQUIRE(!s.find_player("pl.zzz"_n));
+
+            casino::game_tokens_table game_tokens(casino_account, casino_account.value);
+            BOOST_REQUIRE_EQUAL(s.games.size(), 1);
+            BOOST_REQUIRE(eosio::pack(s.games.at(0)) == eosio::pack(game_tokens.get(0)));
+            const auto global = casino::global_tokens_singleton(casino_account, casino_account.value).get();
+            BOOST_REQUIRE(eosio::pack(s.global) == eosio::pack(global));
+            return 0;
+        });
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(views_tests)
+
+BOOST_AUTO_TEST_CASE(views_follow_contract_tables) {
+    views_tester t;
+    native::casino_views views(t.config());
+    std::istringstream in("# recorded by the test\n" + t.stream());
+    BOOST_REQUIRE_EQUAL(views.consume(in), t.log.size());
+    BOOST_REQUIRE_EQUAL(views.failed(), 6);
+    BOOST_REQUIRE(views.last_error().find("assertion failure") != std::string::npos);
+    t.check(views);
+
+    const auto reader = views.make_reader();
+    const auto player = reader.player("pl.ha"_n);
+    BOOST_REQUIRE(player);
+    BOOST_REQUIRE_EQUAL(player->bonus_balance.at(t.core_symbol.raw()), 100 + 7);
+    BOOST_REQUIRE(!reader.player("pl.zzz"_n));
+    BOOST_REQUIRE_EQUAL(reader.game(0)->balance.at(t.core_symbol.raw()), reader.global().game_profits_sum.at(t.core_symbol.raw()));
+    BOOST_REQUIRE(!reader.game(1));
+}
+
+BOOST_AUTO_TEST_CASE(readers_see_published_snapshots) {
+    views_tester t;
+    native::casino_views views(t.config());
+
+    std::atomic<bool> done { false };
+    std::atomic<uint64_t> reads { 0 };
+    std::vector<std::thread> threads;
+    std::vector<std::string> errors(4);
+    for (size_t i = 0; i < errors.size(); ++i) {
+        threads.emplace_back([&, i] {
+            const auto reader = views.make_reader();
+            uint64_t last = 0;
+            while (!done.load()) {
+                reader.read([&](const auto& s) {
+                    // snapshots are published every 64 entries and never go back
+                    if (s.applied < last || s.applied % 64 != 0) {
+                        errors[i] = "unexpected snapshot at " + std::to_string(s.applied);
+                    }
+                    last = s.applied;
+                    uint64_t players = 0;
+                    for (const auto& shard: *s.players) {
+                        players += shard->size();
+                    }
+                    if (players != s.player_count) {
+                        errors[i] = "torn snapshot at " + std::to_string(s.applied);
+                    }
+                    return 0;
+                });
+                ++reads;
+            }
+        });
+    }
+
+    for (const auto& entry: t.log) {
+        views.apply(entry);
+    }
+    done = true;
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    for (const auto& error: errors) {
+        BOOST_REQUIRE_EQUAL(error, "");
+    }
+    BOOST_REQUIRE(reads.load() > 0);
+
+    views.publish();
+    t.check(views);
+}
+
+BOOST_AUTO_TEST_CASE(restored_checkpoint_continues_the_stream) {
+    views_tester t;
+    const auto half = t.log.size() / 2;
+    {
+        auto config = t.config();
+        config.checkpoint = t.checkpoint_path;
+        config.checkpoint_every = half;
+        native::casino_views views(config);
+        std::istringstream in(t.stream(0, half + 10));
+        views.consume(in);
+    }
+
+    native::casino_views views(t.config());
+    views.restore(t.checkpoint_path);
+    BOOST_REQUIRE_EQUAL(views.applied(), half);
+    BOOST_REQUIRE_EQUAL(views.make_reader().applied(), half);
+
+    std::istringstream in(t.stream());
+    BOOST_REQUIRE_EQUAL(views.consume(in, views.applied()), t.log.size() - half);
+    BOOST_REQUIRE_EQUAL(views.failed(), 6);
+    t.check(views);
+
+    BOOST_REQUIRE_EXCEPTION(views.restore(t.checkpoint_path), eosio::eosio_assert_error, [](const auto& e) {
+        return std::string(e.what()).find("before any entry") != std::string::npos;
+    });
+}
+
+BOOST_AUTO_TEST_CASE(reader_slots_are_limited) {
+    views_tester t;
+    auto config = t.config();
+    config.max_readers = 2;
+    native::casino_views views(config);
+
+    auto first = views.make_reader();
+    {
+        const auto second = views.make_reader();
+        BOOST_REQUIRE_THROW(views.make_reader(), std::runtime_error);
+    }
+    const auto moved = std::move(first);
+    const auto third = views.make_reader();
+    BOOST_REQUIRE_THROW(views.make_reader(), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(third.applied(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
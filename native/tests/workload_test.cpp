@@ -0,0 +1,244 @@
+#include "native_tester.hpp"
+
+#include <workload.hpp>
+
+
+namespace testing {
+
+// drives the native build with tests/workload.hpp traffic
+class workload_tester : public native_tester {
+public:
+    static constexpr name beneficiary = "wl.owner"_n;
+
+    const workload::config cfg;
+    std::vector<symbol> symbols;
+    std::vector<name> games;
+    std::vector<name> players;
+
+    explicit workload_tester(const workload::config& cfg): cfg(cfg) {
+        symbols.push_back(core_symbol);
+        for (uint32_t t = 1; t < cfg.tokens; ++t) {
+            const auto token_name = "TK" + std::string(1, char('A' + t - 1));
+            allow_token(token_name, 4, indexed_name("tok.", t));
+            symbols.emplace_back(token_name, 4);
+        }
+        for (uint32_t g = 0; g < cfg.games; ++g) {
+            games.push_back(indexed_name("game.", g));
+        }
+        for (uint32_t p = 0; p < cfg.players; ++p) {
+            players.push_back(indexed_name("pl.", p));
+        }
+        chain.create_accounts(games);
+        chain.create_accounts(players);
+        chain.create_account(beneficiary);
+    }
+
+    static name indexed_name(const std::string& prefix, uint64_t index) {
+        std::string suffix;
+        do {
+            suffix.insert(suffix.begin(), char('a' + index % 26));
+            index /= 26;
+        } while (index);
+        return name(prefix + suffix);
+    }
+
+    asset amount(const workload::op& o) const {
+        return asset(o.amount, symbols[o.token]);
+    }
+
+    std::string transfer_action(name from, name to, const asset& quantity, const std::string& memo = "") {
+        return chain.push_action(get_token_contract(quantity.symbol), "transfer"_n, from, from, to, quantity, memo);
+    }
+
+    // every action of an op, returns the first error
+    std::string push(const workload::op& o) {
+        using workload::op_type;
+        const auto game = o.game == workload::op::casino ? casino_account : games[o.game];
+        const auto player = players[o.player];
+
+        switch (o.type) {
+            case op_type::add_game: {
+                auto result = chain.push_action(platform_name, "addgame"_n, platform_name, game, uint16_t(1), bytes());
+                if (result.empty()) result = chain.push_action(platform_name, "setmargin"_n, platform_name, uint64_t(o.game), uint32_t(o.amount));
+                if (result.empty()) result = chain.push_action(platform_name, "setbenefic"_n, platform_name, uint64_t(o.game), game);
+                if (result.empty()) result = chain.push_action(casino_account, "addgame"_n, casino_account, uint64_t(o.game), game_params_type{{0, 0}});
+                return result;
+            }
+            case op_type::fund:
+                return transfer_action(system_account, game, amount(o));
+            case op_type::bonus_deposit:
+                return transfer_action(system_account, casino_account, amount(o), "bonus");
+            case op_type::greeting_bonus:
+                return chain.push_action(casino_account, "setgreetbon"_n, casino_account, amount(o));
+            case op_type::newplayer:
+                return chain.push_action(casino_account, "newplayer.t"_n, permission_level{platform_name, "gameaction"_n},
+                    player, symbols[o.token].code().to_string());
+            case op_type::open: {
+                auto result = chain.push_action(casino_account, "newsessionpl"_n, game, game, player);
+                if (result.empty()) result = chain.push_action(casino_account, "newsession"_n, game, game);
+                return result;
+            }
+            case op_type::update: {
+                auto result = chain.push_action(casino_account, "sesnewdepo2"_n, game, game, player, amount(o));
+                if (result.empty()) result = chain.push_action(casino_account, "sesupdate"_n, game, game, amount(o));
+                return result;
+            }
+            case op_type::payout:
+                return chain.push_action(casino_account, "sespayout"_n, game, game, player, amount(o));
+            case op_type::close:
+                return chain.push_action(casino_account, "sesclose"_n, game, game, amount(o));
+            case op_type::lock_bonus:
+                return chain.push_action(casino_account, "seslockbon"_n, game, game, player, amount(o));
+            case op_type::add_bonus:
+                return chain.push_action(casino_account, "sesaddbon"_n, game, game, player, amount(o));
+            case op_type::send_bonus:
+                return chain.push_action(casino_account, "sendbon"_n, casino_account, player, amount(o));
+            case op_type::transfer:
+                return transfer_action(game, casino_account, amount(o));
+            case op_type::loss:
+                return chain.push_action(casino_account, "onloss"_n, game, game, player, amount(o));
+            case op_type::claim:
+                return chain.push_action(casino_account, "claimprofit"_n, game, game);
+            case op_type::withdraw:
+                return chain.push_action(casino_account, "withdraw"_n, casino_account, beneficiary, amount(o));
+            case op_type::wait:
+                chain.advance(eosio::microseconds(o.amount));
+                return success();
+        }
+        return "unknown op";
+    }
+
+    void run(const workload::op& o) {
+        const auto result = push(o);
+        BOOST_REQUIRE_MESSAGE(result.empty(), workload::to_string(o) << ": " << result);
+    }
+
+    uint32_t token_index(uint64_t symbol_raw) const {
+        for (uint32_t t = 0; t < symbols.size(); ++t) {
+            if (symbols[t].raw() == symbol_raw) {
+                return t;
+            }
+        }
+        BOOST_FAIL("unknown token " << symbol_raw);
+        return 0;
+    }
+
+    std::map<uint32_t, int64_t> by_token(const std::map<uint64_t, int64_t>& amounts) const {
+        std::map<uint32_t, int64_t> result;
+        for (const auto& it: amounts) {
+            result[token_index(it.first)] = it.second;
+        }
+        return result;
+    }
+
+    workload::observed observe() {
+        workload::observed result;
+
+        casino::game_tokens_table game_tokens(casino_account, casino_account.value);
+        casino::game_state_table game_state(casino_account, casino_account.value);
+        result.games.resize(cfg.games);
+        for (uint32_t g = 0; g < cfg.games; ++g) {
+            const auto& tokens_row = game_tokens.get(g);
+            const auto& state_row = game_state.get(g);
+            auto& game = result.games[g];
+            game.balance = by_token(tokens_row.balance);
+            game.active_sum = by_token(tokens_row.active_sessions_sum);
+            game.core_balance = state_row.balance.amount;
+            game.core_active_sum = state_row.active_sessions_sum.amount;
+            game.sessions = state_row.active_sessions_amount;
+        }
+
+        const auto gtokens = casino::global_tokens_singleton(casino_account, casino_account.value).get();
+        result.profits_sum = by_token(gtokens.game_profits_sum);
+        result.active_sum = by_token(gtokens.game_active_sessions_sum);
+        result.allocated_bonus = by_token(gtokens.total_allocated_bonus);
+
+        const auto gstate = casino::global_state_singleton(casino_account, casino_account.value).get();
+        result.core_profits_sum = gstate.game_profits_sum.amount;
+        result.core_active_sum = gstate.game_active_sessions_sum.amount;
+        result.sessions = gstate.active_sessions_amount;
+        result.core_allocated_bonus = casino::bonus_pool_state_singleton(casino_account, casino_account.value).get().total_allocated.amount;
+
+        casino::player_tokens_table player_tokens(casino_account, casino_account.value);
+        casino::bonus_balance_table bonus_balance(casino_account, casino_account.value);
+        for (uint32_t p = 0; p < cfg.players; ++p) {
+            const auto tokens_row = player_tokens.find(players[p].value);
+            if (tokens_row != player_tokens.end()) {
+                result.bonus[p] = by_token(tokens_row->bonus_balance);
+            }
+            const auto bonus_row = bonus_balance.find(players[p].value);
+            if (bonus_row != bonus_balance.end()) {
+                result.core_bonus[p] = bonus_row->balance.amount;
+            }
+        }
+
+        for (const auto& symb: symbols) {
+            result.casino_balance.push_back(get_balance(casino_account, symb).amount);
+        }
+        return result;
+    }
+
+    void check(const workload::generator& gen, uint64_t step) {
+        for (const auto& violation: workload::check(gen.expected(), observe())) {
+            BOOST_ERROR("step " << step << ": " << violation);
+        }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(workload_tests)
+
+BOOST_AUTO_TEST_CASE(invariants_hold_under_random_traffic) {
+    workload::config cfg;
+    cfg.games = 8;
+    cfg.players = 200;
+    cfg.tokens = 3;
+
+    for (const uint64_t seed: {1, 2, 3}) {
+        cfg.seed = seed;
+        workload_tester t(cfg);
+        workload::generator gen(cfg);
+
+        for (const auto& o: gen.setup()) {
+            t.run(o);
+        }
+        t.check(gen, 0);
+
+        std::map<workload::op_type, uint32_t> counts;
+        for (uint64_t step = 1; step <= 20000; ++step) {
+            const auto o = gen.next();
+            counts[o.type]++;
+            t.run(o);
+            if (step % 1000 == 0) {
+                t.check(gen, step);
+            }
+        }
+
+        // every kind of traffic was generated
+        for (const auto& it: cfg.mix) {
+            BOOST_CHECK_MESSAGE(counts[it.first] > 0, "no " << workload::to_string(it.first) << " ops with seed " << seed);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(same_seed_same_traffic) {
+    workload::config cfg;
+    workload::generator a(cfg), b(cfg);
+    a.setup();
+    b.setup();
+    for (uint32_t i = 0; i < 5000; ++i) {
+        BOOST_REQUIRE_EQUAL(workload::to_string(a.next()), workload::to_string(b.next()));
+    }
+
+    cfg.seed = 2;
+    workload::generator c(cfg);
+    c.setup();
+    bool differs = false;
+    for (uint32_t i = 0; i < 100 && !differs; ++i) {
+        differs = workload::to_string(a.next()) != workload::to_string(c.next());
+    }
+    BOOST_REQUIRE(differs);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,144 @@
+// replays a recorded action log against the natively built contracts, see "Replay" in README.md
+#include <native/replay.hpp>
+#include <native/table_export.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+using namespace native;
+using namespace native::replay;
+
+namespace {
+
+constexpr size_t max_printed = 10;
+
+void usage() {
+    std::cerr << "usage: native_replay --platform NAME --casino NAME... [--events NAME...] [--token NAME...]\n"
+                 "                     [--threads N] [--dump FILE] [--export FILE] [--expected FILE] LOG\n";
+}
+
+std::vector<std::string> read_lines(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("can't open " + path);
+    }
+    std::vector<std::string> result;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) {
+            result.push_back(line);
+        }
+    }
+    return result;
+}
+
+void print_rows(const char* title, const std::vector<std::string>& rows) {
+    if (rows.empty()) {
+        return;
+    }
+    std::cout << title << ": " << rows.size() << "\n";
+    for (size_t i = 0; i < rows.size() && i < max_printed; ++i) {
+        std::cout << "  " << rows[i] << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    replay_config config;
+    config.tokens.clear();
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string log_path, dump_path, export_path, expected_path;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error(arg + " requires a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--platform") {
+                config.platform = name(value());
+            } else if (arg == "--casino") {
+                config.casinos.push_back(name(value()));
+            } else if (arg == "--events") {
+                config.events.push_back(name(value()));
+            } else if (arg == "--token") {
+                config.tokens.push_back(name(value()));
+            } else if (arg == "--threads") {
+                config.threads = std::stoul(value());
+            } else if (arg == "--dump") {
+                dump_path = value();
+            } else if (arg == "--export") {
+                export_path = value();
+            } else if (arg == "--expected") {
+                expected_path = value();
+            } else if (arg == "--help" || arg == "-h") {
+                usage();
+                return 0;
+            } else if (log_path.empty() && arg[0] != '-') {
+                log_path = arg;
+            } else {
+                throw std::runtime_error("unknown argument " + arg);
+            }
+        }
+        if (log_path.empty() || config.platform == name() || config.casinos.empty()) {
+            usage();
+            return 2;
+        }
+        if (config.tokens.empty()) {
+            config.tokens.push_back("eosio.token"_n);
+        }
+
+        std::ifstream in(log_path);
+        if (!in) {
+            throw std::runtime_error("can't open " + log_path);
+        }
+        const auto log = read_log(in);
+        const auto result = replayer(config).run(log);
+
+        std::cout << "replayed " << result.transactions << " transactions, " << result.executed_actions << " actions in "
+                  << result.seconds << "s, " << uint64_t(result.executed_actions / result.seconds) << " actions/s\n";
+        for (size_t s = 0; s < result.shards.size(); ++s) {
+            const auto& shard = result.shards[s];
+            std::cout << "  thread " << s << ": " << shard.contracts.size() << " contracts, " << shard.transactions
+                      << " transactions, " << shard.executed_actions << " actions in " << shard.seconds << "s\n";
+        }
+        std::cout << "skipped " << result.skipped << " actions of other contracts\n";
+        std::cout << "state: " << result.state.size() << " rows\n";
+
+        std::cout << "failed: " << result.failures.size() << "\n";
+        for (size_t i = 0; i < result.failures.size() && i < max_printed; ++i) {
+            std::cout << "  line " << result.failures[i].line << ": " << result.failures[i].message << "\n";
+        }
+
+        if (!dump_path.empty()) {
+            std::ofstream out(dump_path);
+            for (const auto& row: result.state) {
+                out << row << "\n";
+            }
+        }
+
+        if (!export_path.empty()) {
+            write_export(result.state, export_path);
+        }
+
+        bool diverged = false;
+        if (!expected_path.empty()) {
+            const auto diff = diff_state(read_lines(expected_path), result.state);
+            diverged = !diff.empty();
+            std::cout << "divergence from " << expected_path << ": " << (diverged ? "yes" : "none") << "\n";
+            print_rows("missing", diff.missing);
+            print_rows("unexpected", diff.unexpected);
+            print_rows("changed", diff.changed);
+        }
+
+        return result.failures.empty() && !diverged ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 2;
+    }
+}
@@ -0,0 +1,295 @@
+// reads exported contract tables, see "Table export" in README.md
+#include <native/columnar.hpp>
+#include <native/table_export.hpp>
+#include <native/replay.hpp>
+
+#include <casino/casino.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace native;
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: native_tables info EXPORT\n"
+                 "       native_tables rows EXPORT CODE TABLE [--scope NAME] [--from PK] [--to PK] [--limit N] [--decode]\n"
+                 "       native_tables totals EXPORT CASINO\n"
+                 "       native_tables import DUMP EXPORT\n"
+                 "       native_tables columnar EXPORT CASINO OUT [--group-rows N]\n"
+                 "       native_tables colinfo COLUMNAR\n"
+                 "       native_tables colsum COLUMNAR TABLE\n";
+}
+
+std::string amounts(const std::map<uint64_t, int64_t>& values) {
+    std::string result = "{";
+    for (const auto& [symbol_raw, amount]: values) {
+        if (result.size() > 1) {
+            result += ", ";
+        }
+        result += eosio::asset(amount, eosio::symbol(symbol_raw)).to_string();
+    }
+    return result + "}";
+}
+
+// casino accounting tables in a readable form, hex for everything else
+std::string decode(name table, const row_ref& row) {
+    if (table == "playertokens"_n) {
+        const auto r = row.as<casino::player_tokens_row>();
+        return r.player.to_string() + " bonus=" + amounts(r.bonus_balance) + " volume_real=" + amounts(r.volume_real)
+               + " volume_bonus=" + amounts(r.volume_bonus) + " profit_real=" + amounts(r.profit_real)
+               + " profit_bonus=" + amounts(r.profit_bonus);
+    }
+    if (table == "gametokens"_n) {
+        const auto r = row.as<casino::game_tokens_row>();
+        return "game " + std::to_string(r.game_id) + " balance=" + amounts(r.balance) + " active=" + amounts(r.active_sessions_sum);
+    }
+    if (table == "globaltokens"_n) {
+        const auto r = row.as<casino::global_tokens_state>();
+        return "active=" + amounts(r.game_active_sessions_sum) + " profits=" + amounts(r.game_profits_sum)
+               + " allocated_bonus=" + amounts(r.total_allocated_bonus) + " greeting_bonus=" + amounts(r.greeting_bonus);
+    }
+    return replay::to_hex(bytes(row.data, row.data + row.size));
+}
+
+int info(const std::string& path) {
+    const export_reader reader(path);
+    std::cout << path << ": " << reader.file_size() << " bytes\n";
+    for (const auto& table: reader.tables()) {
+        std::cout << "  " << table.code().to_string() << " " << table.table().to_string() << " " << table.size() << " rows\n";
+    }
+    return 0;
+}
+
+int rows(int argc, char** argv) {
+    if (argc < 5) {
+        usage();
+        return 2;
+    }
+    std::optional<uint64_t> scope;
+    uint64_t from = 0, to = uint64_t(-1), limit = uint64_t(-1);
+    bool decoded = false;
+    for (int i = 5; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error(arg + " requires a value");
+            }
+            return argv[++i];
+        };
+        if (arg == "--scope") {
+            scope = name(value()).value;
+        } else if (arg == "--from") {
+            from = std::stoull(value());
+        } else if (arg == "--to") {
+            to = std::stoull(value());
+        } else if (arg == "--limit") {
+            limit = std::stoull(value());
+        } else if (arg == "--decode") {
+            decoded = true;
+        } else {
+            throw std::runtime_error("unknown argument " + arg);
+        }
+    }
+
+    const export_reader reader(argv[2], export_reader::access::sequential);
+    const auto table = reader.get_table(name(argv[3]), name(argv[4]));
+    const auto print = [&](const row_ref& row) {
+        std::cout << name(row.scope).to_string() << " " << row.primary_key << " "
+                  << (decoded ? decode(table.table(), row) : replay::to_hex(bytes(row.data, row.data + row.size))) << "\n";
+    };
+
+    uint64_t printed = 0;
+    if (scope) {
+        for (const auto& row: table.scan(*scope, from, to)) {
+            if (printed++ == limit) break;
+            print(row);
+        }
+    } else {
+        for (const auto& row: table) {
+            if (row.primary_key < from || row.primary_key > to) continue;
+            if (printed++ == limit) break;
+            print(row);
+        }
+    }
+    return 0;
+}
+
+// volume and profit per token over all players, the finance report
+int totals(const std::string& path, name casino_account) {
+    const auto start = std::chrono::steady_clock::now();
+    const export_reader reader(path, export_reader::access::sequential);
+    const auto table = reader.get_table(casino_account, "playertokens"_n);
+
+    struct sums {
+        int64_t bonus = 0, volume_real = 0, volume_bonus = 0, profit_real = 0, profit_bonus = 0;
+    };
+    std::map<uint64_t, sums> result;
+    for (const auto& row: table.scan(casino_account.value)) {
+        const auto r = row.as<casino::player_tokens_row>();
+        for (const auto& [s, v]: r.bonus_balance) result[s].bonus += v;
+        for (const auto& [s, v]: r.volume_real) result[s].volume_real += v;
+        for (const auto& [s, v]: r.volume_bonus) result[s].volume_bonus += v;
+        for (const auto& [s, v]: r.profit_real) result[s].profit_real += v;
+        for (const auto& [s, v]: r.profit_bonus) result[s].profit_bonus += v;
+    }
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << table.size() << " players in " << seconds << "s\n";
+    for (const auto& [s, t]: result) {
+        const eosio::symbol symb(s);
+        std::cout << symb.code().to_string() << ": bonus " << eosio::asset(t.bonus, symb).to_string()
+                  << ", volume real " << eosio::asset(t.volume_real, symb).to_string()
+                  << ", volume bonus " << eosio::asset(t.volume_bonus, symb).to_string()
+                  << ", profit real " << eosio::asset(t.profit_real, symb).to_string()
+                  << ", profit bonus " << eosio::asset(t.profit_bonus, symb).to_string() << "\n";
+    }
+    return 0;
+}
+
+int import(const std::string& dump_path, const std::string& export_path) {
+    std::ifstream in(dump_path);
+    if (!in) {
+        throw std::runtime_error("can't open " + dump_path);
+    }
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+    }
+    write_export(std::move(lines), export_path);
+    return 0;
+}
+
+int columnar_export(int argc, char** argv) {
+    if (argc != 5 && !(argc == 7 && std::string(argv[5]) == "--group-rows")) {
+        usage();
+        return 2;
+    }
+    const auto group_rows = argc == 7 ? std::stoul(argv[6]) : columnar::default_group_rows;
+    const export_reader reader(argv[2], export_reader::access::sequential);
+    write_columnar(reader, name(argv[3]), argv[4], group_rows);
+    return 0;
+}
+
+std::string column_value(columnar::type column_type, uint64_t value) {
+    switch (column_type) {
+        case columnar::type::name: return name(value).to_string();
+        case columnar::type::symbol: return eosio::symbol(value).code().to_string();
+        case columnar::type::u64: return std::to_string(value);
+        case columnar::type::i64: return std::to_string(int64_t(value));
+    }
+    return {};
+}
+
+int column_info(const std::string& path) {
+    static const char* encodings[] = { "plain", "delta", "rle" };
+    const columnar_reader reader(path);
+    for (const auto& t: reader.tables()) {
+        std::cout << t.table_name.to_string() << ": " << t.rows << " rows in " << t.groups << " groups\n";
+        for (size_t c = 0; c < t.columns.size(); ++c) {
+            uint64_t bytes = 0;
+            std::map<std::string, uint32_t> used;
+            for (uint32_t g = 0; g < t.groups; ++g) {
+                const auto& chunk = t.chunk(g, c);
+                bytes += chunk.size;
+                used[encodings[size_t(chunk.chunk_encoding)]]++;
+            }
+            const auto [min, max] = t.stats(c);
+            std::cout << "  " << t.columns[c].name << " " << bytes << " bytes";
+            for (const auto& [encoding, chunks]: used) {
+                std::cout << " " << encoding << "x" << chunks;
+            }
+            std::cout << " min " << column_value(t.columns[c].column_type, min)
+                      << " max " << column_value(t.columns[c].column_type, max) << "\n";
+        }
+    }
+    return 0;
+}
+
+// sums of every amount column per token, groups holding one token are summed without a per-row lookup
+int column_sums(const std::string& path, name table_name) {
+    const auto start = std::chrono::steady_clock::now();
+    const columnar_reader reader(path);
+    const auto& t = reader.get_table(table_name);
+
+    std::vector<size_t> columns { t.column_index("symbol") };
+    for (size_t c = 0; c < t.columns.size(); ++c) {
+        if (t.columns[c].column_type == columnar::type::i64) {
+            columns.push_back(c);
+        }
+    }
+    const auto amounts = columns.size() - 1;
+
+    std::map<uint64_t, std::vector<int64_t>> sums;
+    reader.scan(t, columns, [&](uint32_t group, size_t rows, const std::vector<const uint64_t*>& values) {
+        const auto& symbols = t.chunk(group, columns[0]);
+        if (symbols.min == symbols.max) {
+            auto& result = sums.try_emplace(symbols.min, amounts).first->second;
+            for (size_t a = 0; a < amounts; ++a) {
+                const auto* column = values[a + 1];
+                int64_t sum = 0;
+                for (size_t r = 0; r < rows; ++r) {
+                    sum += int64_t(column[r]);
+                }
+                result[a] += sum;
+            }
+            return;
+        }
+        for (size_t r = 0; r < rows; ++r) {
+            auto& result = sums.try_emplace(values[0][r], amounts).first->second;
+            for (size_t a = 0; a < amounts; ++a) {
+                result[a] += int64_t(values[a + 1][r]);
+            }
+        }
+    });
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << t.rows << " rows in " << seconds << "s\n";
+    for (const auto& [symbol_raw, result]: sums) {
+        const eosio::symbol symb(symbol_raw);
+        std::cout << symb.code().to_string() << ":";
+        for (size_t a = 0; a < amounts; ++a) {
+            std::cout << (a ? ", " : " ") << t.columns[columns[a + 1]].name << " " << eosio::asset(result[a], symb).to_string();
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+    const std::string command = argv[1];
+    try {
+        if (command == "info") {
+            return info(argv[2]);
+        } else if (command == "rows") {
+            return rows(argc, argv);
+        } else if (command == "totals" && argc == 4) {
+            return totals(argv[2], name(argv[3]));
+        } else if (command == "import" && argc == 4) {
+            return import(argv[2], argv[3]);
+        } else if (command == "columnar") {
+            return columnar_export(argc, argv);
+        } else if (command == "colinfo") {
+            return column_info(argv[2]);
+        } else if (command == "colsum" && argc == 4) {
+            return column_sums(argv[2], name(argv[3]));
+        }
+        usage();
+        return 2;
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 2;
+    }
+}
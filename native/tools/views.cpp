@@ -0,0 +1,106 @@
+// keeps casino balance views up to date from an action stream, see "Materialized views" in README.md
+#include <native/views.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+using namespace native;
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: native_views --platform NAME --casino NAME [--token NAME...] [--publish-every N]\n"
+                 "                    [--checkpoint FILE] [--checkpoint-every N] [--resume] LOG|-\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    views_config config;
+    config.tokens.clear();
+    std::string log_path;
+    bool resume = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error(arg + " requires a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--platform") {
+                config.platform = name(value());
+            } else if (arg == "--casino") {
+                config.casino = name(value());
+            } else if (arg == "--token") {
+                config.tokens.push_back(name(value()));
+            } else if (arg == "--publish-every") {
+                config.publish_every = std::stoull(value());
+            } else if (arg == "--checkpoint") {
+                config.checkpoint = value();
+            } else if (arg == "--checkpoint-every") {
+                config.checkpoint_every = std::stoull(value());
+            } else if (arg == "--resume") {
+                resume = true;
+            } else if (arg == "--help" || arg == "-h") {
+                usage();
+                return 0;
+            } else if (log_path.empty() && (arg == "-" || arg[0] != '-')) {
+                log_path = arg;
+            } else {
+                throw std::runtime_error("unknown argument " + arg);
+            }
+        }
+        if (log_path.empty() || config.platform == name() || config.casino == name() || (resume && config.checkpoint.empty())) {
+            usage();
+            return 2;
+        }
+        if (config.tokens.empty()) {
+            config.tokens.push_back("eosio.token"_n);
+        }
+
+        casino_views views(config);
+        if (resume) {
+            views.restore(config.checkpoint);
+            std::cout << "restored " << config.checkpoint << " at entry " << views.applied() << "\n";
+        }
+
+        std::ifstream file;
+        if (log_path != "-") {
+            file.open(log_path);
+            if (!file) {
+                throw std::runtime_error("can't open " + log_path);
+            }
+        }
+        // a restored stream starts over from the first entry, a pipe continues where the checkpoint stopped
+        const auto skip = resume && log_path != "-" ? views.applied() : 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto applied = views.consume(log_path == "-" ? std::cin : file, skip);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!config.checkpoint.empty()) {
+            views.checkpoint(config.checkpoint);
+        }
+
+        const auto reader = views.make_reader();
+        reader.read([&](const casino_views::snapshot& s) {
+            std::cout << "applied " << applied << " entries in " << seconds << "s, " << uint64_t(applied / std::max(seconds, 1e-9))
+                      << " entries/s, " << views.failed() << " failed\n";
+            std::cout << s.player_count << " players, " << s.games.size() << " games\n";
+            for (const auto& [symbol_raw, amount]: s.global.game_profits_sum) {
+                std::cout << "  profits " << eosio::asset(amount, eosio::symbol(symbol_raw)).to_string() << "\n";
+            }
+            return 0;
+        });
+        if (views.failed()) {
+            std::cout << "last failure " << views.last_error() << "\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 2;
+    }
+}
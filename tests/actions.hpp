@@ -0,0 +1,199 @@
+#pragma once
+
+#include <eosio/chain/action.hpp>
+#include <eosio/chain/asset.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Typed builders of platform, casino and events actions. Arguments are packed with fc::raw in the order
+// of the action signature, so no abi_serializer/variant round trip is involved. Every builder sets the
+// authorization the contract checks. Keep in sync with contracts/*/include.
+namespace testing {
+namespace actions {
+
+using eosio::chain::action;
+using eosio::chain::asset;
+using eosio::chain::name;
+using eosio::chain::permission_level;
+using eosio::chain::symbol;
+
+using bytes = std::vector<char>;
+using game_params_type = std::vector<std::pair<uint16_t, uint64_t>>;
+
+template <typename... Args>
+bytes pack_args(const Args&... args) {
+    fc::datastream<size_t> ps;
+    (fc::raw::pack(ps, args), ...);
+    bytes result(ps.tellp());
+    fc::datastream<char*> ds(result.data(), result.size());
+    (fc::raw::pack(ds, args), ...);
+    return result;
+}
+
+template <typename... Args>
+action make(name contract, name action_name, const permission_level& auth, const Args&... args) {
+    action act;
+    act.account = contract;
+    act.name = action_name;
+    act.authorization.push_back(auth);
+    act.data = pack_args(args...);
+    return act;
+}
+
+inline permission_level active(name actor) {
+    return { actor, N(active) };
+}
+
+class platform {
+public:
+    explicit platform(name contract): contract(contract) {}
+
+    action setrsakey(const std::string& rsa_pubkey) const { return make(contract, N(setrsakey), self(), rsa_pubkey); }
+    action setrsabin(const bytes& modulus, uint32_t exponent) const { return make(contract, N(setrsabin), self(), modulus, exponent); }
+
+    action addcas(name casino, const bytes& meta = {}) const { return make(contract, N(addcas), self(), casino, meta); }
+    action delcas(uint64_t id) const { return make(contract, N(delcas), self(), id); }
+    action pausecas(uint64_t id, bool pause) const { return make(contract, N(pausecas), self(), id, pause); }
+    action setcontrcas(uint64_t id, name casino) const { return make(contract, N(setcontrcas), self(), id, casino); }
+    action setmetacas(uint64_t id, const bytes& meta) const { return make(contract, N(setmetacas), self(), id, meta); }
+    action setrsacas(uint64_t id, const std::string& rsa_pubkey) const { return make(contract, N(setrsacas), self(), id, rsa_pubkey); }
+    action setrsacasbin(uint64_t id, const bytes& modulus, uint32_t exponent) const { return make(contract, N(setrsacasbin), self(), id, modulus, exponent); }
+    action droprsastr(uint64_t id) const { return make(contract, N(droprsastr), self(), id); }
+    action pausecasinos(const std::vector<uint64_t>& ids, bool pause) const { return make(contract, N(pausecasinos), self(), ids, pause); }
+
+    action addgame(name game, uint16_t params_cnt, const bytes& meta = {}) const { return make(contract, N(addgame), self(), game, params_cnt, meta); }
+    action delgame(uint64_t id) const { return make(contract, N(delgame), self(), id); }
+    action pausegame(uint64_t id, bool pause) const { return make(contract, N(pausegame), self(), id, pause); }
+    action setcontrgame(uint64_t id, name game) const { return make(contract, N(setcontrgame), self(), id, game); }
+    action setmetagame(uint64_t id, const bytes& meta) const { return make(contract, N(setmetagame), self(), id, meta); }
+    action setmargin(uint64_t id, uint32_t profit_margin) const { return make(contract, N(setmargin), self(), id, profit_margin); }
+    action setbenefic(uint64_t id, name beneficiary) const { return make(contract, N(setbenefic), self(), id, beneficiary); }
+    action pausegames(const std::vector<uint64_t>& ids, bool pause) const { return make(contract, N(pausegames), self(), ids, pause); }
+
+    action addtoken(const std::string& token_name, name token_contract) const { return make(contract, N(addtoken), self(), token_name, token_contract); }
+    action deltoken(const std::string& token_name) const { return make(contract, N(deltoken), self(), token_name); }
+
+    action banplayer(name player) const { return make(contract, N(banplayer), self(), player); }
+    action unbanplayer(name player) const { return make(contract, N(unbanplayer), self(), player); }
+    action migrateactiv(uint64_t from, uint32_t count) const { return make(contract, N(migrateactiv), self(), from, count); }
+    action dellistcas(uint64_t id, uint32_t count) const { return make(contract, N(dellistcas), self(), id, count); }
+    action dellistgame(uint64_t id, uint32_t count) const { return make(contract, N(dellistgame), self(), id, count); }
+
+    const name contract;
+
+private:
+    permission_level self() const { return active(contract); }
+};
+
+class casino {
+public:
+    // owner and bonus admin are the casino account until changed with setowner/setadminbon
+    casino(name contract, name platform):
+        contract(contract),
+        platform(platform),
+        owner(contract),
+        bonus_admin(contract)
+    {}
+
+    action setplatform(name platform_name) const { return make(contract, N(setplatform), active(owner), platform_name); }
+    action setowner(name new_owner) const { return make(contract, N(setowner), active(owner), new_owner); }
+    action addgame(uint64_t game_id, const game_params_type& params) const { return make(contract, N(addgame), active(owner), game_id, params); }
+    action rmgame(uint64_t game_id) const { return make(contract, N(rmgame), active(owner), game_id); }
+    action setgameparam(uint64_t game_id, const game_params_type& params) const { return make(contract, N(setgameparam), active(owner), game_id, params); }
+    action setgameparam2(uint64_t game_id, const std::string& token, const game_params_type& params) const {
+        return make(contract, N(setgameparam2), active(owner), game_id, token, params);
+    }
+    action pausegame(uint64_t game_id, bool pause) const { return make(contract, N(pausegame), self(), game_id, pause); }
+    action withdraw(name beneficiary, const asset& quantity) const { return make(contract, N(withdraw), active(owner), beneficiary, quantity); }
+    action claimprofit(name game) const { return make(contract, N(claimprofit), active(game), game); }
+
+    action addtoken(const std::string& token_name) const { return make(contract, N(addtoken), self(), token_name); }
+    action rmtoken(const std::string& token_name) const { return make(contract, N(rmtoken), self(), token_name); }
+    action pausetoken(const std::string& token_name, bool pause) const { return make(contract, N(pausetoken), self(), token_name, pause); }
+    action setpaythr(const std::string& token_name, int64_t threshold) const {
+        return make(contract, N(setpaythr), self(), token_name, threshold);
+    }
+    action settle(const symbol& symb, uint32_t count) const { return make(contract, N(settle), active(owner), symb, count); }
+    action migratetoken() const { return make(contract, N(migratetoken), active(owner)); }
+    action migratenobon(uint64_t from, uint32_t count) const { return make(contract, N(migratenobon), active(owner), from, count); }
+    action migrateboard(name from, uint32_t count) const { return make(contract, N(migrateboard), active(owner), from, count); }
+    action migrateparam(uint64_t from, uint32_t count) const { return make(contract, N(migrateparam), active(owner), from, count); }
+    action synclisting(uint64_t from, uint32_t count) const { return make(contract, N(synclisting), active(owner), from, count); }
+
+    // session flow, sent by the game contract
+    action newsession(name game) const { return make(contract, N(newsession), active(game), game); }
+    action newsessionpl(name game, name player) const { return make(contract, N(newsessionpl), active(game), game, player); }
+    action sesnewdepo(name game, const asset& quantity) const { return make(contract, N(sesnewdepo), active(game), game, quantity); }
+    action sesnewdepo2(name game, name player, const asset& quantity) const { return make(contract, N(sesnewdepo2), active(game), game, player, quantity); }
+    action sesupdate(name game, const asset& max_win_delta) const { return make(contract, N(sesupdate), active(game), game, max_win_delta); }
+    action sespayout(name game, name player, const asset& quantity) const { return make(contract, N(sespayout), active(game), game, player, quantity); }
+    action sesclose(name game, const asset& quantity) const { return make(contract, N(sesclose), active(game), game, quantity); }
+    action onloss(name game, name player, const asset& quantity) const { return make(contract, N(onloss), active(game), game, player, quantity); }
+    action seslockbon(name game, name player, const asset& amount) const { return make(contract, N(seslockbon), active(game), game, player, amount); }
+    action sesaddbon(name game, name player, const asset& amount) const { return make(contract, N(sesaddbon), active(game), game, player, amount); }
+
+    // bonus pool
+    action setadminbon(name new_admin) const { return make(contract, N(setadminbon), active(owner), new_admin); }
+    action withdrawbon(name to, const asset& quantity, const std::string& memo = "") const { return make(contract, N(withdrawbon), active(owner), to, quantity, memo); }
+    action sendbon(name to, const asset& amount) const { return make(contract, N(sendbon), active(bonus_admin), to, amount); }
+    action subtractbon(name from, const asset& amount) const { return make(contract, N(subtractbon), active(bonus_admin), from, amount); }
+    action convertbon(name account, const std::string& memo = "") const { return make(contract, N(convertbon), active(bonus_admin), account, memo); }
+    action convertbon_t(name account, const symbol& symb, const std::string& memo = "") const {
+        return make(contract, N(convertbon.t), active(bonus_admin), account, symb, memo);
+    }
+    action convertbon_b(const std::vector<name>& accounts, const symbol& symb, const std::string& memo = "") const {
+        return make(contract, N(convertbon.b), active(bonus_admin), accounts, symb, memo);
+    }
+    action setgreetbon(const asset& amount) const { return make(contract, N(setgreetbon), active(bonus_admin), amount); }
+    action addgamenobon(name game) const { return make(contract, N(addgamenobon), active(bonus_admin), game); }
+    action rmgamenobon(name game) const { return make(contract, N(rmgamenobon), active(bonus_admin), game); }
+
+    // sent by the platform on player sign up
+    action newplayer(name player) const { return make(contract, N(newplayer), gameaction(), player); }
+    action newplayer_t(name player, const std::string& token) const { return make(contract, N(newplayer.t), gameaction(), player, token); }
+    action newplayer_b(const std::vector<name>& players, const std::string& token) const {
+        return make(contract, N(newplayer.b), gameaction(), players, token);
+    }
+    action sendbon_b(const symbol& symb, const std::vector<std::pair<name, int64_t>>& credits) const {
+        return make(contract, N(sendbon.b), active(bonus_admin), symb, credits);
+    }
+
+    const name contract;
+    const name platform;
+    name owner;
+    name bonus_admin;
+
+private:
+    permission_level self() const { return active(contract); }
+    permission_level gameaction() const { return { platform, N(gameaction) }; }
+};
+
+class events {
+public:
+    explicit events(name contract): contract(contract) {}
+
+    action setplatform(name platform_name) const { return make(contract, N(setplatform), active(contract), platform_name); }
+    action send(name sender, uint64_t casino_id, uint64_t game_id, uint64_t req_id, uint32_t event_type, const bytes& data = {}) const {
+        return make(contract, N(send), active(sender), sender, casino_id, game_id, req_id, event_type, data);
+    }
+
+    const name contract;
+};
+
+class token {
+public:
+    explicit token(name contract): contract(contract) {}
+
+    action transfer(name from, name to, const asset& quantity, const std::string& memo = "") const {
+        return make(contract, N(transfer), active(from), from, to, quantity, memo);
+    }
+
+    const name contract;
+};
+
+} // namespace actions
+} // namespace testing
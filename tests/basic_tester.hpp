@@ -3,11 +3,18 @@
 #include <eosio/testing/tester.hpp>
 #include <eosio/chain/abi_serializer.hpp>
 #include <eosio/chain/resource_limits.hpp>
+#include <eosio/chain/snapshot.hpp>
+#include "actions.hpp"
 #include "contracts.hpp"
+#include "table_rows.hpp"
 #include "test_symbol.hpp"
 
 #include <fc/variant_object.hpp>
 #include <fstream>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <typeindex>
 
 using namespace eosio::chain;
 using namespace eosio::testing;
@@ -72,17 +79,116 @@ public:
                                 ("memo",     memo) );
     }
 
-    action_result push_action( const action_name& contract, const action_name &name, const action_name &actor, const variant_object& data) {
+    action make_action( const action_name& contract, const action_name &name, const permission_level& auth, const variant_object& data) {
         string action_type_name = abi_ser[contract].get_action_type(name);
 
         action act;
         act.account = contract;
         act.name = name;
+        act.authorization.push_back(auth);
         act.data = abi_ser[contract].variant_to_binary( action_type_name, data, abi_serializer_max_time );
+        return act;
+    }
 
+    action_result push_action( const action_name& contract, const action_name &name, const action_name &actor, const variant_object& data) {
+        auto act = make_action(contract, name, {actor, config::active_name}, data);
         return base_tester::push_action( std::move(act), actor);
    }
 
+    action_result push_action(action act) {
+        const auto actor = act.authorization.at(0).actor;
+        return base_tester::push_action(std::move(act), actor);
+    }
+
+    // pushes prebuilt actions (see actions.hpp) in transactions of up to actions_per_trx actions signed by
+    // all of their authorizers, a block is produced after every transaction; stops at the first failure
+    action_result push_actions(std::vector<action> actions, size_t actions_per_trx = 100) {
+        for (size_t begin = 0; begin < actions.size(); begin += actions_per_trx) {
+            const auto end = std::min(begin + actions_per_trx, actions.size());
+
+            signed_transaction trx;
+            std::set<permission_level> signers;
+            for (size_t i = begin; i < end; ++i) {
+                signers.insert(actions[i].authorization.begin(), actions[i].authorization.end());
+                trx.actions.emplace_back(std::move(actions[i]));
+            }
+            set_transaction_headers(trx);
+            for (const auto& auth: signers) {
+                trx.sign(get_private_key(auth.actor, auth.permission.to_string()), control->get_chain_id());
+            }
+            try {
+                push_transaction(trx);
+            } catch (const fc::exception& ex) {
+                return error(ex.top_message());
+            }
+            produce_block();
+        }
+        return success();
+    }
+
+    // Runs the fixture setup once per test binary and snapshots the chain after it, every other
+    // instance of the fixture is restored from that snapshot instead of repeating the setup.
+    // Define NO_FIXTURE_SNAPSHOT to always run the setup.
+    template <typename Fixture>
+    void cached_fixture(const std::function<void()>& setup) {
+#ifdef NO_FIXTURE_SNAPSHOT
+        setup();
+#else
+        auto& snapshots = fixture_snapshots();
+        const auto it = snapshots.find(typeid(Fixture));
+        if (it != snapshots.end()) {
+            restore_snapshot(it->second);
+            return;
+        }
+        setup();
+        snapshots.emplace(typeid(Fixture), take_snapshot());
+#endif
+    }
+
+private:
+    struct fixture_snapshot {
+        std::string state;
+        std::map<account_name, abi_serializer> abi_ser;
+    };
+
+    static std::map<std::type_index, fixture_snapshot>& fixture_snapshots() {
+        static std::map<std::type_index, fixture_snapshot> snapshots;
+        return snapshots;
+    }
+
+    fixture_snapshot take_snapshot() {
+        // snapshot can't be taken with a pending block, the next push or produce starts a new one
+        control->abort_block();
+        std::ostringstream stream;
+        auto writer = std::make_shared<ostream_snapshot_writer>(stream);
+        control->write_snapshot(writer);
+        writer->finalize();
+        return { stream.str(), abi_ser };
+    }
+
+    void restore_snapshot(const fixture_snapshot& snapshot) {
+        close();
+        fc::remove_all(cfg.blocks_dir);
+        fc::remove_all(cfg.state_dir);
+        std::istringstream stream(snapshot.state);
+        open(std::make_shared<istream_snapshot_reader>(stream));
+        restore_validating_node(*this, snapshot.state);
+        abi_ser = snapshot.abi_ser;
+    }
+
+    static void restore_validating_node(base_tester&, const std::string&) {}
+
+    // validating_tester replays every produced block on a second node, it has to start from the same state
+    static void restore_validating_node(validating_tester& t, const std::string& state) {
+        t.validating_node.reset();
+        fc::remove_all(t.vcfg.blocks_dir);
+        fc::remove_all(t.vcfg.state_dir);
+        std::istringstream stream(state);
+        t.validating_node = std::make_unique<controller>(t.vcfg, make_protocol_feature_set());
+        t.validating_node->add_indices();
+        t.validating_node->startup([]() { return false; }, std::make_shared<istream_snapshot_reader>(stream));
+    }
+
 public:
     std::map<account_name, abi_serializer> abi_ser;
 };
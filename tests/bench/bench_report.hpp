@@ -0,0 +1,231 @@
+#pragma once
+
+#include <boost/test/unit_test.hpp>
+#include <fc/io/json.hpp>
+#include <fc/variant_object.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace testing {
+
+// command line options, passed after `--`:
+//   bench_test -- --players=1,1000 --games=1,500 --tokens=1,20 --samples=50
+//                 --out=bench.json --compare=baseline.json --max-regression=10
+//                 --ram-players=1000 --ram-games=50 --ram-tokens=5 --ram-out=ram.json
+//                 --golden=db_profile.golden.json --update-golden
+//                 --load-block-actions=100,500,1000 --load-steps=20000 --load-seed=1
+//                 --load-players=1000 --load-games=20 --load-tokens=3
+struct bench_config {
+    std::vector<uint32_t> players { 1, 1000, 100000 };
+    std::vector<uint32_t> games { 1, 50, 500 };
+    std::vector<uint32_t> tokens { 1, 5, 20 };
+    uint32_t samples { 50 };
+    std::string out { "bench.json" };
+    std::string compare; // baseline report, comparison is skipped if empty
+    double max_regression { 0 }; // allowed cpu median growth in percents, 0 - report only
+
+    // ram report scale
+    uint32_t ram_players { 1000 };
+    uint32_t ram_games { 50 };
+    uint32_t ram_tokens { 5 };
+    std::string ram_out { "ram.json" };
+
+    // db intrinsics profile, golden file with expected op counts per action
+#ifdef DB_PROFILE_GOLDEN
+    std::string golden { DB_PROFILE_GOLDEN };
+#else
+    std::string golden { "db_profile.golden.json" };
+#endif
+    bool update_golden { false };
+
+    // workload traffic packed into blocks of every given size until the block cpu budget breaks
+    std::vector<uint32_t> load_block_actions { 100, 500, 1000, 2000, 5000 };
+    uint64_t load_steps { 20000 };
+    uint64_t load_seed { 1 };
+    uint32_t load_players { 1000 };
+    uint32_t load_games { 20 };
+    uint32_t load_tokens { 3 };
+
+    static const bench_config& get() {
+        static const bench_config config = parse(
+            boost::unit_test::framework::master_test_suite().argc,
+            boost::unit_test::framework::master_test_suite().argv
+        );
+        return config;
+    }
+
+private:
+    static std::vector<uint32_t> parse_list(const std::string& value) {
+        std::vector<uint32_t> result;
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            result.push_back(std::stoul(item));
+        }
+        return result;
+    }
+
+    static bench_config parse(int argc, char** argv) {
+        bench_config config;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--update-golden") {
+                config.update_golden = true;
+                continue;
+            }
+            const auto eq = arg.find('=');
+            if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) {
+                continue;
+            }
+            const auto key = arg.substr(2, eq - 2);
+            const auto value = arg.substr(eq + 1);
+            if (key == "players") {
+                config.players = parse_list(value);
+            } else if (key == "games") {
+                config.games = parse_list(value);
+            } else if (key == "tokens") {
+                config.tokens = parse_list(value);
+            } else if (key == "samples") {
+                config.samples = std::stoul(value);
+            } else if (key == "out") {
+                config.out = value;
+            } else if (key == "compare") {
+                config.compare = value;
+            } else if (key == "max-regression") {
+                config.max_regression = std::stod(value);
+            } else if (key == "ram-players") {
+                config.ram_players = std::stoul(value);
+            } else if (key == "ram-games") {
+                config.ram_games = std::stoul(value);
+            } else if (key == "ram-tokens") {
+                config.ram_tokens = std::stoul(value);
+            } else if (key == "ram-out") {
+                config.ram_out = value;
+            } else if (key == "golden") {
+                config.golden = value;
+            } else if (key == "load-block-actions") {
+                config.load_block_actions = parse_list(value);
+            } else if (key == "load-steps") {
+                config.load_steps = std::stoull(value);
+            } else if (key == "load-seed") {
+                config.load_seed = std::stoull(value);
+            } else if (key == "load-players") {
+                config.load_players = std::stoul(value);
+            } else if (key == "load-games") {
+                config.load_games = std::stoul(value);
+            } else if (key == "load-tokens") {
+                config.load_tokens = std::stoul(value);
+            }
+        }
+        return config;
+    }
+};
+
+// billed resources of a single action measured at a single state size
+struct bench_stats {
+    uint32_t median;
+    uint32_t p99;
+
+    static bench_stats from_samples(std::vector<uint32_t> samples) {
+        if (samples.empty()) {
+            return { 0, 0 };
+        }
+        std::sort(samples.begin(), samples.end());
+        // nearest-rank percentile
+        const auto rank = [&](double p) {
+            const auto idx = static_cast<size_t>(std::ceil(p * samples.size()));
+            return samples[std::max<size_t>(idx, 1) - 1];
+        };
+        return { rank(0.5), rank(0.99) };
+    }
+};
+
+class bench_report {
+public:
+    // dimension is the swept state parameter: "players", "games" or "tokens"
+    using key_type = std::tuple<std::string, std::string, uint32_t>; // action, dimension, size
+
+    static bench_report& instance() {
+        static bench_report report;
+        return report;
+    }
+
+    void add(const std::string& action, const std::string& dimension, uint32_t size, uint32_t cpu_us, uint32_t net_bytes) {
+        auto& s = samples[key_type{action, dimension, size}];
+        s.first.push_back(cpu_us);
+        s.second.push_back(net_bytes);
+    }
+
+    fc::variant to_variant() const {
+        fc::variants results;
+        for (const auto& it: samples) {
+            const auto cpu = bench_stats::from_samples(it.second.first);
+            const auto net = bench_stats::from_samples(it.second.second);
+            results.push_back(fc::mutable_variant_object()
+                ("action", std::get<0>(it.first))
+                ("dimension", std::get<1>(it.first))
+                ("size", std::get<2>(it.first))
+                ("samples", it.second.first.size())
+                ("cpu_us", fc::mutable_variant_object()("median", cpu.median)("p99", cpu.p99))
+                ("net_bytes", fc::mutable_variant_object()("median", net.median)("p99", net.p99))
+            );
+        }
+        return fc::mutable_variant_object()("results", results);
+    }
+
+    void save(const std::string& path) const {
+        fc::json::save_to_file(to_variant(), path, true);
+    }
+
+    // prints baseline vs current table, returns list of actions which cpu median grew over max_regression
+    std::vector<std::string> compare(const std::string& baseline_path, double max_regression) const {
+        std::map<key_type, fc::variant> baseline;
+        for (const auto& row: fc::json::from_file(baseline_path)["results"].get_array()) {
+            baseline[key_type{
+                row["action"].as_string(),
+                row["dimension"].as_string(),
+                row["size"].as<uint32_t>()
+            }] = row;
+        }
+
+        std::vector<std::string> regressions;
+        std::cout << std::left << std::setw(28) << "action" << std::setw(10) << "dim" << std::setw(8) << "size"
+                  << std::right << std::setw(12) << "cpu med" << std::setw(12) << "base med"
+                  << std::setw(12) << "cpu p99" << std::setw(12) << "base p99" << std::setw(10) << "delta" << std::endl;
+
+        for (const auto& it: samples) {
+            const auto base_it = baseline.find(it.first);
+            if (base_it == baseline.end()) {
+                continue;
+            }
+            const auto cpu = bench_stats::from_samples(it.second.first);
+            const auto base_median = base_it->second["cpu_us"]["median"].as<uint32_t>();
+            const auto base_p99 = base_it->second["cpu_us"]["p99"].as<uint32_t>();
+            const double delta = base_median ? 100.0 * (double(cpu.median) - base_median) / base_median : 0;
+
+            std::cout << std::left << std::setw(28) << std::get<0>(it.first) << std::setw(10) << std::get<1>(it.first)
+                      << std::setw(8) << std::get<2>(it.first) << std::right
+                      << std::setw(12) << cpu.median << std::setw(12) << base_median
+                      << std::setw(12) << cpu.p99 << std::setw(12) << base_p99
+                      << std::setw(9) << std::fixed << std::setprecision(1) << delta << "%" << std::endl;
+
+            if (max_regression > 0 && delta > max_regression) {
+                regressions.push_back(std::get<0>(it.first) + "/" + std::get<1>(it.first) + "=" + std::to_string(std::get<2>(it.first)));
+            }
+        }
+        return regressions;
+    }
+
+private:
+    std::map<key_type, std::pair<std::vector<uint32_t>, std::vector<uint32_t>>> samples; // cpu_us, net_bytes
+};
+
+} // namespace testing
@@ -0,0 +1,63 @@
+#include "bench_tester.hpp"
+
+
+namespace testing {
+
+// measures every action `samples` times at a given scale, `size` is the value of the swept dimension
+static void run_actions(bench_tester& t, const std::string& dimension, uint32_t size) {
+    const auto& cfg = bench_config::get();
+
+    for (uint32_t i = 0; i < cfg.samples; ++i) {
+        for (auto& it: t.sample_actions(i)) {
+            t.measure(it.first, dimension, size, std::move(it.second));
+        }
+        t.produce_block();
+    }
+}
+
+static void sweep(const std::string& dimension, const std::vector<uint32_t>& sizes) {
+    const auto& cfg = bench_config::get();
+
+    for (const auto size: sizes) {
+        bench_scale scale { 1, 1, 1 };
+        if (dimension == "players") {
+            scale.players = size;
+        } else if (dimension == "games") {
+            scale.games = size;
+        } else {
+            scale.tokens = size;
+        }
+
+        BOOST_TEST_MESSAGE("bench " << dimension << "=" << size);
+        bench_tester t(scale);
+        run_actions(t, dimension, size);
+    }
+
+    auto& report = bench_report::instance();
+    report.save(cfg.out);
+
+    if (!cfg.compare.empty()) {
+        const auto regressions = report.compare(cfg.compare, cfg.max_regression);
+        for (const auto& r: regressions) {
+            BOOST_ERROR("cpu regression: " << r);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(bench)
+
+BOOST_AUTO_TEST_CASE(players) try {
+    sweep("players", bench_config::get().players);
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(games) try {
+    sweep("games", bench_config::get().games);
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_CASE(tokens) try {
+    sweep("tokens", bench_config::get().tokens);
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "basic_tester.hpp"
+#include "bench_report.hpp"
+
+namespace testing {
+
+using bytes = std::vector<char>;
+using game_params_type = std::vector<std::pair<uint16_t, uint64_t>>;
+
+// state the fixture is populated to before measuring
+struct bench_scale {
+    uint32_t players;
+    uint32_t games;
+    uint32_t tokens;
+};
+
+// chain with platform, casino and events contracts populated to a given scale,
+// every measured action is pushed in its own transaction with objective cpu billing
+class bench_tester : public basic_tester {
+public:
+    static constexpr uint32_t actions_per_trx = 100;
+
+    const account_name casino_account = N(dao.casino);
+    const account_name player_account = N(bench.player);
+
+    const actions::platform platform { platform_name };
+    const actions::casino casino { casino_account, platform_name };
+    const actions::events events { events_name };
+
+    // profiled - deploy instrumented builds of the contracts (see contracts::profile)
+    explicit bench_tester(const bench_scale& scale, bool profiled = false): scale(scale) {
+        create_accounts({
+            platform_name,
+            events_name,
+            casino_account,
+            player_account
+        });
+
+        produce_blocks(2);
+
+        if (profiled) {
+            deploy_contract<contracts::profile::platform>(platform_name);
+            deploy_contract<contracts::profile::casino>(casino_account);
+            deploy_contract<contracts::profile::events>(events_name);
+        } else {
+            deploy_contract<contracts::platform>(platform_name);
+            deploy_contract<contracts::casino>(casino_account);
+            deploy_contract<contracts::events>(events_name);
+        }
+
+        push_action(casino_account, N(setplatform), casino_account, mvo()
+            ("platform_name", platform_name)
+        );
+        push_action(events_name, N(setplatform), events_name, mvo()
+            ("platform_name", platform_name)
+        );
+        push_action(platform_name, N(addcas), platform_name, mvo()
+            ("contract", casino_account)
+            ("meta", bytes())
+        );
+
+        set_authority(platform_name, N(gameaction), {get_public_key(platform_name, "gameaction")}, N(active));
+        link_authority(platform_name, casino_account, N(gameaction), N(newplayer));
+        link_authority(platform_name, casino_account, N(gameaction), N(newplayer.t));
+
+        for (uint32_t i = 0; i < scale.tokens; ++i) {
+            allow_token(token_name(i), 4, token_contract(i));
+        }
+
+        populate_games();
+        populate_players();
+        produce_block();
+    }
+
+    static name indexed_name(const std::string& prefix, uint64_t index) {
+        std::string suffix;
+        do {
+            suffix.insert(suffix.begin(), char('a' + index % 26));
+            index /= 26;
+        } while (index);
+        return name(prefix + suffix);
+    }
+
+    static std::string token_name(uint32_t index) {
+        return index ? "TK" + std::string(1, char('A' + index - 1)) : CORE_SYM_NAME;
+    }
+
+    static name token_contract(uint32_t index) {
+        return index ? indexed_name("tok.", index) : N(eosio.token);
+    }
+
+    static symbol token_symbol(uint32_t index) {
+        return symbol{string_to_symbol_c(4, token_name(index).c_str())};
+    }
+
+    name game_account(uint32_t index) const {
+        return indexed_name("game.", index);
+    }
+
+    // every measured action once, in an order keeping the state valid: session is opened before it's closed,
+    // bonus is sent before it's locked; `i` makes every sample's transactions unique
+    std::vector<std::pair<std::string, action>> sample_actions(uint32_t i) {
+        const auto game = game_account(0);
+        const asset quantity(10000 + i, token_symbol(0));
+
+        return {
+            // platform
+            { "platform::addgame", platform.addgame(indexed_name("bench.", i), 1) },
+            { "platform::pausegame", platform.pausegame(0, false) },
+            { "platform::setmargin", platform.setmargin(0, 50 + i % 2) },
+
+            // casino session flow
+            { "casino::newsession", casino.newsession(game) },
+            { "casino::newsessionpl", casino.newsessionpl(game, player_account) },
+            { "casino::sesnewdepo2", casino.sesnewdepo2(game, player_account, quantity) },
+            { "casino::sesupdate", casino.sesupdate(game, quantity) },
+            { "casino::transfer", actions::token(token_contract(0)).transfer(game, casino_account, quantity) },
+            { "casino::onloss", casino.onloss(game, player_account, quantity) },
+            { "casino::sespayout", casino.sespayout(game, player_account, quantity) },
+            { "casino::sesclose", casino.sesclose(game, quantity) },
+
+            // casino bonus flow
+            { "casino::sendbon", casino.sendbon(player_account, quantity) },
+            { "casino::seslockbon", casino.seslockbon(game, player_account, quantity) },
+            { "casino::sesaddbon", casino.sesaddbon(game, player_account, quantity) },
+            { "casino::newplayer.t", casino.newplayer_t(indexed_name("new.", i), CORE_SYM_NAME) },
+
+            // events
+            { "events::send", events.send(game, 0, 0, i, 0) },
+        };
+    }
+
+    // pushes action in a separate transaction letting the chain measure billed cpu
+    transaction_trace_ptr push_measured(action act) {
+        signed_transaction trx;
+        trx.actions.emplace_back(std::move(act));
+        set_transaction_headers(trx);
+        for (const auto& auth: trx.actions.back().authorization) {
+            trx.sign(get_private_key(auth.actor, auth.permission.to_string()), control->get_chain_id());
+        }
+        return push_transaction(trx, fc::time_point::maximum(), 0); // 0 - objective billing
+    }
+
+    void measure(const std::string& action_label, const std::string& dimension, uint32_t size, action act) {
+        const auto trace = push_measured(std::move(act));
+        BOOST_REQUIRE(trace->receipt);
+        bench_report::instance().add(action_label, dimension, size,
+            trace->receipt->cpu_usage_us,
+            trace->receipt->net_usage_words.value * 8
+        );
+    }
+
+    // pushes actions in transactions of actions_per_trx with default billing
+    void push_batch(std::vector<action> actions) {
+        BOOST_REQUIRE_EQUAL(success(), push_actions(std::move(actions), actions_per_trx));
+    }
+
+    void allow_token(const std::string& token_name, uint8_t precision, name contract) {
+        create_account(contract);
+        deploy_contract<contracts::system::token>(contract);
+
+        symbol symb = symbol{string_to_symbol_c(precision, token_name.c_str())};
+        create_currency(contract, config::system_account_name, asset(100000000000000, symb));
+        issue(config::system_account_name, asset(1672708210000, symb), config::system_account_name, contract);
+
+        push_action(platform_name, N(addtoken), platform_name, mvo()
+            ("token_name", token_name)
+            ("contract", contract)
+        );
+        push_action(casino_account, N(addtoken), casino_account, mvo()
+            ("token_name", token_name)
+        );
+
+        push_action(contract, N(transfer), config::system_account_name, fund(casino_account, asset(1000000000000, symb)));
+        push_action(contract, N(transfer), config::system_account_name, fund(player_account, asset(1000000000, symb)));
+    }
+
+    static mvo fund(const name& to, const asset& amount) {
+        return mvo()
+            ("from", config::system_account_name)
+            ("to", to)
+            ("quantity", amount)
+            ("memo", "");
+    }
+
+public:
+    const bench_scale scale;
+
+private:
+    void populate_games() {
+        std::vector<action> platform_games;
+        std::vector<action> casino_games;
+        for (uint32_t i = 0; i < scale.games; ++i) {
+            create_account(game_account(i));
+            platform_games.push_back(platform.addgame(game_account(i), 1));
+            platform_games.push_back(platform.setmargin(i, 50));
+            casino_games.push_back(casino.addgame(i, game_params_type{{0, 0}}));
+        }
+        push_batch(std::move(platform_games));
+        push_batch(std::move(casino_games));
+
+        // every game gets a balance in every token
+        for (uint32_t t = 0; t < scale.tokens; ++t) {
+            const auto symb = token_symbol(t);
+            const actions::token token(token_contract(t));
+            std::vector<action> funds;
+            std::vector<action> deposits;
+            funds.push_back(token.transfer(config::system_account_name, game_account(0), asset(1000000000, symb)));
+            for (uint32_t i = 0; i < scale.games; ++i) {
+                funds.push_back(token.transfer(config::system_account_name, game_account(i), asset(10000, symb)));
+                deposits.push_back(token.transfer(game_account(i), casino_account, asset(10000, symb)));
+            }
+            push_batch(std::move(funds));
+            push_batch(std::move(deposits));
+        }
+    }
+
+    void populate_players() {
+        // bonus admin is the casino itself by default
+        std::vector<action> bonuses;
+        for (uint32_t i = 0; i < scale.players; ++i) {
+            for (uint32_t t = 0; t < scale.tokens; ++t) {
+                bonuses.push_back(casino.sendbon(indexed_name("pl.", i), asset(10000, token_symbol(t))));
+            }
+        }
+        push_batch(std::move(bonuses));
+    }
+};
+
+} // namespace testing
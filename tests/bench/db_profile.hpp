@@ -0,0 +1,170 @@
+#pragma once
+
+#include <eosio/chain/trace.hpp>
+#include <fc/io/json.hpp>
+#include <fc/variant_object.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace testing {
+
+using namespace eosio::chain;
+
+// db intrinsics calls made by a single action, parsed from `@db <op> <code> <table> <bytes>` console
+// lines printed by the profiled contract builds (contracts/profile)
+struct db_action_profile {
+    std::map<std::string, uint32_t> ops; // op -> calls
+    std::map<name, uint64_t> bytes_read; // table -> bytes
+    std::map<name, uint64_t> bytes_written; // table -> bytes
+    uint32_t cross_contract_reads { 0 };
+
+    static bool is_read(const std::string& op) {
+        static const std::set<std::string> writes { "store", "update", "remove", "idx_store", "idx_update", "idx_remove", "require_auth" };
+        return !writes.count(op);
+    }
+
+    void add(const std::string& op, const name& receiver, const name& code, const name& table, uint32_t bytes) {
+        ops[op]++;
+        if (op == "require_auth") {
+            return;
+        }
+        // secondary index tables are accounted to their primary table
+        const name primary_table(table.to_uint64_t() & 0xFFFFFFFFFFFFFFF0ULL);
+        if (is_read(op)) {
+            bytes_read[primary_table] += bytes;
+            if (code != receiver) {
+                cross_contract_reads++;
+            }
+        } else {
+            bytes_written[primary_table] += bytes;
+        }
+    }
+
+    // keeps the largest count of every op seen, profiles of the same action differ by branches taken
+    void merge(const db_action_profile& other) {
+        for (const auto& it: other.ops) {
+            ops[it.first] = std::max(ops[it.first], it.second);
+        }
+        for (const auto& it: other.bytes_read) {
+            bytes_read[it.first] = std::max(bytes_read[it.first], it.second);
+        }
+        for (const auto& it: other.bytes_written) {
+            bytes_written[it.first] = std::max(bytes_written[it.first], it.second);
+        }
+        cross_contract_reads = std::max(cross_contract_reads, other.cross_contract_reads);
+    }
+
+    // "14 find, 6 update, 2 cross-contract reads"
+    std::string summary() const {
+        std::stringstream ss;
+        for (const auto& it: ops) {
+            ss << it.second << " " << it.first << ", ";
+        }
+        ss << cross_contract_reads << " cross-contract reads";
+        return ss.str();
+    }
+
+    fc::variant to_variant() const {
+        fc::mutable_variant_object ops_var, read_var, written_var;
+        for (const auto& it: ops) {
+            ops_var(it.first, it.second);
+        }
+        for (const auto& it: bytes_read) {
+            read_var(it.first.to_string(), it.second);
+        }
+        for (const auto& it: bytes_written) {
+            written_var(it.first.to_string(), it.second);
+        }
+        return fc::mutable_variant_object()
+            ("ops", ops_var)
+            ("cross_contract_reads", cross_contract_reads)
+            ("bytes_read", read_var)
+            ("bytes_written", written_var);
+    }
+};
+
+class db_profile_collector {
+public:
+    // "account::action", notifications get "@receiver" suffix
+    static std::string label(const action_trace& at) {
+        auto result = at.act.account.to_string() + "::" + at.act.name.to_string();
+        if (at.receiver != at.act.account) {
+            result += "@" + at.receiver.to_string();
+        }
+        return result;
+    }
+
+    static db_action_profile parse(const action_trace& at) {
+        db_action_profile result;
+        std::stringstream console(at.console);
+        std::string line;
+        while (std::getline(console, line)) {
+            if (line.compare(0, 4, "@db ") != 0) {
+                continue;
+            }
+            std::stringstream ss(line.substr(4));
+            std::string op, code, table;
+            uint32_t bytes = 0;
+            ss >> op >> code >> table >> bytes;
+            result.add(op, at.receiver, name(code), name(table), bytes);
+        }
+        return result;
+    }
+
+    void add(const transaction_trace_ptr& trace) {
+        for (const auto& at: trace->action_traces) {
+            profiles[label(at)].merge(parse(at));
+        }
+    }
+
+    const std::map<std::string, db_action_profile>& get() const {
+        return profiles;
+    }
+
+    fc::variant to_variant() const {
+        fc::mutable_variant_object result;
+        for (const auto& it: profiles) {
+            result(it.first, it.second.to_variant());
+        }
+        return result;
+    }
+
+    // prints every action summary, returns list of op counts grown compared to the golden file,
+    // actions missing from it are reported too
+    std::vector<std::string> compare(const fc::variant& golden) const {
+        std::vector<std::string> growths;
+        const auto& golden_obj = golden.get_object();
+        for (const auto& it: profiles) {
+            std::cout << std::left << std::setw(40) << it.first << it.second.summary() << std::endl;
+
+            if (!golden_obj.contains(it.first.c_str())) {
+                growths.push_back(it.first + " is not in the golden file");
+                continue;
+            }
+            const auto& base = golden_obj[it.first];
+            const auto& base_ops = base["ops"].get_object();
+            for (const auto& op: it.second.ops) {
+                const auto base_count = base_ops.contains(op.first.c_str()) ? base_ops[op.first].as<uint32_t>() : 0;
+                if (op.second > base_count) {
+                    growths.push_back(it.first + " " + op.first + ": " + std::to_string(base_count) + " -> " + std::to_string(op.second));
+                }
+            }
+            const auto base_cross = base["cross_contract_reads"].as<uint32_t>();
+            if (it.second.cross_contract_reads > base_cross) {
+                growths.push_back(it.first + " cross-contract reads: " + std::to_string(base_cross) + " -> "
+                                  + std::to_string(it.second.cross_contract_reads));
+            }
+        }
+        return growths;
+    }
+
+private:
+    std::map<std::string, db_action_profile> profiles;
+};
+
+} // namespace testing
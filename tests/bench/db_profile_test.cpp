@@ -0,0 +1,45 @@
+#include "bench_tester.hpp"
+#include "db_profile.hpp"
+
+
+namespace testing {
+
+BOOST_AUTO_TEST_SUITE(db_profile)
+
+// runs every benchmarked action on the profiled contract builds and checks
+// db intrinsics calls per action didn't grow compared to the golden file
+BOOST_AUTO_TEST_CASE(db_ops) try {
+    if (!contracts::profile::available()) {
+        BOOST_TEST_MESSAGE("profiled contracts aren't built, configure with -DDB_PROFILE=ON");
+        return;
+    }
+
+    const auto& cfg = bench_config::get();
+    bench_tester t({1, 1, 1}, true);
+
+    db_profile_collector collector;
+    for (uint32_t i = 0; i < cfg.samples; ++i) {
+        for (auto& it: t.sample_actions(i)) {
+            const auto trace = t.push_measured(std::move(it.second));
+            BOOST_REQUIRE(trace->receipt);
+            collector.add(trace);
+        }
+        t.produce_block();
+    }
+
+    if (cfg.update_golden) {
+        fc::json::save_to_file(collector.to_variant(), cfg.golden, true);
+        BOOST_TEST_MESSAGE("golden file written to " << cfg.golden);
+    }
+    // a missing golden file would make the gate pass unconditionally
+    BOOST_REQUIRE_MESSAGE(fc::exists(cfg.golden), "no golden file " << cfg.golden << ", run with --update-golden on a profiled build");
+
+    const auto growths = collector.compare(fc::json::from_file(cfg.golden));
+    for (const auto& g: growths) {
+        BOOST_ERROR("db ops grew: " << g);
+    }
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
@@ -0,0 +1,295 @@
+#include "bench_tester.hpp"
+
+#include "../workload.hpp"
+
+
+namespace testing {
+
+// platform and casino driven with tests/workload.hpp traffic, actions are packed into blocks of a given size
+class load_tester : public basic_tester {
+public:
+    const account_name casino_account = N(dao.casino);
+    const account_name beneficiary = N(wl.owner);
+
+    const actions::platform platform { platform_name };
+    const actions::casino casino { casino_account, platform_name };
+
+    const workload::config cfg;
+    std::vector<symbol> symbols;
+    std::vector<name> token_contracts;
+    std::vector<name> games;
+    std::vector<name> players;
+
+    explicit load_tester(const workload::config& cfg): cfg(cfg) {
+        create_accounts({ platform_name, casino_account, beneficiary });
+        produce_blocks(2);
+
+        deploy_contract<contracts::platform>(platform_name);
+        deploy_contract<contracts::casino>(casino_account);
+        push_action(casino_account, N(setplatform), casino_account, mvo()
+            ("platform_name", platform_name)
+        );
+
+        set_authority(platform_name, N(gameaction), {get_public_key(platform_name, "gameaction")}, N(active));
+        link_authority(platform_name, casino_account, N(gameaction), N(newplayer.t));
+
+        for (uint32_t t = 0; t < cfg.tokens; ++t) {
+            allow_token(bench_tester::token_name(t), bench_tester::token_contract(t));
+        }
+        for (uint32_t g = 0; g < cfg.games; ++g) {
+            games.push_back(bench_tester::indexed_name("game.", g));
+        }
+        for (uint32_t p = 0; p < cfg.players; ++p) {
+            players.push_back(bench_tester::indexed_name("pl.", p));
+        }
+        create_accounts(games);
+        create_accounts(players);
+        produce_block();
+    }
+
+    void allow_token(const std::string& token_name, name contract) {
+        create_account(contract);
+        deploy_contract<contracts::system::token>(contract);
+        const symbol symb = symbol{string_to_symbol_c(4, token_name.c_str())};
+        create_currency(contract, config::system_account_name, asset(100000000000000, symb));
+        issue(config::system_account_name, asset(1672708210000, symb), config::system_account_name, contract);
+
+        push_action(platform_name, N(addtoken), platform_name, mvo()
+            ("token_name", token_name)
+            ("contract", contract)
+        );
+        push_action(casino_account, N(addtoken), casino_account, mvo()
+            ("token_name", token_name)
+        );
+        symbols.push_back(symb);
+        token_contracts.push_back(contract);
+    }
+
+    asset amount(const workload::op& o) const {
+        return asset(o.amount, symbols[o.token]);
+    }
+
+    std::vector<action> actions_of(const workload::op& o) const {
+        using workload::op_type;
+        const auto game = o.game == workload::op::casino ? casino_account : games[o.game];
+        const auto player = players[o.player];
+        const actions::token token(token_contracts[o.token]);
+
+        switch (o.type) {
+            case op_type::add_game:
+                return {
+                    platform.addgame(game, 1),
+                    platform.setmargin(o.game, o.amount),
+                    platform.setbenefic(o.game, game),
+                    casino.addgame(o.game, game_params_type{{0, 0}}),
+                };
+            case op_type::fund:
+                return { token.transfer(config::system_account_name, game, amount(o)) };
+            case op_type::bonus_deposit:
+                return { token.transfer(config::system_account_name, casino_account, amount(o), "bonus") };
+            case op_type::greeting_bonus:
+                return { casino.setgreetbon(amount(o)) };
+            case op_type::newplayer:
+                return { casino.newplayer_t(player, bench_tester::token_name(o.token)) };
+            case op_type::open:
+                return { casino.newsessionpl(game, player), casino.newsession(game) };
+            case op_type::update:
+                return { casino.sesnewdepo2(game, player, amount(o)), casino.sesupdate(game, amount(o)) };
+            case op_type::payout:
+                return { casino.sespayout(game, player, amount(o)) };
+            case op_type::close:
+                return { casino.sesclose(game, amount(o)) };
+            case op_type::lock_bonus:
+                return { casino.seslockbon(game, player, amount(o)) };
+            case op_type::add_bonus:
+                return { casino.sesaddbon(game, player, amount(o)) };
+            case op_type::send_bonus:
+                return { casino.sendbon(player, amount(o)) };
+            case op_type::transfer:
+                return { token.transfer(game, casino_account, amount(o)) };
+            case op_type::loss:
+                return { casino.onloss(game, player, amount(o)) };
+            case op_type::claim:
+                return { casino.claimprofit(game) };
+            case op_type::withdraw:
+                return { casino.withdraw(beneficiary, amount(o)) };
+            case op_type::wait:
+                return {};
+        }
+        return {};
+    }
+
+    // pushes actions in transactions of up to actions_per_trx with objective cpu billing into the pending block,
+    // returns billed cpu and net of all of them
+    std::pair<uint64_t, uint64_t> push_into_block(std::vector<action>& actions, size_t actions_per_trx) {
+        uint64_t cpu = 0, net = 0;
+        for (size_t begin = 0; begin < actions.size(); begin += actions_per_trx) {
+            const auto end = std::min(begin + actions_per_trx, actions.size());
+            signed_transaction trx;
+            std::set<permission_level> signers;
+            for (size_t i = begin; i < end; ++i) {
+                signers.insert(actions[i].authorization.begin(), actions[i].authorization.end());
+                trx.actions.emplace_back(std::move(actions[i]));
+            }
+            set_transaction_headers(trx);
+            for (const auto& auth: signers) {
+                trx.sign(get_private_key(auth.actor, auth.permission.to_string()), control->get_chain_id());
+            }
+            const auto trace = push_transaction(trx, fc::time_point::maximum(), 0);
+            cpu += trace->receipt->cpu_usage_us;
+            net += trace->receipt->net_usage_words.value * 8;
+        }
+        actions.clear();
+        return { cpu, net };
+    }
+
+    uint32_t token_index(uint64_t symbol_raw) const {
+        for (uint32_t t = 0; t < symbols.size(); ++t) {
+            if (symbols[t].value() == symbol_raw) {
+                return t;
+            }
+        }
+        BOOST_FAIL("unknown token " << symbol_raw);
+        return 0;
+    }
+
+    std::map<uint32_t, int64_t> by_token(const rows::token_amounts& amounts) const {
+        std::map<uint32_t, int64_t> result;
+        for (const auto& it: amounts) {
+            result[token_index(it.first)] = it.second;
+        }
+        return result;
+    }
+
+    workload::observed observe() const {
+        const auto code = casino_account;
+        workload::observed result;
+
+        result.games.resize(cfg.games);
+        for (uint32_t g = 0; g < cfg.games; ++g) {
+            const auto tokens_row = rows::find_row<rows::casino::game_tokens_row>(*this, code, code.value, N(gametokens), g);
+            const auto state_row = rows::find_row<rows::casino::game_state_row>(*this, code, code.value, N(gamestate), g);
+            BOOST_REQUIRE(tokens_row && state_row);
+            auto& game = result.games[g];
+            game.balance = by_token(tokens_row->balance);
+            game.active_sum = by_token(tokens_row->active_sessions_sum);
+            game.core_balance = state_row->balance.get_amount();
+            game.core_active_sum = state_row->active_sessions_sum.get_amount();
+            game.sessions = state_row->active_sessions_amount;
+        }
+
+        const auto gtokens = rows::find_row<rows::casino::global_tokens_state>(*this, code, code.value, N(globaltokens), N(globaltokens).value);
+        const auto gstate = rows::find_row<rows::casino::global_state>(*this, code, code.value, N(global), N(global).value);
+        const auto bstate = rows::find_row<rows::casino::bonus_pool_state>(*this, code, code.value, N(bonuspool), N(bonuspool).value);
+        BOOST_REQUIRE(gtokens && gstate && bstate);
+        result.profits_sum = by_token(gtokens->game_profits_sum);
+        result.active_sum = by_token(gtokens->game_active_sessions_sum);
+        result.allocated_bonus = by_token(gtokens->total_allocated_bonus);
+        result.core_profits_sum = gstate->game_profits_sum.get_amount();
+        result.core_active_sum = gstate->game_active_sessions_sum.get_amount();
+        result.sessions = gstate->active_sessions_amount;
+        result.core_allocated_bonus = bstate->total_allocated.get_amount();
+
+        for (uint32_t p = 0; p < cfg.players; ++p) {
+            const auto tokens_row = rows::find_row<rows::casino::player_tokens_row>(*this, code, code.value, N(playertokens), players[p].value);
+            if (tokens_row) {
+                result.bonus[p] = by_token(tokens_row->bonus_balance);
+            }
+            const auto bonus_row = rows::find_row<rows::casino::bonus_balance_row>(*this, code, code.value, N(bonusbalance), players[p].value);
+            if (bonus_row) {
+                result.core_bonus[p] = bonus_row->balance.get_amount();
+            }
+        }
+
+        for (uint32_t t = 0; t < cfg.tokens; ++t) {
+            const auto row = rows::find_row<rows::token::account>(*this, token_contracts[t], code.value, N(accounts),
+                symbols[t].to_symbol_code().value);
+            result.casino_balance.push_back(row ? row->balance.get_amount() : 0);
+        }
+        return result;
+    }
+
+    void check(const workload::generator& gen, uint64_t step) const {
+        for (const auto& violation: workload::check(gen.expected(), observe())) {
+            BOOST_ERROR("step " << step << ": " << violation);
+        }
+    }
+};
+
+// actions of workload traffic are packed into blocks of `block_actions`, billed cpu of every block is compared
+// to the chain's max_block_cpu_usage; the first size whose p99 block goes over it is where the budget breaks
+BOOST_AUTO_TEST_SUITE(load)
+
+BOOST_AUTO_TEST_CASE(block_budget) try {
+    const auto& bench = bench_config::get();
+    workload::config cfg;
+    cfg.seed = bench.load_seed;
+    cfg.games = bench.load_games;
+    cfg.players = bench.load_players;
+    cfg.tokens = bench.load_tokens;
+
+    std::cout << std::left << std::setw(14) << "block actions" << std::right << std::setw(8) << "blocks"
+              << std::setw(12) << "cpu med" << std::setw(12) << "cpu p99" << std::setw(12) << "cpu max"
+              << std::setw(10) << "budget" << std::endl;
+
+    for (const auto block_actions: bench.load_block_actions) {
+        load_tester t(cfg);
+        workload::generator gen(cfg);
+        const auto max_block_cpu = t.control->get_global_properties().configuration.max_block_cpu_usage;
+
+        std::vector<action> pending;
+        for (const auto& o: gen.setup()) {
+            for (auto& act: t.actions_of(o)) {
+                pending.push_back(std::move(act));
+            }
+        }
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_actions(std::move(pending), bench_tester::actions_per_trx));
+        t.check(gen, 0);
+
+        std::vector<uint32_t> block_cpu;
+        const auto flush = [&](fc::microseconds skip) {
+            if (!pending.empty()) {
+                const auto billed = t.push_into_block(pending, bench_tester::actions_per_trx);
+                block_cpu.push_back(billed.first);
+                bench_report::instance().add("load::block", "block_actions", block_actions, billed.first, billed.second);
+            }
+            t.produce_block(skip);
+        };
+
+        for (uint64_t step = 1; step <= bench.load_steps; ++step) {
+            const auto o = gen.next();
+            if (o.type == workload::op_type::wait) {
+                flush(fc::microseconds(o.amount));
+                continue;
+            }
+            for (auto& act: t.actions_of(o)) {
+                pending.push_back(std::move(act));
+            }
+            if (pending.size() >= block_actions) {
+                flush(fc::microseconds(0));
+            }
+            if (step % 1000 == 0) {
+                flush(fc::microseconds(0));
+                t.check(gen, step);
+            }
+        }
+        flush(fc::microseconds(0));
+        t.check(gen, bench.load_steps);
+
+        const auto stats = bench_stats::from_samples(block_cpu);
+        const auto max_cpu = block_cpu.empty() ? 0 : *std::max_element(block_cpu.begin(), block_cpu.end());
+        std::cout << std::left << std::setw(14) << block_actions << std::right << std::setw(8) << block_cpu.size()
+                  << std::setw(12) << stats.median << std::setw(12) << stats.p99 << std::setw(12) << max_cpu
+                  << std::setw(9) << std::fixed << std::setprecision(1) << 100.0 * stats.p99 / max_block_cpu << "%" << std::endl;
+        if (stats.p99 > max_block_cpu) {
+            std::cout << "per-block budget of " << max_block_cpu << "us breaks at " << block_actions << " actions" << std::endl;
+            break;
+        }
+    }
+
+    bench_report::instance().save(bench.out);
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
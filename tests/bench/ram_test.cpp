@@ -0,0 +1,200 @@
+#include "bench_tester.hpp"
+
+#include <eosio/chain/contract_table_objects.hpp>
+
+
+namespace testing {
+
+// billed ram of a single table summed over all scopes, secondary indices are accounted to their table
+struct table_ram {
+    uint64_t scopes { 0 };
+    uint64_t rows { 0 };
+    uint64_t secondary_rows { 0 };
+    uint64_t bytes { 0 };
+};
+
+// walks chain state the same way apply_context bills ram for db intrinsics
+static std::map<name, table_ram> get_tables_ram(const controller& control, const name& code) {
+    const auto& db = control.db();
+    const auto& tables = db.get_index<table_id_multi_index, by_code_scope_table>();
+    const auto& kv_idx = db.get_index<key_value_index, by_scope_primary>();
+    const auto& idx64 = db.get_index<index64_index, by_primary>();
+    const auto& idx128 = db.get_index<index128_index, by_primary>();
+
+    std::map<name, table_ram> result;
+    for (auto t = tables.lower_bound(boost::make_tuple(code)); t != tables.end() && t->code == code; ++t) {
+        // secondary index of a multi_index is a table named after the primary one with index number in lowest 4 bits
+        auto& ram = result[name(t->table.to_uint64_t() & 0xFFFFFFFFFFFFFFF0ULL)];
+        ram.bytes += config::billable_size_v<table_id_object>;
+
+        for (auto it = kv_idx.lower_bound(boost::make_tuple(t->id)); it != kv_idx.end() && it->t_id == t->id; ++it) {
+            ram.rows++;
+            ram.bytes += it->value.size() + config::billable_size_v<key_value_object>;
+        }
+        for (auto it = idx64.lower_bound(boost::make_tuple(t->id)); it != idx64.end() && it->t_id == t->id; ++it) {
+            ram.secondary_rows++;
+            ram.bytes += config::billable_size_v<index64_object>;
+        }
+        for (auto it = idx128.lower_bound(boost::make_tuple(t->id)); it != idx128.end() && it->t_id == t->id; ++it) {
+            ram.secondary_rows++;
+            ram.bytes += config::billable_size_v<index128_object>;
+        }
+        if (t->table.to_uint64_t() == (t->table.to_uint64_t() & 0xFFFFFFFFFFFFFFF0ULL)) {
+            ram.scopes++;
+        }
+    }
+    return result;
+}
+
+static int64_t get_ram_usage(const controller& control, const name& account) {
+    return control.get_resource_limits_manager().get_account_ram_usage(account);
+}
+
+static fc::variant report_account(bench_tester& t, const name& account) {
+    const auto usage = get_ram_usage(*t.control, account);
+    const auto tables = get_tables_ram(*t.control, account);
+
+    std::cout << account.to_string() << ": " << usage << " bytes" << std::endl;
+    std::cout << std::left << std::setw(16) << "  table" << std::right << std::setw(10) << "scopes"
+              << std::setw(12) << "rows" << std::setw(12) << "sec rows" << std::setw(14) << "bytes"
+              << std::setw(12) << "bytes/row" << std::endl;
+
+    int64_t tables_bytes = 0;
+    fc::variants rows;
+    for (const auto& it: tables) {
+        const auto& ram = it.second;
+        tables_bytes += ram.bytes;
+        std::cout << "  " << std::left << std::setw(14) << it.first.to_string() << std::right
+                  << std::setw(10) << ram.scopes << std::setw(12) << ram.rows << std::setw(12) << ram.secondary_rows
+                  << std::setw(14) << ram.bytes << std::setw(12) << (ram.rows ? ram.bytes / ram.rows : 0) << std::endl;
+        rows.push_back(mvo()
+            ("table", it.first)
+            ("scopes", ram.scopes)
+            ("rows", ram.rows)
+            ("secondary_rows", ram.secondary_rows)
+            ("bytes", ram.bytes)
+        );
+    }
+    // account object, permissions, code and abi
+    std::cout << "  " << std::left << std::setw(14) << "(other)" << std::right << std::setw(48) << usage - tables_bytes << std::endl;
+
+    return mvo()
+        ("account", account)
+        ("usage", usage)
+        ("tables", rows);
+}
+
+// ram delta of every given account caused by `f`
+template <typename F>
+static fc::variant measure_marginal(bench_tester& t, const std::string& label, const std::vector<name>& accounts, F&& f) {
+    std::vector<int64_t> before;
+    for (const auto& account: accounts) {
+        before.push_back(get_ram_usage(*t.control, account));
+    }
+    f();
+    t.produce_block();
+
+    mvo deltas;
+    std::cout << std::left << std::setw(36) << label << std::right;
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        const auto delta = get_ram_usage(*t.control, accounts[i]) - before[i];
+        deltas(accounts[i].to_string(), delta);
+        std::cout << std::setw(14) << accounts[i].to_string() + ":" << std::setw(8) << delta;
+    }
+    std::cout << std::endl;
+    return mvo()("what", label)("bytes", deltas);
+}
+
+BOOST_AUTO_TEST_SUITE(ram)
+
+BOOST_AUTO_TEST_CASE(ram_report) try {
+    const auto& cfg = bench_config::get();
+    bench_tester t({cfg.ram_players, cfg.ram_games, cfg.ram_tokens});
+
+    const auto casino = t.casino_account;
+    const auto core = bench_tester::token_symbol(0);
+    const auto new_game = N(game.new);
+    const auto new_player = N(pl.new);
+    const auto new_depo_player = N(pl.depo);
+    const auto new_token = cfg.ram_tokens;
+
+    std::cout << "ram usage at players=" << cfg.ram_players << " games=" << cfg.ram_games
+              << " tokens=" << cfg.ram_tokens << std::endl;
+
+    fc::variants accounts;
+    for (const auto& account: { platform_name, casino, events_name }) {
+        accounts.push_back(report_account(t, account));
+    }
+
+    std::cout << "marginal ram:" << std::endl;
+    fc::variants marginals;
+    t.create_account(new_game);
+
+    marginals.push_back(measure_marginal(t, "new player (sendbon)", {casino}, [&] {
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(casino, N(sendbon), casino, mvo()
+            ("to", new_player)
+            ("amount", asset(10000, core))
+        ));
+    }));
+    marginals.push_back(measure_marginal(t, "new player (sesnewdepo2)", {casino}, [&] {
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(casino, N(sesnewdepo2), t.game_account(0), mvo()
+            ("game_account", t.game_account(0))
+            ("player_account", new_depo_player)
+            ("quantity", asset(10000, core))
+        ));
+    }));
+    marginals.push_back(measure_marginal(t, "new game", {platform_name, casino}, [&] {
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(platform_name, N(addgame), platform_name, mvo()
+            ("contract", new_game)
+            ("params_cnt", 1)
+            ("meta", bytes())
+        ));
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(casino, N(addgame), casino, mvo()
+            ("game_id", cfg.ram_games)
+            ("params", game_params_type{{0, 0}})
+        ));
+    }));
+    marginals.push_back(measure_marginal(t, "new token", {platform_name, casino}, [&] {
+        t.allow_token(bench_tester::token_name(new_token), 4, bench_tester::token_contract(new_token));
+    }));
+    marginals.push_back(measure_marginal(t, "token entry in player row", {casino}, [&] {
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(casino, N(sendbon), casino, mvo()
+            ("to", new_player)
+            ("amount", asset(10000, bench_tester::token_symbol(new_token)))
+        ));
+    }));
+
+    const auto token_contract = bench_tester::token_contract(new_token);
+    const auto token_symbol = bench_tester::token_symbol(new_token);
+    BOOST_REQUIRE_EQUAL(t.success(), t.push_action(token_contract, N(transfer), config::system_account_name,
+        bench_tester::fund(t.game_account(0), asset(10000, token_symbol))
+    ));
+    marginals.push_back(measure_marginal(t, "token entry in game row", {casino}, [&] {
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(token_contract, N(transfer), t.game_account(0), mvo()
+            ("from", t.game_account(0))
+            ("to", casino)
+            ("quantity", asset(10000, token_symbol))
+            ("memo", "")
+        ));
+    }));
+    marginals.push_back(measure_marginal(t, "token entry in game params", {casino}, [&] {
+        BOOST_REQUIRE_EQUAL(t.success(), t.push_action(casino, N(setgameparam2), casino, mvo()
+            ("game_id", 0)
+            ("token", bench_tester::token_name(new_token))
+            ("params", game_params_type{{0, 0}})
+        ));
+    }));
+
+    fc::json::save_to_file(mvo()
+        ("players", cfg.ram_players)
+        ("games", cfg.ram_games)
+        ("tokens", cfg.ram_tokens)
+        ("accounts", accounts)
+        ("marginal", marginals),
+        cfg.ram_out, true
+    );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace testing
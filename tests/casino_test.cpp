@@ -28,25 +28,28 @@ public:
     static const account_name undefined_acc;
 
     casino_tester() {
-        create_accounts({
-            platform_name,
-            casino_account
-        });
+        cached_fixture<casino_tester>([&] {
+            create_accounts({
+                platform_name,
+                casino_account
+            });
 
-        produce_blocks(2);
+            produce_blocks(2);
 
-        deploy_contract<contracts::platform>(platform_name);
-        deploy_contract<contracts::casino>(casino_account);
+            deploy_contract<contracts::platform>(platform_name);
+            deploy_contract<contracts::casino>(casino_account);
 
-        push_action(casino_account, N(setplatform), casino_account, mvo()
-            ("platform_name", platform_name)
-        );
+            push_action(casino_account, N(setplatform), casino_account, mvo()
+                ("platform_name", platform_name)
+            );
 
-        set_authority(platform_name, N(gameaction), {get_public_key(platform_name, "gameaction")}, N(active));
-        link_authority(platform_name, casino_account, N(gameaction), N(newplayer));
-        link_authority(platform_name, casino_account, N(gameaction), N(newplayer.t));
+            set_authority(platform_name, N(gameaction), {get_public_key(platform_name, "gameaction")}, N(active));
+            link_authority(platform_name, casino_account, N(gameaction), N(newplayer));
+            link_authority(platform_name, casino_account, N(gameaction), N(newplayer.t));
+            link_authority(platform_name, casino_account, N(gameaction), N(newplayer.b));
 
-        allow_token(CORE_SYM_NAME, CORE_SYM_PRECISION, N(eosio.token));
+            allow_token(CORE_SYM_NAME, CORE_SYM_PRECISION, N(eosio.token));
+        });
     }
 
     fc::variant get_game(uint64_t game_id) {
@@ -60,12 +63,8 @@ public:
     }
 
     asset get_game_balance(uint64_t game_id, symbol balance_symbol = symbol{CORE_SYM}) {
-        vector<char> data = get_row_by_account(casino_account, casino_account, N(gametokens), game_id );
-        if (data.empty()) {
-            return asset(0LL, balance_symbol);
-        }
-        const auto balances = abi_ser[casino_account].binary_to_variant("game_tokens_row", data, abi_serializer_max_time)["balance"];
-        return get_asset_from_map(balances, balance_symbol);
+        const auto row = rows::find_row<rows::casino::game_tokens_row>(*this, casino_account, casino_account.value, N(gametokens), game_id);
+        return row ? rows::amount_of(row->balance, balance_symbol) : asset(0LL, balance_symbol);
     }
 
     asset get_balance( const account_name& act, symbol balance_symbol = symbol{CORE_SYM} ) {
@@ -73,8 +72,8 @@ public:
         if (token_account == undefined_acc) {
             return asset(0, balance_symbol);
         }
-        vector<char> data = get_row_by_account( token_account, act, N(accounts), account_name(balance_symbol.to_symbol_code().value) );
-        return data.empty() ? asset(0, balance_symbol) : abi_ser[token_account].binary_to_variant("account", data, abi_serializer_max_time)["balance"].as<asset>();
+        const auto row = rows::find_row<rows::token::account>(*this, token_account, act.value, N(accounts), balance_symbol.to_symbol_code().value);
+        return row ? row->balance : asset(0, balance_symbol);
     }
 
     fc::variant get_session_state(uint64_t ses_id) {
@@ -87,9 +86,9 @@ public:
         return data.empty() ? fc::variant() : abi_ser[casino_account].binary_to_variant("global_state", data, abi_serializer_max_time);
     }
 
-    fc::variant get_global_tokens() {
-        vector<char> data = get_row_by_account(casino_account, casino_account, N(globaltokens), N(globaltokens) );
-        return data.empty() ? fc::variant() : abi_ser[casino_account].binary_to_variant("global_tokens_state", data, abi_serializer_max_time);
+    rows::casino::global_tokens_state get_global_tokens_row() {
+        const auto row = rows::find_row<rows::casino::global_tokens_state>(*this, casino_account, casino_account.value, N(globaltokens), N(globaltokens).value);
+        return row.value_or(rows::casino::global_tokens_state{});
     }
 
     fc::variant get_bonus() {
@@ -98,8 +97,8 @@ public:
     }
 
     asset get_bonus_balance(name player) {
-        vector<char> data = get_row_by_account(casino_account, casino_account, N(bonusbalance), player.value);
-        return data.empty() ? asset(0, symbol{CORE_SYM}) : abi_ser[casino_account].binary_to_variant("bonus_balance_row", data, abi_serializer_max_time)["balance"].as<asset>();
+        const auto row = rows::find_row<rows::casino::bonus_balance_row>(*this, casino_account, casino_account.value, N(bonusbalance), player.value);
+        return row ? row->balance : asset(0, symbol{CORE_SYM});
     }
 
     fc::variant get_player_stats(name player) {
@@ -107,9 +106,9 @@ public:
         return data.empty() ? fc::variant() : abi_ser[casino_account].binary_to_variant("player_stats_row", data, abi_serializer_max_time);
     }
 
-    fc::variant get_player_tokens(name player, symbol balance_symbol = symbol{CORE_SYM}) {
-        vector<char> data = get_row_by_account(casino_account, casino_account, N(playertokens), player.value );
-        return data.empty() ? fc::variant() : abi_ser[casino_account].binary_to_variant("player_tokens_row", data, abi_serializer_max_time);
+    rows::casino::player_tokens_row get_player_tokens_row(name player) {
+        const auto row = rows::find_row<rows::casino::player_tokens_row>(*this, casino_account, casino_account.value, N(playertokens), player.value);
+        return row.value_or(rows::casino::player_tokens_row{player});
     }
 
     action_result push_action_custom_auth(const action_name& contract,
@@ -152,9 +151,9 @@ public:
         return push_action_custom_auth(contract, name, auth, auth, data);
     }
 
-    fc::variant get_game_no_bonus(uint64_t game_id) {
-        vector<char> data = get_row_by_account(casino_account, casino_account, N(gamesnobon), game_id);
-        return data.empty() ? fc::variant() : abi_ser[casino_account].binary_to_variant("games_no_bonus_row", data, abi_serializer_max_time);
+    bool get_game_no_bonus(uint64_t game_id) {
+        const auto row = rows::find_row<rows::casino::game_row>(*this, casino_account, casino_account.value, N(game), game_id);
+        return row && row->no_bonus;
     }
 
     fc::variant get_token(std::string token_name) {
@@ -163,25 +162,6 @@ public:
         return data.empty() ? fc::variant() : abi_ser[casino_account].binary_to_variant("token_row", data, abi_serializer_max_time);
     }
 
-    asset get_asset_from_map(const fc::variant& data, symbol symbol) {
-        auto amount = 0;
-        for (auto& it : data.as<vector<fc::variant>>()) {
-            if (it["key"].as<uint64_t>() == symbol.value()) {
-                amount = it["value"].as<int64_t>();
-            }
-        }
-        return asset(amount, symbol);
-    }
-
-    time_point get_time_from_map(const fc::variant& data, symbol symbol) {
-        for (auto& it : data.as<vector<fc::variant>>()) {
-            if (it["key"].as<uint64_t>() == symbol.value()) {
-                return it["value"].as<time_point>();
-            }
-        }
-        throw std::runtime_error("symbol not found");
-    }
-
     game_params_type extract_game_params(const fc::variant& data) {
         game_params_type params = {};
         for (auto& pair: data.as<vector<fc::variant>>()) {
@@ -847,11 +827,11 @@ BOOST_FIXTURE_TEST_CASE(withdraw, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_global_tokens()["game_active_sessions_sum"], kek_symbol), 
+        rows::amount_of(get_global_tokens_row().game_active_sessions_sum, kek_symbol), 
         ASSET("10.00000 KEK")
     );
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_global_tokens()["game_profits_sum"], kek_symbol), 
+        rows::amount_of(get_global_tokens_row().game_profits_sum, kek_symbol), 
         ASSET("5.00000 KEK")
     );
 
@@ -1074,7 +1054,7 @@ BOOST_FIXTURE_TEST_CASE(bonus, casino_tester) try {
     transfer(config::system_account_name, casino_account, ASSET("100.00000 KEK"), "bonus");
     
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_global_tokens()["total_allocated_bonus"], kek_symbol), 
+        rows::amount_of(get_global_tokens_row().total_allocated_bonus, kek_symbol), 
         ASSET("0.00000 KEK")
     );
 
@@ -1083,7 +1063,7 @@ BOOST_FIXTURE_TEST_CASE(bonus, casino_tester) try {
     transfer(config::system_account_name, casino_account, ASSET("100.00000 KEK"), "bonus");
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_global_tokens()["total_allocated_bonus"], kek_symbol), 
+        rows::amount_of(get_global_tokens_row().total_allocated_bonus, kek_symbol), 
         ASSET("100.00000 KEK")
     );
 
@@ -1097,7 +1077,7 @@ BOOST_FIXTURE_TEST_CASE(bonus, casino_tester) try {
 
     BOOST_REQUIRE_EQUAL(get_balance(casino_account, kek_symbol), ASSET("1097.00000 KEK"));
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_global_tokens()["total_allocated_bonus"], kek_symbol), 
+        rows::amount_of(get_global_tokens_row().total_allocated_bonus, kek_symbol), 
         ASSET("97.00000 KEK")
     );
     BOOST_REQUIRE_EQUAL(get_balance(bonus_hunter, kek_symbol), ASSET("3.00000 KEK"));
@@ -1111,7 +1091,7 @@ BOOST_FIXTURE_TEST_CASE(bonus, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player)["bonus_balance"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player).bonus_balance, kek_symbol), 
         ASSET("100.00000 KEK")
     );
 
@@ -1123,7 +1103,7 @@ BOOST_FIXTURE_TEST_CASE(bonus, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player)["bonus_balance"], kek_symbol),
+        rows::amount_of(get_player_tokens_row(player).bonus_balance, kek_symbol),
         ASSET("50.00000 KEK")
     );
 
@@ -1136,12 +1116,12 @@ BOOST_FIXTURE_TEST_CASE(bonus, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_global_tokens()["total_allocated_bonus"], kek_symbol), 
+        rows::amount_of(get_global_tokens_row().total_allocated_bonus, kek_symbol), 
         ASSET("47.00000 KEK")
     );
     BOOST_REQUIRE_EQUAL(get_balance(player, kek_symbol), ASSET("50.00000 KEK"));
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player)["bonus_balance"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player).bonus_balance, kek_symbol), 
         ASSET("0.00000 KEK")
     );
 } FC_LOG_AND_RETHROW()
@@ -1242,7 +1222,7 @@ BOOST_FIXTURE_TEST_CASE(ses_bonus_lock_add, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["bonus_balance"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).bonus_balance, kek_symbol), 
         ASSET("100.00000 KEK")
     );    
     BOOST_REQUIRE_EQUAL(success(),
@@ -1253,7 +1233,7 @@ BOOST_FIXTURE_TEST_CASE(ses_bonus_lock_add, casino_tester) try {
         )
     );
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["bonus_balance"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).bonus_balance, kek_symbol), 
         ASSET("0.00000 KEK")
     );  
     BOOST_REQUIRE_EQUAL(success(),
@@ -1265,7 +1245,7 @@ BOOST_FIXTURE_TEST_CASE(ses_bonus_lock_add, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["bonus_balance"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).bonus_balance, kek_symbol), 
         ASSET("200.00000 KEK")
     );
 } FC_LOG_AND_RETHROW()
@@ -1444,11 +1424,11 @@ BOOST_FIXTURE_TEST_CASE(player_stats, casino_tester) try {
     );
 
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["profit_real"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).profit_real, kek_symbol), 
         ASSET("-10.00000 KEK")
     );
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["volume_real"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).volume_real, kek_symbol), 
         ASSET("10.00000 KEK")
     );
     BOOST_REQUIRE_EQUAL(success(),
@@ -1459,7 +1439,7 @@ BOOST_FIXTURE_TEST_CASE(player_stats, casino_tester) try {
         )
     );
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["profit_real"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).profit_real, kek_symbol), 
         ASSET("10.00000 KEK")
     );
 
@@ -1478,11 +1458,11 @@ BOOST_FIXTURE_TEST_CASE(player_stats, casino_tester) try {
         )
     );
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["profit_bonus"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).profit_bonus, kek_symbol), 
         ASSET("-100.00000 KEK")
     );
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player_account)["volume_bonus"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player_account).volume_bonus, kek_symbol), 
         ASSET("100.00000 KEK")
     );
 } FC_LOG_AND_RETHROW()
@@ -1528,11 +1508,85 @@ BOOST_FIXTURE_TEST_CASE(add_new_player, casino_tester) try {
     );
     
     BOOST_REQUIRE_EQUAL(
-        get_asset_from_map(get_player_tokens(player)["bonus_balance"], kek_symbol), 
+        rows::amount_of(get_player_tokens_row(player).bonus_balance, kek_symbol), 
         ASSET("1.00000 KEK")
     );
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(bulk_bonus, casino_tester) try {
+    const std::vector<name> players = { N(player.a), N(player.b), N(player.c) };
+    create_accounts(players);
+    const auto credits = [&](std::vector<int64_t> amounts) {
+        fc::variants result;
+        for (size_t i = 0; i < amounts.size(); ++i) {
+            result.push_back(mvo()("first", players[i])("second", amounts[i]));
+        }
+        return result;
+    };
+
+    BOOST_REQUIRE_EQUAL(success(),
+        push_action(casino_account, N(sendbon), casino_account, mvo()
+            ("to", players[1])
+            ("amount", STRSYM("1.0000"))
+        )
+    );
+
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("bonus amount should be positive"),
+        push_action(casino_account, N(sendbon.b), casino_account, mvo()
+            ("symbol", CORE_SYM_STR)
+            ("credits", credits({ 10000, -1, 10000 }))
+        )
+    );
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[0]), STRSYM("0.0000"));
+
+    BOOST_REQUIRE_EQUAL(success(),
+        push_action(casino_account, N(sendbon.b), casino_account, mvo()
+            ("symbol", CORE_SYM_STR)
+            ("credits", credits({ 10000, 20000, 30000 }))
+        )
+    );
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[0]), STRSYM("1.0000"));
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[1]), STRSYM("3.0000"));
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[2]), STRSYM("3.0000"));
+
+    BOOST_REQUIRE_EQUAL(success(),
+        push_action(casino_account, N(setgreetbon), casino_account, mvo()
+            ("amount", STRSYM("1.0000"))
+        )
+    );
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("players should be sorted without duplicates"),
+        push_action_custom_auth(casino_account, N(newplayer.b), {platform_name, N(gameaction)}, mvo()
+            ("players", std::vector<name>{ players[2], players[0] })
+            ("token", CORE_SYM_NAME)
+        )
+    );
+    BOOST_REQUIRE_EQUAL(success(),
+        push_action_custom_auth(casino_account, N(newplayer.b), {platform_name, N(gameaction)}, mvo()
+            ("players", std::vector<name>{ players[0], players[2] })
+            ("token", CORE_SYM_NAME)
+        )
+    );
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[0]), STRSYM("2.0000"));
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[2]), STRSYM("4.0000"));
+    BOOST_REQUIRE_EQUAL(
+        rows::amount_of(get_player_tokens_row(players[2]).bonus_balance, symbol{CORE_SYM}),
+        STRSYM("4.0000")
+    );
+
+    transfer(config::system_account_name, casino_account, STRSYM("10.0000"), "bonus");
+    BOOST_REQUIRE_EQUAL(success(),
+        push_action(casino_account, N(convertbon.b), casino_account, mvo()
+            ("accounts", std::vector<name>{ players[0], players[2] })
+            ("symbol", CORE_SYM_STR)
+            ("memo", "")
+        )
+    );
+    BOOST_REQUIRE_EQUAL(get_balance(players[0]), STRSYM("2.0000"));
+    BOOST_REQUIRE_EQUAL(get_balance(players[2]), STRSYM("4.0000"));
+    BOOST_REQUIRE_EQUAL(get_bonus_balance(players[2]), STRSYM("0.0000"));
+    BOOST_REQUIRE_EQUAL(get_bonus()["total_allocated"].as<asset>(), STRSYM("4.0000"));
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(games_no_bonus, casino_tester) try {
     name game_account = N(game.boy);
     name player_account = N(player.acc);
@@ -1568,7 +1622,7 @@ BOOST_FIXTURE_TEST_CASE(games_no_bonus, casino_tester) try {
         )
     );
 
-    BOOST_REQUIRE_EQUAL(get_game_no_bonus(0)["game_id"].as<uint64_t>(), 0);
+    BOOST_REQUIRE(get_game_no_bonus(0));
 
     BOOST_REQUIRE_EQUAL(success(),
         push_action(casino_account, N(sendbon), casino_account, mvo()
@@ -1599,6 +1653,7 @@ BOOST_FIXTURE_TEST_CASE(games_no_bonus, casino_tester) try {
             ("game_account", game_account)
         )
     );
+    BOOST_REQUIRE(!get_game_no_bonus(0));
 
     BOOST_REQUIRE_EQUAL(success(),
         push_action(casino_account, N(seslockbon), game_account, mvo()
@@ -1829,7 +1884,7 @@ BOOST_FIXTURE_TEST_CASE(set_params_test, casino_tester) try {
     BOOST_REQUIRE_EQUAL(success(),
         push_action(platform_name, N(addgame), platform_name, mvo()
             ("contract", casino_account)
-            ("params_cnt", 1)
+            ("params_cnt", 2)
             ("meta", bytes())
         )
     );
@@ -1857,6 +1912,157 @@ BOOST_FIXTURE_TEST_CASE(set_params_test, casino_tester) try {
 
     const auto params_kek = get_game_params(0, kek_token);
     BOOST_REQUIRE_EQUAL(params_kek, expected_params_kek);
+
+    const auto dense = rows::find_row<rows::casino::game_param_token_row>(*this, casino_account, 0, N(gameparamtk), get_token_pk(kek_token));
+    BOOST_REQUIRE(dense);
+    BOOST_REQUIRE(dense->values == std::vector<uint64_t>({0, 2}));
+
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("param id exceeds game's params count"),
+        push_action(casino_account, N(setgameparam2), casino_account, mvo()
+            ("game_id", 0)
+            ("token", "KEK")
+            ("params", game_params_type{{2, 1}})
+        )
+    );
+} FC_LOG_AND_RETHROW()
+
+// the same flow as on_transfer_update_game_balance, built with typed actions and pushed in bulk
+BOOST_FIXTURE_TEST_CASE(bulk_typed_sessions, casino_tester) try {
+    const name game_account = N(game.boy);
+    create_accounts({ game_account });
+
+    const actions::platform platform(platform_name);
+    const actions::casino casino(casino_account, platform_name);
+    const actions::token token(N(eosio.token));
+
+    BOOST_REQUIRE_EQUAL(success(), push_actions({
+        platform.addgame(game_account, 1),
+        platform.setmargin(0, 50),
+        casino.addgame(0, game_params_type{{0, 0}}),
+        token.transfer(config::system_account_name, game_account, STRSYM("1000.0000")),
+        token.transfer(config::system_account_name, casino_account, STRSYM("1000.0000")),
+    }));
+
+    constexpr uint32_t sessions = 200;
+    std::vector<action> flow;
+    for (uint32_t i = 0; i < sessions; ++i) {
+        const name player = name("player." + std::string(1, char('a' + i % 26)));
+        flow.push_back(casino.newsessionpl(game_account, player));
+        flow.push_back(casino.newsession(game_account));
+        flow.push_back(casino.sesnewdepo2(game_account, player, STRSYM("1.0000")));
+        flow.push_back(casino.sesupdate(game_account, STRSYM("1.0000")));
+        flow.push_back(token.transfer(game_account, casino_account, STRSYM("1.0000")));
+        flow.push_back(casino.sesclose(game_account, STRSYM("1.0000")));
+    }
+    BOOST_REQUIRE_EQUAL(success(), push_actions(std::move(flow), 50));
+
+    BOOST_REQUIRE_EQUAL(get_game_balance(0), STRSYM("100.0000"));
+    BOOST_REQUIRE_EQUAL(get_balance(casino_account), STRSYM("1200.0000"));
+    BOOST_REQUIRE_EQUAL(get_global()["active_sessions_amount"].as<int>(), 0);
+
+    // 1.0000 deposited per session, the first 18 players had 8 sessions and the rest 7
+    const auto leaderboard = rows::scan_table<rows::casino::leaderboard_row>(*this, casino_account, symbol{CORE_SYM}.value(), N(leaderboard));
+    BOOST_REQUIRE_EQUAL(leaderboard.size(), 26);
+    for (const auto& row: leaderboard) {
+        const auto sessions = row.player.to_string().back() - 'a' < 18 ? 8 : 7;
+        BOOST_REQUIRE_EQUAL(row.volume, sessions * 10000);
+        BOOST_REQUIRE_EQUAL(row.profit, -sessions * 10000);
+    }
+
+    // the whole transaction fails on the first failing action
+    BOOST_REQUIRE_EQUAL(wasm_assert_msg("invalid quantity in session close"),
+        push_actions({ casino.sesclose(game_account, STRSYM("1.0000")) }));
+} FC_LOG_AND_RETHROW()
+
+template <typename Row>
+static void check_rows_layout(const casino_tester& t, name code, name table) {
+    uint64_t count = 0;
+    rows::for_each_row(t, code, table, [&](name, uint64_t, const auto& value) {
+        const auto row = rows::unpack_row<Row>(value.data(), value.size());
+        const auto packed = fc::raw::pack(row);
+        BOOST_REQUIRE_MESSAGE(packed.size() == value.size() && std::equal(packed.begin(), packed.end(), value.data()),
+                              "typed mirror of " << table.to_string() << " doesn't match the stored row");
+        ++count;
+    });
+    BOOST_REQUIRE_MESSAGE(count > 0, "no rows in " << table.to_string());
+}
+
+// typed mirrors from table_rows.hpp have to stay in sync with the contracts rows
+BOOST_FIXTURE_TEST_CASE(typed_rows_layout, casino_tester) try {
+    name game_account = N(game.boy);
+    name player_account = N(din.don);
+    create_accounts({ game_account, player_account });
+
+    BOOST_REQUIRE_EQUAL(success(), push_action(platform_name, N(addgame), platform_name, mvo()
+        ("contract", game_account)
+        ("params_cnt", 1)
+        ("meta", bytes())
+    ));
+    BOOST_REQUIRE_EQUAL(success(), push_action(platform_name, N(addcas), platform_name, mvo()
+        ("contract", casino_account)
+        ("meta", bytes())
+    ));
+    BOOST_REQUIRE_EQUAL(success(), push_action(casino_account, N(addgame), casino_account, mvo()
+        ("game_id", 0)
+        ("params", game_params_type{{0, 0}})
+    ));
+    transfer(config::system_account_name, game_account, STRSYM("3.0000"));
+    transfer(config::system_account_name, casino_account, STRSYM("300.0000"));
+    transfer(game_account, casino_account, STRSYM("3.0000"));
+    BOOST_REQUIRE_EQUAL(success(), push_action(casino_account, N(newsessionpl), game_account, mvo()
+        ("game_account", game_account)
+        ("player_account", player_account)
+    ));
+    BOOST_REQUIRE_EQUAL(success(), push_action(casino_account, N(sesnewdepo2), game_account, mvo()
+        ("game_account", game_account)
+        ("player_account", player_account)
+        ("quantity", STRSYM("1.0000"))
+    ));
+    BOOST_REQUIRE_EQUAL(success(), push_action(casino_account, N(setpaythr), casino_account, mvo()
+        ("token_name", CORE_SYM_NAME)
+        ("threshold", 10000)
+    ));
+    BOOST_REQUIRE_EQUAL(success(), push_action(casino_account, N(onloss), game_account, mvo()
+        ("game_account", game_account)
+        ("player_account", player_account)
+        ("quantity", STRSYM("0.5000"))
+    ));
+
+    bytes modulus(256, '\x01');
+    modulus[0] = '\x80';
+    BOOST_REQUIRE_EQUAL(success(), push_action(platform_name, N(setrsacasbin), platform_name, mvo()
+        ("id", 0)
+        ("modulus", modulus)
+        ("exponent", 65537)
+    ));
+
+    check_rows_layout<rows::platform::global_row>(*this, platform_name, N(global));
+    check_rows_layout<rows::platform::casino_row>(*this, platform_name, N(casino));
+    check_rows_layout<rows::platform::game_row>(*this, platform_name, N(game));
+    check_rows_layout<rows::platform::rsa_key_row>(*this, platform_name, N(rsakey));
+    check_rows_layout<rows::platform::token_row>(*this, platform_name, N(token));
+    check_rows_layout<rows::casino::game_row>(*this, casino_account, N(game));
+    check_rows_layout<rows::casino::game_state_row>(*this, casino_account, N(gamestate));
+    check_rows_layout<rows::casino::global_state>(*this, casino_account, N(global));
+    check_rows_layout<rows::casino::token_row>(*this, casino_account, N(token));
+    check_rows_layout<rows::casino::pending_payout_row>(*this, casino_account, N(pendingpay));
+    check_rows_layout<rows::casino::game_tokens_row>(*this, casino_account, N(gametokens));
+    check_rows_layout<rows::casino::global_tokens_state>(*this, casino_account, N(globaltokens));
+    check_rows_layout<rows::casino::player_stats_row>(*this, casino_account, N(playerstats));
+    check_rows_layout<rows::casino::player_tokens_row>(*this, casino_account, N(playertokens));
+    check_rows_layout<rows::casino::game_param_token_row>(*this, casino_account, N(gameparamtk));
+    check_rows_layout<rows::casino::leaderboard_row>(*this, casino_account, N(leaderboard));
+    check_rows_layout<rows::casino::daily_stats_row>(*this, casino_account, N(dailystats));
+    check_rows_layout<rows::token::account>(*this, N(eosio.token), N(accounts));
+    check_rows_layout<rows::token::currency_stats>(*this, N(eosio.token), N(stat));
+
+    const auto balances = rows::scan_scopes<rows::token::account>(*this, N(eosio.token), N(accounts));
+    const auto casino_balance = std::find_if(balances.begin(), balances.end(), [&](const auto& row) {
+        return row.first == casino_account;
+    });
+    BOOST_REQUIRE(casino_balance != balances.end());
+    BOOST_REQUIRE_EQUAL(casino_balance->second.balance, get_balance(casino_account));
+    BOOST_REQUIRE_EQUAL(rows::scan_table<rows::casino::game_tokens_row>(*this, casino_account, casino_account.value, N(gametokens)).size(), 1);
 } FC_LOG_AND_RETHROW()
 
 BOOST_AUTO_TEST_SUITE_END()
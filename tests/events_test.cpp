@@ -9,19 +9,21 @@ using bytes = std::vector<char>;
 class events_tester : public basic_tester {
 public:
     events_tester() {
-        create_accounts({
-            platform_name,
-            events_name,
-        });
+        cached_fixture<events_tester>([&] {
+            create_accounts({
+                platform_name,
+                events_name,
+            });
 
-        produce_blocks(2);
+            produce_blocks(2);
 
-        deploy_contract<contracts::platform>(platform_name);
-        deploy_contract<contracts::events>(events_name);
+            deploy_contract<contracts::platform>(platform_name);
+            deploy_contract<contracts::events>(events_name);
 
-        push_action(events_name, N(setplatform), events_name, mvo()
-            ("platform_name", platform_name)
-        );
+            push_action(events_name, N(setplatform), events_name, mvo()
+                ("platform_name", platform_name)
+            );
+        });
     }
 
     fc::variant get_casino(uint64_t casino_id) {
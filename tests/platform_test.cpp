@@ -23,13 +23,15 @@ public:
 
 public:
     platform_tester() {
-        create_accounts({
-            platform_name,
-        });
+        cached_fixture<platform_tester>([&] {
+            create_accounts({
+                platform_name,
+            });
 
-        produce_blocks(2);
+            produce_blocks(2);
 
-        deploy_contract<contracts::platform>(platform_name);
+            deploy_contract<contracts::platform>(platform_name);
+        });
     }
 
     fc::variant get_casino(uint64_t casino_id) {
@@ -201,6 +203,53 @@ BOOST_FIXTURE_TEST_CASE(set_meta_casino, platform_tester) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(set_rsa_key_casino, platform_tester) try {
+    account_name casino_account = N(casino.1);
+
+    create_account(casino_account);
+
+    base_tester::push_action(platform_name, N(addcas), platform_name, mvo()
+        ("contract", casino_account)
+        ("meta", bytes())
+    );
+    base_tester::push_action(platform_name, N(setrsacas), platform_name, mvo()
+        ("id", 0)
+        ("rsa_pubkey", "base64 key")
+    );
+
+    bytes modulus(256, '\x01');
+    modulus[0] = '\xc0';
+    BOOST_REQUIRE_EQUAL(base_tester::push_action(platform_name, N(setrsacasbin), platform_name, mvo()
+        ("id", 0)
+        ("modulus", bytes(modulus.begin() + 1, modulus.end()))
+        ("exponent", 65537)
+    ), wasm_assert_msg("rsa modulus should be 2048, 3072 or 4096 bits"));
+    BOOST_REQUIRE_EQUAL(base_tester::push_action(platform_name, N(setrsacasbin), platform_name, mvo()
+        ("id", 0)
+        ("modulus", modulus)
+        ("exponent", 65537)
+    ), success());
+
+    // the string is kept next to the binary key
+    BOOST_REQUIRE_EQUAL(get_casino(0)["rsa_pubkey"].as<std::string>(), "base64 key");
+    const auto data = get_row_by_account(platform_name, platform_name, N(rsakey), 0);
+    BOOST_REQUIRE(!data.empty());
+    const auto key = abi_ser[platform_name].binary_to_variant("rsa_key_row", data, abi_serializer_max_time);
+    BOOST_REQUIRE(key["modulus"].as<bytes>() == modulus);
+    BOOST_REQUIRE_EQUAL(key["exponent"].as<uint32_t>(), 65537);
+
+    BOOST_REQUIRE_EQUAL(base_tester::push_action(platform_name, N(droprsastr), platform_name, mvo()
+        ("id", 0)
+    ), success());
+    BOOST_REQUIRE_EQUAL(get_casino(0)["rsa_pubkey"].as<std::string>(), "");
+
+    base_tester::push_action(platform_name, N(delcas), platform_name, mvo()
+        ("id", 0)
+    );
+    BOOST_REQUIRE(get_row_by_account(platform_name, platform_name, N(rsakey), 0).empty());
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(casino_delete_test, platform_tester) try {
     account_name casino_account = N(casino.1);
 
@@ -349,6 +398,43 @@ BOOST_FIXTURE_TEST_CASE(set_pause_game, platform_tester) try {
     BOOST_REQUIRE_EQUAL(game["paused"].as<bool>(), false);
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(patch_games, platform_tester) try {
+    const std::vector<account_name> games = { N(game.1), N(game.2) };
+    for (const auto& game: games) {
+        create_account(game);
+        base_tester::push_action(platform_name, N(addgame), platform_name, mvo()
+            ("contract", game)
+            ("params_cnt", 0)
+            ("meta", bytes())
+        );
+    }
+
+    base_tester::push_action(platform_name, N(patchgame), platform_name, mvo()
+        ("id", 1)
+        ("patch", mvo()
+            ("contract", fc::variant())
+            ("paused", fc::variant())
+            ("profit_margin", 30)
+            ("beneficiary", N(dev))
+            ("meta", fc::variant())
+        )
+    );
+    auto game = get_game(1);
+    BOOST_REQUIRE_EQUAL(game["contract"].as<account_name>(), games[1]);
+    BOOST_REQUIRE_EQUAL(game["profit_margin"].as<uint32_t>(), 30);
+    BOOST_REQUIRE_EQUAL(game["beneficiary"].as<account_name>(), N(dev));
+
+    base_tester::push_action(platform_name, N(pausegames), platform_name, mvo()
+        ("ids", std::vector<uint64_t>{ 0, 1 })
+        ("pause", true)
+    );
+    BOOST_REQUIRE_EQUAL(get_game(0)["paused"].as<bool>(), true);
+    BOOST_REQUIRE_EQUAL(get_game(1)["paused"].as<bool>(), true);
+    // paused games leave the active set
+    BOOST_REQUIRE(get_row_by_account(platform_name, platform_name, N(activegame), 0).empty());
+    BOOST_REQUIRE(get_row_by_account(platform_name, platform_name, N(activegame), 1).empty());
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(set_contract_game, platform_tester) try {
     account_name game_account = N(game.1);
     account_name game_account_new = N(game.2);
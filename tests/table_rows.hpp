@@ -0,0 +1,309 @@
+#pragma once
+
+#include <eosio/testing/tester.hpp>
+#include <eosio/chain/contract_table_objects.hpp>
+
+#include <fc/io/raw.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Typed mirrors of the contracts table rows, unpacked straight from the stored bytes with fc::raw.
+// Field order and types have to follow the structs in contracts/*/include, binary layout is what matters.
+namespace testing {
+namespace rows {
+
+using eosio::chain::asset;
+using eosio::chain::name;
+using eosio::chain::symbol;
+
+using bytes = std::vector<char>;
+using token_amounts = std::map<uint64_t, int64_t>; // symbol raw value -> amount
+using game_params_type = std::vector<std::pair<uint16_t, uint64_t>>;
+
+namespace platform {
+
+struct global_row {
+    uint64_t casinos_seq;
+    uint64_t games_seq;
+    std::string rsa_pubkey;
+};
+
+struct casino_row {
+    uint64_t id;
+    name contract;
+    bool paused;
+    std::string rsa_pubkey;
+    bytes meta;
+};
+
+struct game_row {
+    uint64_t id;
+    name contract;
+    uint16_t params_cnt;
+    bool paused;
+    uint32_t profit_margin;
+    name beneficiary;
+    bytes meta;
+};
+
+struct rsa_key_row {
+    uint64_t id;
+    bytes modulus;
+    uint32_t exponent;
+};
+
+struct token_row {
+    std::string token_name;
+    name contract;
+};
+
+struct ban_list_row {
+    name player;
+};
+
+} // namespace platform
+
+namespace casino {
+
+struct game_row {
+    uint64_t game_id;
+    game_params_type params;
+    bool paused;
+    bool no_bonus; // binary extension, present in rows written by addgame since it was added
+};
+
+struct game_state_row {
+    uint64_t game_id;
+    asset balance;
+    fc::time_point last_claim_time;
+    uint64_t active_sessions_amount;
+    asset active_sessions_sum;
+};
+
+struct global_state {
+    asset game_active_sessions_sum;
+    asset game_profits_sum;
+    uint64_t active_sessions_amount;
+    fc::time_point last_withdraw_time;
+    name platform;
+    name owner;
+};
+
+struct bonus_pool_state {
+    name admin;
+    asset total_allocated;
+    asset greeting_bonus;
+};
+
+struct bonus_balance_row {
+    name player;
+    asset balance;
+};
+
+struct player_stats_row {
+    name player;
+    uint64_t sessions_created;
+    asset volume_real;
+    asset volume_bonus;
+    asset profit_real;
+    asset profit_bonus;
+};
+
+struct games_no_bonus_row {
+    uint64_t game_id;
+};
+
+struct token_row {
+    std::string token_name;
+    bool paused;
+    int64_t payout_threshold;
+    int64_t pending_payouts;
+};
+
+struct pending_payout_row {
+    name player;
+    int64_t amount;
+};
+
+struct game_tokens_row {
+    uint64_t game_id;
+    token_amounts balance;
+    token_amounts active_sessions_sum;
+};
+
+struct global_tokens_state {
+    token_amounts game_active_sessions_sum;
+    token_amounts game_profits_sum;
+    token_amounts total_allocated_bonus;
+    token_amounts greeting_bonus;
+    std::map<uint64_t, fc::time_point> last_withdraw_time;
+};
+
+struct player_tokens_row {
+    name player;
+    token_amounts bonus_balance;
+    token_amounts volume_real;
+    token_amounts volume_bonus;
+    token_amounts profit_real;
+    token_amounts profit_bonus;
+};
+
+struct game_params_row {
+    uint64_t game_id;
+    std::map<uint64_t, game_params_type> params;
+};
+
+struct game_param_token_row {
+    uint64_t token;
+    std::vector<uint64_t> values;
+};
+
+struct leaderboard_row {
+    name player;
+    int64_t volume;
+    int64_t profit;
+};
+
+struct daily_stats_row {
+    uint64_t id;
+    uint64_t symbol_raw;
+    uint32_t day;
+    int64_t volume;
+    int64_t payouts;
+    uint32_t sessions;
+    int64_t margin;
+};
+
+} // namespace casino
+
+namespace events {
+
+struct global_row {
+    name platform;
+};
+
+} // namespace events
+
+namespace token {
+
+struct account {
+    asset balance;
+};
+
+struct currency_stats {
+    asset supply;
+    asset max_supply;
+    name issuer;
+};
+
+} // namespace token
+
+// amount of a token in one of the per-token maps, zero if the token is absent
+inline asset amount_of(const token_amounts& amounts, const symbol& symb) {
+    const auto it = amounts.find(symb.value());
+    return asset(it == amounts.end() ? 0 : it->second, symb);
+}
+
+template <typename Row>
+Row unpack_row(const char* data, size_t size) {
+    Row row;
+    fc::datastream<const char*> ds(data, size);
+    fc::raw::unpack(ds, row);
+    return row;
+}
+
+inline const eosio::chain::table_id_object* find_table(const eosio::testing::base_tester& t, name code, uint64_t scope, name table) {
+    return t.control->db().find<eosio::chain::table_id_object, eosio::chain::by_code_scope_table>(
+        boost::make_tuple(code, name(scope), table));
+}
+
+template <typename Row>
+std::optional<Row> find_row(const eosio::testing::base_tester& t, name code, uint64_t scope, name table, uint64_t pk) {
+    const auto* tid = find_table(t, code, scope, table);
+    if (!tid) {
+        return {};
+    }
+    const auto* obj = t.control->db().find<eosio::chain::key_value_object, eosio::chain::by_scope_primary>(
+        boost::make_tuple(tid->id, pk));
+    if (!obj) {
+        return {};
+    }
+    return unpack_row<Row>(obj->value.data(), obj->value.size());
+}
+
+// all rows of a table in primary key order
+template <typename Row>
+std::vector<Row> scan_table(const eosio::testing::base_tester& t, name code, uint64_t scope, name table) {
+    std::vector<Row> result;
+    const auto* tid = find_table(t, code, scope, table);
+    if (!tid) {
+        return result;
+    }
+    const auto& idx = t.control->db().get_index<eosio::chain::key_value_index, eosio::chain::by_scope_primary>();
+    for (auto it = idx.lower_bound(boost::make_tuple(tid->id)); it != idx.end() && it->t_id == tid->id; ++it) {
+        result.push_back(unpack_row<Row>(it->value.data(), it->value.size()));
+    }
+    return result;
+}
+
+// calls f(scope, primary key, packed row) for every row of a table across all of its scopes
+template <typename F>
+void for_each_row(const eosio::testing::base_tester& t, name code, name table, F&& f) {
+    const auto& tables = t.control->db().get_index<eosio::chain::table_id_multi_index, eosio::chain::by_code_scope_table>();
+    const auto& idx = t.control->db().get_index<eosio::chain::key_value_index, eosio::chain::by_scope_primary>();
+    for (auto tid = tables.lower_bound(boost::make_tuple(code)); tid != tables.end() && tid->code == code; ++tid) {
+        if (tid->table != table) {
+            continue;
+        }
+        for (auto it = idx.lower_bound(boost::make_tuple(tid->id)); it != idx.end() && it->t_id == tid->id; ++it) {
+            f(tid->scope, it->primary_key, it->value);
+        }
+    }
+}
+
+// rows of a table across all of its scopes, e.g. token balances of every holder
+template <typename Row>
+std::vector<std::pair<name, Row>> scan_scopes(const eosio::testing::base_tester& t, name code, name table) {
+    std::vector<std::pair<name, Row>> result;
+    for_each_row(t, code, table, [&](name scope, uint64_t, const auto& value) {
+        result.emplace_back(scope, unpack_row<Row>(value.data(), value.size()));
+    });
+    return result;
+}
+
+} // namespace rows
+} // namespace testing
+
+FC_REFLECT(testing::rows::platform::global_row, (casinos_seq)(games_seq)(rsa_pubkey))
+FC_REFLECT(testing::rows::platform::casino_row, (id)(contract)(paused)(rsa_pubkey)(meta))
+FC_REFLECT(testing::rows::platform::game_row, (id)(contract)(params_cnt)(paused)(profit_margin)(beneficiary)(meta))
+FC_REFLECT(testing::rows::platform::rsa_key_row, (id)(modulus)(exponent))
+FC_REFLECT(testing::rows::platform::token_row, (token_name)(contract))
+FC_REFLECT(testing::rows::platform::ban_list_row, (player))
+
+FC_REFLECT(testing::rows::casino::game_row, (game_id)(params)(paused)(no_bonus))
+FC_REFLECT(testing::rows::casino::game_state_row, (game_id)(balance)(last_claim_time)(active_sessions_amount)(active_sessions_sum))
+FC_REFLECT(testing::rows::casino::global_state, (game_active_sessions_sum)(game_profits_sum)(active_sessions_amount)(last_withdraw_time)(platform)(owner))
+FC_REFLECT(testing::rows::casino::bonus_pool_state, (admin)(total_allocated)(greeting_bonus))
+FC_REFLECT(testing::rows::casino::bonus_balance_row, (player)(balance))
+FC_REFLECT(testing::rows::casino::player_stats_row, (player)(sessions_created)(volume_real)(volume_bonus)(profit_real)(profit_bonus))
+FC_REFLECT(testing::rows::casino::games_no_bonus_row, (game_id))
+FC_REFLECT(testing::rows::casino::token_row, (token_name)(paused)(payout_threshold)(pending_payouts))
+FC_REFLECT(testing::rows::casino::pending_payout_row, (player)(amount))
+FC_REFLECT(testing::rows::casino::game_tokens_row, (game_id)(balance)(active_sessions_sum))
+FC_REFLECT(testing::rows::casino::global_tokens_state, (game_active_sessions_sum)(game_profits_sum)(total_allocated_bonus)(greeting_bonus)(last_withdraw_time))
+FC_REFLECT(testing::rows::casino::player_tokens_row, (player)(bonus_balance)(volume_real)(volume_bonus)(profit_real)(profit_bonus))
+FC_REFLECT(testing::rows::casino::game_params_row, (game_id)(params))
+FC_REFLECT(testing::rows::casino::game_param_token_row, (token)(values))
+FC_REFLECT(testing::rows::casino::leaderboard_row, (player)(volume)(profit))
+FC_REFLECT(testing::rows::casino::daily_stats_row, (id)(symbol_raw)(day)(volume)(payouts)(sessions)(margin))
+
+FC_REFLECT(testing::rows::events::global_row, (platform))
+
+FC_REFLECT(testing::rows::token::account, (balance))
+FC_REFLECT(testing::rows::token::currency_stats, (supply)(max_supply)(issuer))
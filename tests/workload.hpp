@@ -0,0 +1,556 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Seeded generator of casino traffic over indexed games, players and tokens (token 0 is the core one).
+// It tracks the state the contracts are expected to reach, so it only emits actions that are valid at
+// that point. The harness maps ops to actions and reads the contract tables back into `observed` at
+// checkpoints (tests/bench/load_test.cpp for basic_tester, native/tests/workload_test.cpp for the native
+// build). Only standard headers are used here: both harnesses include it.
+namespace testing {
+namespace workload {
+
+enum class op_type {
+    // setup, see generator::setup()
+    add_game,       // platform addgame, setmargin(amount), setbenefic(game account); casino addgame
+    fund,           // system account -> game account (or casino if game == casino) token transfer
+    bonus_deposit,  // system account -> casino transfer with "bonus" memo
+    greeting_bonus, // casino setgreetbon
+
+    // traffic
+    newplayer,      // casino newplayer.t by platform@gameaction
+    open,           // casino newsessionpl + newsession
+    update,         // casino sesnewdepo2 + sesupdate
+    payout,         // casino sespayout
+    close,          // casino sesclose with the session sum
+    lock_bonus,     // casino seslockbon
+    add_bonus,      // casino sesaddbon
+    send_bonus,     // casino sendbon
+    transfer,       // game account -> casino token transfer, profit margin goes to the game balance
+    loss,           // casino onloss, casino pays the player
+    claim,          // casino claimprofit, positive game balances go to the game account
+    withdraw,       // casino withdraw of the free casino balance to the harness beneficiary
+    wait            // time goes forward by amount microseconds
+};
+
+inline const char* to_string(op_type type) {
+    switch (type) {
+        case op_type::add_game: return "add_game";
+        case op_type::fund: return "fund";
+        case op_type::bonus_deposit: return "bonus_deposit";
+        case op_type::greeting_bonus: return "greeting_bonus";
+        case op_type::newplayer: return "newplayer";
+        case op_type::open: return "open";
+        case op_type::update: return "update";
+        case op_type::payout: return "payout";
+        case op_type::close: return "close";
+        case op_type::lock_bonus: return "lock_bonus";
+        case op_type::add_bonus: return "add_bonus";
+        case op_type::send_bonus: return "send_bonus";
+        case op_type::transfer: return "transfer";
+        case op_type::loss: return "loss";
+        case op_type::claim: return "claim";
+        case op_type::withdraw: return "withdraw";
+        case op_type::wait: return "wait";
+    }
+    return "unknown";
+}
+
+struct op {
+    static constexpr uint32_t casino = uint32_t(-1); // fund target
+
+    op_type type;
+    uint32_t game { 0 };
+    uint32_t player { 0 };
+    uint32_t token { 0 };
+    int64_t amount { 0 }; // token units, microseconds for wait, percents for add_game
+};
+
+inline std::string to_string(const op& o) {
+    std::ostringstream ss;
+    ss << to_string(o.type) << " game=" << int64_t(o.game == op::casino ? -1 : o.game) << " player=" << o.player
+       << " token=" << o.token << " amount=" << o.amount;
+    return ss.str();
+}
+
+struct config {
+    uint64_t seed { 1 };
+    uint32_t games { 10 };
+    uint32_t players { 100 };
+    uint32_t tokens { 2 };
+    uint32_t max_sessions { 50 };         // open sessions at once
+    int64_t max_bet { 100000 };           // upper bound of a deposit or a loss
+    int64_t game_funds { 10000000000 };   // initial balance of every game account in every token
+    int64_t casino_funds { 10000000000 }; // initial casino balance in every token
+    int64_t bonus_funds { 100000000 };    // deposited to the bonus pool in every token
+    int64_t greeting_bonus { 10000 };
+
+    // relative frequencies of traffic ops
+    std::map<op_type, uint32_t> mix {
+        { op_type::newplayer, 2 },
+        { op_type::open, 10 },
+        { op_type::update, 20 },
+        { op_type::payout, 8 },
+        { op_type::close, 8 },
+        { op_type::lock_bonus, 4 },
+        { op_type::add_bonus, 4 },
+        { op_type::send_bonus, 2 },
+        { op_type::transfer, 15 },
+        { op_type::loss, 6 },
+        { op_type::claim, 1 },
+        { op_type::withdraw, 1 },
+        { op_type::wait, 1 },
+    };
+};
+
+// expected contracts state
+struct model {
+    static constexpr int64_t useconds_per_month = 30ll * 24 * 3600 * 1000000;
+
+    struct session {
+        uint32_t game;
+        uint32_t player;
+        uint32_t token;
+        int64_t sum; // sesupdate total, closed with it
+        bool updated;
+    };
+
+    struct game {
+        uint32_t margin { 0 };
+        std::vector<int64_t> balance;    // game_tokens.balance
+        std::vector<bool> has_balance;   // claimprofit needs an entry for every token
+        std::vector<int64_t> active_sum; // game_tokens.active_sessions_sum
+        std::vector<int64_t> wallet;     // token balance of the game account
+        uint64_t sessions { 0 };
+        int64_t last_claim { 0 };
+    };
+
+    std::vector<game> games;
+    std::vector<int64_t> casino_balance;
+    std::vector<int64_t> allocated_bonus;
+    std::vector<int64_t> greeting_bonus;
+    std::vector<std::vector<int64_t>> bonus; // player -> token
+    std::vector<bool> registered;
+    std::vector<session> sessions;
+    int64_t now { 0 }; // lower bound of the time passed on chain, microseconds
+
+    int64_t profits_sum(uint32_t token) const {
+        int64_t result = 0;
+        for (const auto& g: games) {
+            result += g.balance[token];
+        }
+        return result;
+    }
+
+    int64_t active_sum(uint32_t token) const {
+        int64_t result = 0;
+        for (const auto& g: games) {
+            result += g.active_sum[token];
+        }
+        return result;
+    }
+
+    static int64_t margin_of(int64_t amount, uint32_t margin) {
+        return amount * margin / 100;
+    }
+};
+
+// contracts state read back by the harness, tokens are indexed the same way as in ops
+struct observed {
+    struct game {
+        std::map<uint32_t, int64_t> balance;    // game_tokens
+        std::map<uint32_t, int64_t> active_sum; // game_tokens
+        int64_t core_balance { 0 };             // game_state
+        int64_t core_active_sum { 0 };          // game_state
+        uint64_t sessions { 0 };                // game_state
+    };
+
+    std::vector<game> games;
+    std::map<uint32_t, int64_t> profits_sum;     // global_tokens
+    std::map<uint32_t, int64_t> active_sum;      // global_tokens
+    std::map<uint32_t, int64_t> allocated_bonus; // global_tokens
+    int64_t core_profits_sum { 0 };              // global
+    int64_t core_active_sum { 0 };               // global
+    int64_t core_allocated_bonus { 0 };          // bonus
+    uint64_t sessions { 0 };                     // global
+    std::map<uint32_t, std::map<uint32_t, int64_t>> bonus; // player_tokens, player -> token
+    std::map<uint32_t, int64_t> core_bonus;                // bonus_balance, player -> amount
+    std::vector<int64_t> casino_balance;                   // token contracts
+};
+
+class generator {
+public:
+    explicit generator(const config& cfg): cfg(cfg), rng(cfg.seed) {
+        state.games.resize(cfg.games);
+        for (auto& g: state.games) {
+            g.balance.assign(cfg.tokens, 0);
+            g.has_balance.assign(cfg.tokens, false);
+            g.active_sum.assign(cfg.tokens, 0);
+            g.wallet.assign(cfg.tokens, 0);
+        }
+        state.casino_balance.assign(cfg.tokens, 0);
+        state.allocated_bonus.assign(cfg.tokens, 0);
+        state.greeting_bonus.assign(cfg.tokens, 0);
+        state.bonus.assign(cfg.players, std::vector<int64_t>(cfg.tokens, 0));
+        state.registered.assign(cfg.players, false);
+        for (uint32_t p = 0; p < cfg.players; ++p) {
+            unregistered.push_back(p);
+        }
+        for (const auto& it: cfg.mix) {
+            if (it.second) {
+                types.push_back(it.first);
+                weights.push_back(it.second);
+            }
+        }
+    }
+
+    // games, funds and bonus pool; every game gets a balance entry in every token with a transfer
+    std::vector<op> setup() {
+        std::vector<op> result;
+        const auto emit = [&](op o) {
+            apply(o);
+            result.push_back(o);
+        };
+        for (uint32_t g = 0; g < cfg.games; ++g) {
+            emit({ op_type::add_game, g, 0, 0, uniform(10, 90) });
+        }
+        for (uint32_t t = 0; t < cfg.tokens; ++t) {
+            emit({ op_type::fund, op::casino, 0, t, cfg.casino_funds });
+            emit({ op_type::bonus_deposit, 0, 0, t, cfg.bonus_funds });
+            emit({ op_type::greeting_bonus, 0, 0, t, cfg.greeting_bonus });
+            for (uint32_t g = 0; g < cfg.games; ++g) {
+                emit({ op_type::fund, g, 0, t, cfg.game_funds });
+                emit({ op_type::transfer, g, 0, t, uniform(1, cfg.max_bet) });
+            }
+        }
+        return result;
+    }
+
+    op next() {
+        std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+        for (;;) {
+            if (auto result = make(types[pick(rng)])) {
+                apply(*result);
+                return *result;
+            }
+        }
+    }
+
+    const model& expected() const { return state; }
+
+private:
+    int64_t uniform(int64_t from, int64_t to) {
+        return std::uniform_int_distribution<int64_t>(from, to)(rng);
+    }
+
+    uint32_t any(uint32_t size) {
+        return uint32_t(uniform(0, int64_t(size) - 1));
+    }
+
+    std::optional<uint32_t> registered_player() {
+        if (unregistered.size() == cfg.players) {
+            return {};
+        }
+        for (;;) {
+            const auto p = any(cfg.players);
+            if (state.registered[p]) {
+                return p;
+            }
+        }
+    }
+
+    std::optional<size_t> session(bool updated) {
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < state.sessions.size(); ++i) {
+            if (!updated || state.sessions[i].updated) {
+                candidates.push_back(i);
+            }
+        }
+        if (candidates.empty()) {
+            return {};
+        }
+        return candidates[any(candidates.size())];
+    }
+
+    std::optional<op> make(op_type type) {
+        switch (type) {
+            case op_type::newplayer: {
+                if (unregistered.empty()) {
+                    return {};
+                }
+                const auto i = any(unregistered.size());
+                const auto player = unregistered[i];
+                unregistered[i] = unregistered.back();
+                unregistered.pop_back();
+                return op{ type, 0, player, any(cfg.tokens) };
+            }
+            case op_type::open: {
+                const auto player = registered_player();
+                if (!player || state.sessions.size() >= cfg.max_sessions) {
+                    return {};
+                }
+                return op{ type, any(cfg.games), *player, any(cfg.tokens) };
+            }
+            case op_type::update:
+            case op_type::payout:
+            case op_type::close:
+            case op_type::lock_bonus:
+            case op_type::add_bonus: {
+                const auto i = session(type == op_type::payout || type == op_type::close);
+                if (!i) {
+                    return {};
+                }
+                chosen = *i;
+                const auto& s = state.sessions[chosen];
+                op result { type, s.game, s.player, s.token };
+                if (type == op_type::update) {
+                    result.amount = uniform(1, cfg.max_bet);
+                } else if (type == op_type::payout) {
+                    result.amount = uniform(1, s.sum);
+                } else if (type == op_type::close) {
+                    result.amount = s.sum;
+                } else if (type == op_type::lock_bonus) {
+                    const auto bonus = state.bonus[s.player][s.token];
+                    if (bonus <= 0) {
+                        return {};
+                    }
+                    result.amount = uniform(1, bonus);
+                } else {
+                    result.amount = uniform(1, cfg.max_bet / 10);
+                }
+                return result;
+            }
+            case op_type::send_bonus: {
+                const auto player = registered_player();
+                if (!player) {
+                    return {};
+                }
+                return op{ type, 0, *player, any(cfg.tokens), uniform(1, cfg.max_bet / 10) };
+            }
+            case op_type::transfer: {
+                const auto game = any(cfg.games);
+                const auto token = any(cfg.tokens);
+                const auto wallet = state.games[game].wallet[token];
+                if (wallet <= 0) {
+                    return {};
+                }
+                return op{ type, game, 0, token, uniform(1, std::min(cfg.max_bet, wallet)) };
+            }
+            case op_type::loss: {
+                const auto player = registered_player();
+                const auto token = any(cfg.tokens);
+                const auto amount = uniform(1, cfg.max_bet);
+                if (!player || state.casino_balance[token] - state.allocated_bonus[token] < amount) {
+                    return {};
+                }
+                return op{ type, any(cfg.games), *player, token, amount };
+            }
+            case op_type::claim: {
+                const auto game = any(cfg.games);
+                const auto& g = state.games[game];
+                if (state.now - g.last_claim <= model::useconds_per_month
+                    || std::count(g.has_balance.begin(), g.has_balance.end(), false)) {
+                    return {};
+                }
+                return op{ type, game };
+            }
+            case op_type::withdraw: {
+                // only the branch without weekly limit: free balance above active sessions and game profits
+                const auto token = any(cfg.tokens);
+                const auto free = state.casino_balance[token] - state.allocated_bonus[token]
+                                - state.active_sum(token) - std::max<int64_t>(0, state.profits_sum(token));
+                if (free < 4) {
+                    return {};
+                }
+                return op{ type, 0, 0, token, uniform(1, free / 4) };
+            }
+            case op_type::wait:
+                return op{ type, 0, 0, 0, uniform(3600, 3 * 24 * 3600) * 1000000 };
+            default:
+                return {};
+        }
+    }
+
+    void apply(const op& o) {
+        switch (o.type) {
+            case op_type::add_game:
+                state.games[o.game].margin = uint32_t(o.amount);
+                state.games[o.game].last_claim = state.now;
+                break;
+            case op_type::fund:
+                if (o.game == op::casino) {
+                    state.casino_balance[o.token] += o.amount;
+                } else {
+                    state.games[o.game].wallet[o.token] += o.amount;
+                }
+                break;
+            case op_type::bonus_deposit:
+                state.casino_balance[o.token] += o.amount;
+                state.allocated_bonus[o.token] += o.amount;
+                break;
+            case op_type::greeting_bonus:
+                state.greeting_bonus[o.token] = o.amount;
+                break;
+            case op_type::newplayer:
+                state.registered[o.player] = true;
+                state.bonus[o.player][o.token] += state.greeting_bonus[o.token];
+                break;
+            case op_type::open:
+                state.sessions.push_back({ o.game, o.player, o.token, 0, false });
+                state.games[o.game].sessions++;
+                break;
+            case op_type::update: {
+                auto& s = state.sessions[chosen];
+                s.sum += o.amount;
+                s.updated = true;
+                state.games[o.game].active_sum[o.token] += o.amount;
+                break;
+            }
+            case op_type::payout:
+                break;
+            case op_type::close:
+                state.games[o.game].active_sum[o.token] -= o.amount;
+                state.games[o.game].sessions--;
+                state.sessions.erase(state.sessions.begin() + chosen);
+                break;
+            case op_type::lock_bonus:
+                state.bonus[o.player][o.token] -= o.amount;
+                break;
+            case op_type::add_bonus:
+            case op_type::send_bonus:
+                state.bonus[o.player][o.token] += o.amount;
+                break;
+            case op_type::transfer: {
+                auto& g = state.games[o.game];
+                g.wallet[o.token] -= o.amount;
+                g.balance[o.token] += model::margin_of(o.amount, g.margin);
+                g.has_balance[o.token] = true;
+                state.casino_balance[o.token] += o.amount;
+                break;
+            }
+            case op_type::loss: {
+                auto& g = state.games[o.game];
+                g.balance[o.token] -= model::margin_of(o.amount, g.margin);
+                g.has_balance[o.token] = true;
+                state.casino_balance[o.token] -= o.amount;
+                break;
+            }
+            case op_type::claim: {
+                auto& g = state.games[o.game];
+                for (uint32_t t = 0; t < cfg.tokens; ++t) {
+                    if (g.balance[t] > 0) {
+                        g.wallet[t] += g.balance[t];
+                        state.casino_balance[t] -= g.balance[t];
+                        g.balance[t] = 0;
+                    }
+                }
+                g.last_claim = state.now;
+                break;
+            }
+            case op_type::withdraw:
+                state.casino_balance[o.token] -= o.amount;
+                break;
+            case op_type::wait:
+                state.now += o.amount;
+                break;
+        }
+    }
+
+    const config cfg;
+    std::mt19937_64 rng;
+    model state;
+    std::vector<uint32_t> unregistered;
+    size_t chosen { 0 }; // session of the op being made, sessions aren't identified on chain
+    std::vector<op_type> types;
+    std::vector<uint32_t> weights;
+};
+
+// accounting invariants between game_tokens, global_tokens, legacy core rows and token balances,
+// then the state itself against the model; returns violations, empty if none
+inline std::vector<std::string> check(const model& expected, const observed& actual) {
+    std::vector<std::string> result;
+    const auto at = [](const std::map<uint32_t, int64_t>& m, uint32_t key) {
+        const auto it = m.find(key);
+        return it == m.end() ? int64_t(0) : it->second;
+    };
+    const auto require = [&](bool condition, const std::string& what, int64_t left, int64_t right) {
+        if (!condition) {
+            result.push_back(what + ": " + std::to_string(left) + " != " + std::to_string(right));
+        }
+    };
+
+    const uint32_t tokens = expected.casino_balance.size();
+    if (actual.games.size() != expected.games.size() || actual.casino_balance.size() != tokens) {
+        result.push_back("observed state doesn't match workload config");
+        return result;
+    }
+
+    uint64_t sessions = 0;
+    for (size_t g = 0; g < actual.games.size(); ++g) {
+        const auto& game = actual.games[g];
+        const auto prefix = "game " + std::to_string(g) + " ";
+        sessions += game.sessions;
+        require(game.core_balance == at(game.balance, 0), prefix + "game_state.balance vs game_tokens", game.core_balance, at(game.balance, 0));
+        require(game.core_active_sum == at(game.active_sum, 0), prefix + "game_state.active_sessions_sum vs game_tokens",
+            game.core_active_sum, at(game.active_sum, 0));
+    }
+    require(sessions == actual.sessions, "sum of game_state.active_sessions_amount vs global", sessions, actual.sessions);
+    require(actual.core_profits_sum == at(actual.profits_sum, 0), "global.game_profits_sum vs global_tokens",
+        actual.core_profits_sum, at(actual.profits_sum, 0));
+    require(actual.core_active_sum == at(actual.active_sum, 0), "global.game_active_sessions_sum vs global_tokens",
+        actual.core_active_sum, at(actual.active_sum, 0));
+    require(actual.core_allocated_bonus == at(actual.allocated_bonus, 0), "bonus.total_allocated vs global_tokens",
+        actual.core_allocated_bonus, at(actual.allocated_bonus, 0));
+
+    for (uint32_t t = 0; t < tokens; ++t) {
+        const auto suffix = " token " + std::to_string(t);
+        int64_t profits = 0, active = 0;
+        for (const auto& game: actual.games) {
+            profits += at(game.balance, t);
+            active += at(game.active_sum, t);
+        }
+        require(profits == at(actual.profits_sum, t), "sum of game_tokens.balance vs global_tokens" + suffix, profits, at(actual.profits_sum, t));
+        require(active == at(actual.active_sum, t), "sum of game_tokens.active_sessions_sum vs global_tokens" + suffix,
+            active, at(actual.active_sum, t));
+        require(actual.casino_balance[t] >= at(actual.allocated_bonus, t), "bonus pool isn't backed by casino balance" + suffix,
+            actual.casino_balance[t], at(actual.allocated_bonus, t));
+
+        require(actual.casino_balance[t] == expected.casino_balance[t], "casino balance" + suffix,
+            actual.casino_balance[t], expected.casino_balance[t]);
+        require(at(actual.allocated_bonus, t) == expected.allocated_bonus[t], "total allocated bonus" + suffix,
+            at(actual.allocated_bonus, t), expected.allocated_bonus[t]);
+        for (size_t g = 0; g < actual.games.size(); ++g) {
+            const auto prefix = "game " + std::to_string(g) + " ";
+            require(at(actual.games[g].balance, t) == expected.games[g].balance[t], prefix + "balance" + suffix,
+                at(actual.games[g].balance, t), expected.games[g].balance[t]);
+            require(at(actual.games[g].active_sum, t) == expected.games[g].active_sum[t], prefix + "active sessions sum" + suffix,
+                at(actual.games[g].active_sum, t), expected.games[g].active_sum[t]);
+        }
+    }
+    for (size_t g = 0; g < actual.games.size(); ++g) {
+        require(actual.games[g].sessions == expected.games[g].sessions, "game " + std::to_string(g) + " active sessions",
+            actual.games[g].sessions, expected.games[g].sessions);
+    }
+
+    for (uint32_t p = 0; p < expected.bonus.size(); ++p) {
+        const auto it = actual.bonus.find(p);
+        const auto player = "player " + std::to_string(p) + " ";
+        require(at(actual.core_bonus, p) == (it == actual.bonus.end() ? 0 : at(it->second, 0)), player + "bonus_balance vs player_tokens",
+            at(actual.core_bonus, p), it == actual.bonus.end() ? 0 : at(it->second, 0));
+        for (uint32_t t = 0; t < tokens; ++t) {
+            const auto bonus = it == actual.bonus.end() ? 0 : at(it->second, t);
+            require(bonus == expected.bonus[p][t], player + "bonus token " + std::to_string(t), bonus, expected.bonus[p][t]);
+        }
+    }
+    return result;
+}
+
+} // namespace workload
+} // namespace testing